@@ -106,7 +106,8 @@ class OSRMDatastoreLoader extends OSRMBaseLoader {
     }
 
     loadData (callback) {
-        this.scope.runBin('osrm-datastore', this.inputFile, this.scope.environment, (err) => {
+        const args = this.scope.datastoreArgs ? this.scope.datastoreArgs + ' ' + this.inputFile : this.inputFile;
+        this.scope.runBin('osrm-datastore', args, this.scope.environment, (err) => {
             if (err) return callback(new Error('*** osrm-datastore exited with ' + err.code + ': ' + err));
             callback();
         });
@@ -0,0 +1,22 @@
+@datastore @options @files
+Feature: osrm-datastore command line options: container
+    Background:
+        Given the profile "testbot"
+        And the node map
+            """
+            a b
+            """
+        And the ways
+            | nodes |
+            | ab    |
+        And the data has been contracted
+
+    Scenario: osrm-datastore - Exported container is loaded and mapped
+        When I run "osrm-datastore --export {processed_file}"
+        Then it should exit successfully
+        When I run "osrm-datastore --container {processed_file}"
+        Then it should exit successfully
+        When I run "osrm-routed --mmap {processed_file} --trial"
+        Then it should exit successfully
+        And stdout should contain "trial run"
+
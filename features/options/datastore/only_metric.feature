@@ -0,0 +1,26 @@
+@datastore @options @files
+Feature: osrm-datastore command line options: only-metric
+    Background:
+        Given the profile "testbot"
+        And the node map
+            """
+            a b
+              c
+            """
+        And the ways
+            | nodes |
+            | ab    |
+            | bc    |
+        And the data has been contracted
+
+    Scenario: osrm-datastore - Only the metric is loaded when the other data is in use
+        When I run "osrm-datastore {processed_file}"
+        Then it should exit successfully
+        When I run "osrm-datastore --only-metric {processed_file}"
+        Then it should exit successfully
+        And stderr should not contain "does not match the data in use"
+        Given data is loaded with "osrm-datastore --only-metric"
+        When I route I should get
+            | from | to | route    |
+            | a    | c  | ab,bc,bc |
+            | c    | a  | bc,ab,ab |
@@ -281,6 +281,12 @@ module.exports = function () {
         callback();
     });
 
+    this.Given(/^data is loaded with "osrm\-datastore\s?(.*?)"$/, (args, callback) => {
+        this.osrmLoader.setLoadMethod('datastore');
+        this.datastoreArgs = args;
+        callback();
+    });
+
     this.Given(/^the HTTP method "([^"]*)"$/, (method, callback) => {
         this.httpMethod = method;
         callback();
@@ -0,0 +1,58 @@
+var util = require('util');
+
+module.exports = function () {
+    // Even-odd test over all rings, so holes of the polygons are outside
+    function isInside(location, multiPolygon) {
+        var inside = false;
+        multiPolygon.forEach((polygon) => {
+            polygon.forEach((ring) => {
+                for (var i = 0, j = ring.length - 1; i < ring.length; j = i++) {
+                    var a = ring[i], b = ring[j];
+                    if ((a[1] > location[1]) !== (b[1] > location[1]) &&
+                        location[0] < (b[0] - a[0]) * (location[1] - a[1]) / (b[1] - a[1]) + a[0]) {
+                        inside = !inside;
+                    }
+                }
+            });
+        });
+        return inside;
+    }
+
+    this.When(/^I request an isochrone I should get$/, (table, callback) => {
+        this.reprocessAndLoadData((e) => {
+            if (e) return callback(e);
+            var testRow = (row, ri, cb) => {
+                var fromNode = this.findNodeByName(row.from);
+                if (!fromNode) throw new Error(util.format('*** unknown from-node "%s"', row.from));
+
+                var params = Object.assign({}, this.queryParams),
+                    got = { from: row.from, contours: row.contours };
+                params.contours = row.contours;
+
+                this.requestIsochrone(fromNode, params, (err, res) => {
+                    if (err) return cb(err);
+                    var json = res.body.length ? JSON.parse(res.body) : {};
+
+                    if (row.hasOwnProperty('status')) got.status = json.code;
+                    if (row.hasOwnProperty('message')) got.message = json.message;
+
+                    // the nodes of the row within the polygons of the first contour
+                    ['inside', 'outside'].forEach((key) => {
+                        if (!row.hasOwnProperty(key)) return;
+                        var geometry = json.isochrones ? json.isochrones.features[0].geometry : null;
+                        got[key] = row[key].split(',').filter(n => n).filter((name) => {
+                            var node = this.findNodeByName(name);
+                            if (!node) throw new Error(util.format('*** unknown node "%s"', name));
+                            var inside = geometry && isInside([node.lon, node.lat], geometry.coordinates);
+                            return key === 'inside' ? inside : !inside;
+                        }).join(',');
+                    });
+
+                    cb(null, got);
+                });
+            };
+
+            this.processRowsAndDiff(table, testRow, callback);
+        });
+    });
+};
@@ -0,0 +1,59 @@
+var util = require('util');
+
+module.exports = function () {
+    var OPTIMIZE_PARAMS = ['depot', 'vehicles', 'capacities', 'demands', 'time_windows', 'service_times'];
+
+    this.When(/^I optimize routes I should get$/, (table, callback) => {
+        this.reprocessAndLoadData((e) => {
+            if (e) return callback(e);
+            var testRow = (row, ri, cb) => {
+                var names = row.waypoints.split(','),
+                    waypoints = names.map((name) => {
+                        var node = this.findNodeByName(name);
+                        if (!node) throw new Error(util.format('*** unknown waypoint node "%s"', name));
+                        return node;
+                    }),
+                    params = Object.assign({}, this.queryParams),
+                    got = { waypoints: row.waypoints };
+
+                OPTIMIZE_PARAMS.forEach((key) => {
+                    if (row.hasOwnProperty(key)) {
+                        got[key] = row[key];
+                        if (row[key]) params[key] = row[key];
+                    }
+                });
+
+                this.requestOptimize(waypoints, params, (err, res) => {
+                    if (err) return cb(err);
+                    var json = res.body.length ? JSON.parse(res.body) : {};
+
+                    if (row.hasOwnProperty('status')) got.status = json.code;
+                    if (row.hasOwnProperty('message')) got.message = json.message;
+
+                    var depot = names[parseInt(row.depot || '0')];
+                    if (row.hasOwnProperty('routes')) {
+                        // each route as its depot followed by the names of its stops in order, the
+                        // routes are sorted as the vehicles serving them are interchangeable
+                        var routes = (json.routes || []).map((route, index) => {
+                            return depot + (json.waypoints || [])
+                                .map((waypoint, location) => ({ waypoint: waypoint, name: names[location] }))
+                                .filter(w => w.waypoint.routes_index === index)
+                                .sort((a, b) => a.waypoint.waypoint_index - b.waypoint.waypoint_index)
+                                .map(w => w.name)
+                                .join('');
+                        });
+                        got.routes = routes.sort().join(',');
+                    }
+
+                    if (row.hasOwnProperty('unassigned')) {
+                        got.unassigned = (json.unassigned || []).map(location => names[location]).join(',');
+                    }
+
+                    cb(null, got);
+                });
+            };
+
+            this.processRowsAndDiff(table, testRow, callback);
+        });
+    });
+};
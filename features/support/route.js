@@ -80,6 +80,16 @@ module.exports = function () {
         return this.requestPath('nearest', params, callback);
     };
 
+    this.requestIsochrone = (node, userParams, callback) => {
+        var defaults = {
+                output: 'json'
+            },
+            params = this.overwriteParams(defaults, userParams);
+        params.coordinates = [[node.lon, node.lat].join(',')];
+
+        return this.requestPath('isochrone', params, callback);
+    };
+
     this.requestTable = (waypoints, userParams, callback) => {
         var defaults = {
                 output: 'json'
@@ -106,6 +116,17 @@ module.exports = function () {
         return this.requestPath('trip', params, callback);
     };
 
+    this.requestOptimize = (waypoints, userParams, callback) => {
+        var defaults = {
+                output: 'json'
+            },
+            params = this.overwriteParams(defaults, userParams);
+
+        params.coordinates = encodeWaypoints(waypoints);
+
+        return this.requestPath('optimize', params, callback);
+    };
+
     this.requestMatching = (waypoints, timestamps, userParams, callback) => {
         var defaults = {
                 output: 'json'
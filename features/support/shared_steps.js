@@ -91,6 +91,11 @@ module.exports = function () {
                                     got.alternative = this.wayList(json.routes[1]);
                             }
 
+                            if (headers.has('alternatives')) {
+                                got.alternatives = (json.routes || []).slice(1)
+                                    .map(route => this.wayList(route)).join(';');
+                            }
+
                             var distance = hasRoute && json.routes[0].distance,
                                 time = hasRoute && json.routes[0].duration,
                                 weight = hasRoute && json.routes[0].weight;
@@ -5,7 +5,8 @@ Feature: Alternative route
         Given the profile "testbot"
         And a grid size of 200 meters
 
-        And the node map
+    Scenario: Enabled and disabled alternative
+        Given the node map
             """
               b c d
             a   k     z
@@ -26,18 +27,33 @@ Feature: Alternative route
             | ij    |
             | jz    |
 
-    Scenario: Enabled alternative
-        Given the query options
-            | alternatives | true |
-
+        # the routes over k are too long to be alternatives
         When I route I should get
-            | from | to | route          | alternative       |
-            | a    | z  | ab,bc,cd,dz,dz | ag,gh,hi,ij,jz,jz |
+            | from | to | param:alternatives | route          | alternative       | alternatives      |
+            | a    | z  | true               | ab,bc,cd,dz,dz | ag,gh,hi,ij,jz,jz | ag,gh,hi,ij,jz,jz |
+            | a    | z  | false              | ab,bc,cd,dz,dz |                   |                   |
+            | a    | z  | 3                  | ab,bc,cd,dz,dz | ag,gh,hi,ij,jz,jz | ag,gh,hi,ij,jz,jz |
+
+    Scenario: Number of alternatives
+        Given the node map
+            """
+              a                           b
+            s                               t
+                c                       d
+                  e                   f
+            """
 
-    Scenario: Disabled alternative
-        Given the query options
-            | alternatives | false |
+        And the ways
+            | nodes |
+            | st    |
+            | sabt  |
+            | scdt  |
+            | seft  |
 
         When I route I should get
-            | from | to | route          | alternative |
-            | a    | z  | ab,bc,cd,dz,dz |             |
+            | from | to | param:alternatives | route | alternatives                  | status | message                                                     |
+            | s    | t  | false              | st,st |                               | 200    |                                                             |
+            | s    | t  | true               | st,st | scdt,scdt                     | 200    |                                                             |
+            | s    | t  | 2                  | st,st | scdt,scdt;sabt,sabt           | 200    |                                                             |
+            | s    | t  | 3                  | st,st | scdt,scdt;sabt,sabt;seft,seft | 200    |                                                             |
+            | s    | t  | 4                  |       |                               | 400    | Number of alternatives 4 is higher than current maximum (3) |
@@ -0,0 +1,76 @@
+@isochrone @testbot
+Feature: Basic isochrones
+
+    Background:
+        Given the profile "testbot"
+        Given a grid size of 100 meters
+
+    # Primary roads take 10 seconds per 100 meters, faster than the maximal speed for map matching
+    Scenario: Testbot - Isochrone: Along a road
+        Given the node map
+            """
+            a b c d e
+            """
+
+        And the ways
+            | nodes | highway |
+            | abcde | primary |
+
+        When I request an isochrone I should get
+            | from | contours | inside | outside |
+            | a    | 22       | a,b,c  | d,e     |
+            | c    | 12       | b,c,d  | a,e     |
+            | a    | 22;45    | a,b,c  | d,e     |
+
+    Scenario: Testbot - Isochrone: Branches of different lengths
+        Given the node map
+            """
+                f
+                |
+            e   |
+            |   |
+            a - b - c - d
+            """
+
+        And the ways
+            | nodes | highway |
+            | ea    | primary |
+            | ab    | primary |
+            | bf    | primary |
+            | bcd   | primary |
+
+        When I request an isochrone I should get
+            | from | contours | inside  | outside |
+            | a    | 25       | a,b,e   | c,d,f   |
+            | a    | 45       | a,b,c,e | d,f     |
+
+    Scenario: Testbot - Isochrone: Oneways are only reached in their direction
+        Given the node map
+            """
+            a b c
+            """
+
+        And the ways
+            | nodes | highway | oneway |
+            | ab    | primary |        |
+            | bc    | primary | -1     |
+
+        When I request an isochrone I should get
+            | from | contours | inside | outside |
+            | a    | 45       | a,b    | c       |
+            | c    | 45       | a,b,c  |         |
+
+    Scenario: Testbot - Isochrone: Invalid contours
+        Given the node map
+            """
+            a b
+            """
+
+        And the ways
+            | nodes |
+            | ab    |
+
+        When I request an isochrone I should get
+            | from | contours  | status         | message                                                     |
+            | a    | 0         | InvalidOptions | Contours need to be positive and at most 214748364 seconds. |
+            | a    | 300000000 | InvalidOptions | Contours need to be positive and at most 214748364 seconds. |
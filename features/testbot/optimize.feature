@@ -0,0 +1,81 @@
+@optimize @testbot
+Feature: Basic vehicle routing
+
+    Background:
+        Given the profile "testbot"
+        Given a grid size of 100 meters
+
+    Scenario: Testbot - Optimize: Vehicles with a capacity for a single stop
+        Given the node map
+            """
+            b a c
+            """
+
+        And the ways
+            | nodes |
+            | bac   |
+
+        When I optimize routes I should get
+            | waypoints | vehicles | capacities | demands | routes | unassigned |
+            | a,b,c     | 2        | 1;1        | 0;1;1   | ab,ac  |            |
+
+    Scenario: Testbot - Optimize: Depot in the middle of the waypoints
+        Given the node map
+            """
+            b a c
+            """
+
+        And the ways
+            | nodes |
+            | bac   |
+
+        When I optimize routes I should get
+            | waypoints | depot | vehicles | routes | unassigned |
+            | b,a,c     | 1     | 2        | ab,ac  |            |
+
+    Scenario: Testbot - Optimize: Stops exceeding the capacity are unassigned
+        Given the node map
+            """
+            b a c
+            """
+
+        And the ways
+            | nodes |
+            | bac   |
+
+        When I optimize routes I should get
+            | waypoints | vehicles | capacities | demands | routes | unassigned |
+            | a,b,c     | 1        | 1          | 0;1;2   | ab     | c          |
+            | a,b,c     | 1        | 0          | 0;1;2   |        | b,c        |
+
+    Scenario: Testbot - Optimize: Time windows order the stops
+        Given the node map
+            """
+            b a c
+            """
+
+        And the ways
+            | nodes |
+            | bac   |
+
+        When I optimize routes I should get
+            | waypoints | vehicles | time_windows          | routes | unassigned |
+            | a,b,c     | 1        | 0,1000;100,200;0,50   | acb    |            |
+            | a,b,c     | 1        | 0,1000;0,50;100,200   | abc    |            |
+            | a,b,c     | 1        | 0,1000;0,50;0,5       | ab     | c          |
+
+    Scenario: Testbot - Optimize: Invalid number of vehicles
+        Given the node map
+            """
+            b a c
+            """
+
+        And the ways
+            | nodes |
+            | bac   |
+
+        When I optimize routes I should get
+            | waypoints | vehicles | status         | message                                                                 |
+            | a,b,c     | 0        | InvalidOptions | Number of vehicles needs to be at least one.                            |
+            | a,b,c     | 3        | InvalidOptions | Number of vehicles (3) needs to be less than the number of coordinates (3) |
+            | a,b       | 2        | InvalidOptions | Number of vehicles (2) needs to be less than the number of coordinates (2) |
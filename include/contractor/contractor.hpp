@@ -68,9 +68,17 @@ class Contractor
     void WriteCoreNodeMarker(std::vector<bool> &&is_core_node) const;
     void WriteNodeLevels(std::vector<float> &&node_levels) const;
     void ReadNodeLevels(std::vector<float> &contraction_order) const;
+    // Throws if the graph was contracted from another edge expanded graph
+    void ReadContractedGraph(const unsigned max_node_id,
+                             std::vector<QueryEdge> &contracted_edge_list) const;
+    void WriteLevelOrder(const std::vector<float> &node_levels, const bool has_core) const;
     std::size_t
     WriteContractedGraph(unsigned number_of_edge_based_nodes,
                          const util::DeallocatingVector<QueryEdge> &contracted_edge_list);
+    // Needs the edges in the order of the .hsgr file, call after WriteContractedGraph
+    void
+    WriteShortcutChildren(unsigned max_node_id,
+                          const util::DeallocatingVector<QueryEdge> &contracted_edge_list) const;
     void FindComponents(unsigned max_edge_id,
                         const util::DeallocatingVector<extractor::EdgeBasedEdge> &edges,
                         std::vector<extractor::EdgeBasedNode> &nodes) const;
@@ -45,6 +45,8 @@ struct ContractorConfig
     void UseDefaultOutputNames()
     {
         level_output_path = osrm_input_path.string() + ".level";
+        level_order_output_path = osrm_input_path.string() + ".level_order";
+        shortcut_children_output_path = osrm_input_path.string() + ".shortcuts";
         core_output_path = osrm_input_path.string() + ".core";
         graph_output_path = osrm_input_path.string() + ".hsgr";
         edge_based_graph_path = osrm_input_path.string() + ".ebg";
@@ -64,6 +66,8 @@ struct ContractorConfig
     boost::filesystem::path osrm_input_path;
 
     std::string level_output_path;
+    std::string level_order_output_path;
+    std::string shortcut_children_output_path;
     std::string core_output_path;
     std::string graph_output_path;
     std::string edge_based_graph_path;
@@ -76,6 +80,8 @@ struct ContractorConfig
     std::string geometry_path;
     std::string rtree_leaf_path;
     bool use_cached_priority;
+    // Keep the hierarchy of the existing .hsgr file and only recompute its weights
+    bool customize;
 
     unsigned requested_num_threads;
     double log_edge_updates_factor;
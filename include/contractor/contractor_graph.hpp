@@ -12,24 +12,26 @@ namespace contractor
 struct ContractorEdgeData
 {
     ContractorEdgeData()
-        : weight(0), duration(0), id(0), originalEdges(0), shortcut(0), forward(0), backward(0),
-          is_original_via_node_ID(false)
+        : weight(0), duration(0), distance(0), id(0), originalEdges(0), shortcut(0), forward(0),
+          backward(0), is_original_via_node_ID(false)
     {
     }
     ContractorEdgeData(EdgeWeight weight,
                        EdgeWeight duration,
+                       EdgeDistance distance,
                        unsigned original_edges,
                        unsigned id,
                        bool shortcut,
                        bool forward,
                        bool backward)
-        : weight(weight), duration(duration), id(id),
+        : weight(weight), duration(duration), distance(distance), id(id),
           originalEdges(std::min((1u << 28) - 1u, original_edges)), shortcut(shortcut),
           forward(forward), backward(backward), is_original_via_node_ID(false)
     {
     }
     EdgeWeight weight;
     EdgeWeight duration;
+    EdgeDistance distance;
     unsigned id;
     unsigned originalEdges : 28;
     bool shortcut : 1;
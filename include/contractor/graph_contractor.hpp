@@ -135,6 +135,7 @@ class GraphContractor
                     BOOST_ASSERT_MSG(SPECIAL_NODEID != new_edge.target, "Target id invalid");
                     new_edge.data.weight = data.weight;
                     new_edge.data.duration = data.duration;
+                    new_edge.data.distance = data.distance;
                     new_edge.data.shortcut = data.shortcut;
                     if (!data.is_original_via_node_ID && !orig_node_id_from_new_node_id_map.empty())
                     {
@@ -245,6 +246,7 @@ class GraphContractor
                                                         target,
                                                         path_weight,
                                                         in_data.duration + out_data.duration,
+                                                        in_data.distance + out_data.distance,
                                                         out_data.originalEdges +
                                                             in_data.originalEdges,
                                                         node,
@@ -256,6 +258,7 @@ class GraphContractor
                                                         source,
                                                         path_weight,
                                                         in_data.duration + out_data.duration,
+                                                        in_data.distance + out_data.distance,
                                                         out_data.originalEdges +
                                                             in_data.originalEdges,
                                                         node,
@@ -317,6 +320,7 @@ class GraphContractor
                                                     target,
                                                     path_weight,
                                                     in_data.duration + out_data.duration,
+                                                    in_data.distance + out_data.distance,
                                                     out_data.originalEdges + in_data.originalEdges,
                                                     node,
                                                     SHORTCUT_ARC,
@@ -327,6 +331,7 @@ class GraphContractor
                                                     source,
                                                     path_weight,
                                                     in_data.duration + out_data.duration,
+                                                    in_data.distance + out_data.distance,
                                                     out_data.originalEdges + in_data.originalEdges,
                                                     node,
                                                     SHORTCUT_ARC,
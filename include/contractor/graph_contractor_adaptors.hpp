@@ -34,6 +34,7 @@ std::vector<ContractorEdge> adaptToContractorInput(InputEdgeContainer input_edge
                            input_edge.target,
                            std::max(input_edge.weight, 1),
                            input_edge.duration,
+                           input_edge.distance,
                            1,
                            input_edge.edge_id,
                            false,
@@ -44,6 +45,7 @@ std::vector<ContractorEdge> adaptToContractorInput(InputEdgeContainer input_edge
                            input_edge.source,
                            std::max(input_edge.weight, 1),
                            input_edge.duration,
+                           input_edge.distance,
                            1,
                            input_edge.edge_id,
                            false,
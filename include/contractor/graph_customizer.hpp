@@ -0,0 +1,36 @@
+#ifndef OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
+#define OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
+
+#include "contractor/query_edge.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+// Recomputes the weights of a contracted graph for new edge weights without changing its
+// hierarchy, so weight updates do not need a new contraction.
+//
+// The edges are those of the .hsgr file, sorted by source and target. Like the contraction, an
+// original edge takes for each direction the smallest weight and duration of the edge based edges
+// traversed in that direction between its nodes. Like a customizable CH, a shortcut takes the
+// shortest of its lower triangles, the paths over a node contracted before both of its nodes, and
+// its middle node becomes the node of that path. The edges stored at a node only depend on edges
+// stored at nodes contracted before it, so the edges are customized in rounds from the bottom of
+// the hierarchy up, each round in parallel. An edge that is traversable in both directions is
+// split if the directions end up with different weights or middle nodes.
+//
+// The hierarchy only has the shortcuts that witness searches found necessary for the old weights.
+// Routes on the customized graph are always valid paths, but can miss better paths that need a
+// shortcut that was not necessary before. A full contraction fixes that.
+util::DeallocatingVector<QueryEdge>
+customizeContractedGraph(const std::vector<QueryEdge> &edges,
+                         const std::vector<extractor::EdgeBasedEdge> &edge_based_edges);
+}
+}
+
+#endif // OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
@@ -17,7 +17,8 @@ struct QueryEdge
     struct EdgeData
     {
         explicit EdgeData()
-            : id(0), shortcut(false), weight(0), duration(0), forward(false), backward(false)
+            : id(0), shortcut(false), weight(0), duration(0), forward(false), backward(false),
+              distance(0)
         {
         }
 
@@ -29,6 +30,7 @@ struct QueryEdge
             id = other.id;
             forward = other.forward;
             backward = other.backward;
+            distance = other.distance;
         }
         // this ID is either the middle node of the shortcut, or the ID of the edge based node (node
         // based edge) storing the appropriate data. If `shortcut` is set to true, we get the middle
@@ -39,6 +41,8 @@ struct QueryEdge
         EdgeWeight duration : 30;
         std::uint32_t forward : 1;
         std::uint32_t backward : 1;
+        // length in meters of the original edges, to compute network distances without unpacking
+        EdgeDistance distance;
     } data;
 
     QueryEdge() : source(SPECIAL_NODEID), target(SPECIAL_NODEID) {}
@@ -58,7 +62,8 @@ struct QueryEdge
         return (source == right.source && target == right.target &&
                 data.weight == right.data.weight && data.duration == right.data.duration &&
                 data.shortcut == right.data.shortcut && data.forward == right.data.forward &&
-                data.backward == right.data.backward && data.id == right.data.id);
+                data.backward == right.data.backward && data.id == right.data.id &&
+                data.distance == right.data.distance);
     }
 };
 }
@@ -0,0 +1,120 @@
+#ifndef OSRM_CONTRACTOR_SHORTCUT_CHILDREN_HPP
+#define OSRM_CONTRACTOR_SHORTCUT_CHILDREN_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+// A CH edge in the direction it is traversed in. Reversed edges are stored at the node the
+// traversal ends in and are traversed using their `backward` flag.
+struct CHEdgeReference
+{
+    // edge ids need to fit into the bit field
+    static const constexpr std::uint64_t MAX_NUMBER_OF_EDGES = std::uint64_t{1} << 31;
+
+    std::uint32_t edge : 31;
+    std::uint32_t reversed : 1;
+};
+
+// The two halves of a traversed shortcut, in the order of traversal
+struct ShortcutChildren
+{
+    CHEdgeReference first;
+    CHEdgeReference second;
+};
+
+// Compact index from a traversed shortcut to its children.
+//
+// Every CH edge has two bits, one per direction, that are set if the edge is a shortcut that
+// can be traversed in that direction. The bits are grouped in blocks that store the number of
+// set bits in all previous blocks, so the position of the children is a popcount away.
+struct ShortcutChildrenBlock
+{
+    static const constexpr std::uint32_t BITS_PER_BLOCK = 32;
+
+    std::uint32_t offset;
+    std::uint32_t mask;
+};
+
+inline std::size_t getShortcutChildrenBit(const EdgeID edge, const bool reversed)
+{
+    return 2 * static_cast<std::size_t>(edge) + (reversed ? 1 : 0);
+}
+
+// Finds the CH edge that the unpacking traverses from `from` to `to` in a list of edges sorted
+// by source and target, in which the edges of a node start at first_edge[node]. Like
+// FindSmallestEdge on the query graph, the edge with the smallest weight stored at `from` that
+// can be traversed forward is preferred over the smallest one stored at `to` that can be
+// traversed backward. get_weight(edge, reversed) returns the weight of an edge in the direction
+// it is traversed in, so the shortcut children and the customized shortcut weights both follow
+// the path that is unpacked.
+template <typename EdgeList, typename WeightGetter>
+CHEdgeReference findTraversedEdge(const EdgeList &edges,
+                                  const std::vector<EdgeID> &first_edge,
+                                  const NodeID from,
+                                  const NodeID to,
+                                  WeightGetter &&get_weight)
+{
+    const auto find_smallest_edge = [&](const NodeID source,
+                                        const NodeID target,
+                                        const bool reversed) {
+        const auto end = edges.begin() + first_edge[source + 1];
+        auto edge = std::lower_bound(
+            edges.begin() + first_edge[source],
+            end,
+            target,
+            [](const auto &lhs, const NodeID rhs) { return lhs.target < rhs; });
+
+        EdgeID smallest_edge = SPECIAL_EDGEID;
+        EdgeWeight smallest_weight = INVALID_EDGE_WEIGHT;
+        for (; edge != end && edge->target == target; ++edge)
+        {
+            const auto id = static_cast<EdgeID>(std::distance(edges.begin(), edge));
+            if ((reversed ? edge->data.backward : edge->data.forward) &&
+                get_weight(id, reversed) < smallest_weight)
+            {
+                smallest_edge = id;
+                smallest_weight = get_weight(id, reversed);
+            }
+        }
+        return smallest_edge;
+    };
+
+    const auto forward_edge = find_smallest_edge(from, to, false);
+    if (forward_edge != SPECIAL_EDGEID)
+    {
+        return CHEdgeReference{forward_edge, false};
+    }
+    const auto backward_edge = find_smallest_edge(to, from, true);
+    BOOST_ASSERT(backward_edge != SPECIAL_EDGEID);
+    return CHEdgeReference{backward_edge, true};
+}
+
+template <typename BlockVector>
+inline std::size_t
+getShortcutChildrenIndex(const BlockVector &blocks, const EdgeID edge, const bool reversed)
+{
+    const auto bit = getShortcutChildrenBit(edge, reversed);
+    const auto &block = blocks[bit / ShortcutChildrenBlock::BITS_PER_BLOCK];
+    const auto bit_in_block = bit % ShortcutChildrenBlock::BITS_PER_BLOCK;
+    BOOST_ASSERT_MSG(block.mask & (1u << bit_in_block), "edge is not a shortcut");
+
+    const auto lower_bits = block.mask & ((1u << bit_in_block) - 1u);
+    return block.offset + std::bitset<ShortcutChildrenBlock::BITS_PER_BLOCK>(lower_bits).count();
+}
+}
+}
+
+#endif
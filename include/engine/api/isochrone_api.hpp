@@ -0,0 +1,107 @@
+#ifndef ENGINE_API_ISOCHRONE_API_HPP
+#define ENGINE_API_ISOCHRONE_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include "engine/api/json_factory.hpp"
+#include "engine/isochrone_grid.hpp"
+#include "engine/phantom_node.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class IsochroneAPI final : public BaseAPI
+{
+  public:
+    IsochroneAPI(const datafacade::BaseDataFacade &facade_,
+                 const IsochroneParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // One GeoJSON MultiPolygon feature per contour, in the order of the requested contours
+    void MakeResponse(const PhantomNode &source,
+                      const std::vector<std::vector<IsochronePolygon>> &contour_polygons,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(contour_polygons.size() == parameters.contours.size());
+
+        util::json::Array features;
+        features.values.reserve(contour_polygons.size());
+        for (const auto index : util::irange<std::size_t>(0UL, contour_polygons.size()))
+        {
+            util::json::Object properties;
+            properties.values["contour"] = parameters.contours[index];
+
+            util::json::Object feature;
+            feature.values["type"] = "Feature";
+            feature.values["properties"] = std::move(properties);
+            feature.values["geometry"] = MakeGeometry(contour_polygons[index]);
+            features.values.push_back(std::move(feature));
+        }
+
+        util::json::Object isochrones;
+        isochrones.values["type"] = "FeatureCollection";
+        isochrones.values["features"] = std::move(features);
+
+        util::json::Array waypoints;
+        waypoints.values.push_back(MakeWaypoint(source));
+
+        response.values["code"] = "Ok";
+        response.values["waypoints"] = std::move(waypoints);
+        response.values["isochrones"] = std::move(isochrones);
+    }
+
+  protected:
+    util::json::Object MakeGeometry(const std::vector<IsochronePolygon> &polygons) const
+    {
+        const auto make_ring = [](const std::vector<util::Coordinate> &ring) {
+            util::json::Array coordinates;
+            coordinates.values.reserve(ring.size());
+            std::transform(ring.begin(),
+                           ring.end(),
+                           std::back_inserter(coordinates.values),
+                           &json::detail::coordinateToLonLat);
+            return coordinates;
+        };
+
+        util::json::Array coordinates;
+        coordinates.values.reserve(polygons.size());
+        for (const auto &polygon : polygons)
+        {
+            util::json::Array rings;
+            rings.values.push_back(make_ring(polygon.outer));
+            for (const auto &hole : polygon.holes)
+            {
+                rings.values.push_back(make_ring(hole));
+            }
+            coordinates.values.push_back(std::move(rings));
+        }
+
+        util::json::Object geometry;
+        geometry.values["type"] = "MultiPolygon";
+        geometry.values["coordinates"] = std::move(coordinates);
+        return geometry;
+    }
+
+    const IsochroneParameters &parameters;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
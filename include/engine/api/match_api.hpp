@@ -30,9 +30,50 @@ class MatchAPI final : public RouteAPI
                       const std::vector<InternalRouteResult> &sub_routes,
                       util::json::Object &response) const
     {
-        auto number_of_routes = sub_matchings.size();
+        response.values["tracepoints"] = MakeTracepoints(sub_matchings);
+        response.values["matchings"] = MakeMatchings(sub_matchings, sub_routes);
+        response.values["code"] = "Ok";
+    }
+
+    // Only the trace points of the session from `first_unreported_index` on are returned, the
+    // trace point before was already returned as the end of a previous matching.
+    void MakeSessionResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                             const std::vector<InternalRouteResult> &sub_routes,
+                             const unsigned first_unreported_index,
+                             util::json::Object &response) const
+    {
+        util::json::Array waypoints;
+        for (auto sub_matching_index :
+             util::irange(0u, static_cast<unsigned>(sub_matchings.size())))
+        {
+            const auto &sub_matching = sub_matchings[sub_matching_index];
+            for (auto point_index :
+                 util::irange(0u, static_cast<unsigned>(sub_matching.indices.size())))
+            {
+                if (sub_matching.indices[point_index] < first_unreported_index)
+                {
+                    continue;
+                }
+                auto waypoint = BaseAPI::MakeWaypoint(sub_matching.nodes[point_index]);
+                waypoint.values["trace_index"] = sub_matching.indices[point_index];
+                waypoint.values["matchings_index"] = sub_matching_index;
+                waypoint.values["waypoint_index"] = point_index;
+                waypoints.values.push_back(std::move(waypoint));
+            }
+        }
+
+        response.values["tracepoints"] = std::move(waypoints);
+        response.values["matchings"] = MakeMatchings(sub_matchings, sub_routes);
+        response.values["session"] = parameters.session;
+        response.values["code"] = "Ok";
+    }
+
+  protected:
+    util::json::Array MakeMatchings(const std::vector<map_matching::SubMatching> &sub_matchings,
+                                    const std::vector<InternalRouteResult> &sub_routes) const
+    {
         util::json::Array routes;
-        routes.values.reserve(number_of_routes);
+        routes.values.reserve(sub_matchings.size());
         BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
         for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
         {
@@ -43,12 +84,9 @@ class MatchAPI final : public RouteAPI
             route.values["confidence"] = sub_matchings[index].confidence;
             routes.values.push_back(std::move(route));
         }
-        response.values["tracepoints"] = MakeTracepoints(sub_matchings);
-        response.values["matchings"] = std::move(routes);
-        response.values["code"] = "Ok";
+        return routes;
     }
 
-  protected:
     // FIXME this logic is a little backwards. We should change the output format of the
     // map_matching
     // routing algorithm to be easier to consume here.
@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/api/route_parameters.hpp"
 
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -44,6 +45,9 @@ namespace api
  *
  * Holds member attributes:
  *  - timestamps: timestamp(s) for the corresponding input coordinate(s)
+ *  - session: if set, the coordinates extend the trace of the matching session with this id
+ *    and only the trace points that are confirmed are returned
+ *  - finish: confirms all remaining trace points of the session and closes it
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -67,10 +71,17 @@ struct MatchParameters : public RouteParameters
     }
 
     std::vector<unsigned> timestamps;
+    std::string session;
+    bool finish = false;
+
     bool IsValid() const
     {
-        return RouteParameters::IsValid() &&
-               (timestamps.empty() || timestamps.size() == coordinates.size());
+        // sessions are extended by any number of trace points
+        const bool enough_coordinates =
+            coordinates.size() >= 2 || (!session.empty() && (!coordinates.empty() || finish));
+        return enough_coordinates && BaseParameters::IsValid() &&
+               (timestamps.empty() || timestamps.size() == coordinates.size()) &&
+               (!finish || !session.empty());
     }
 };
 }
@@ -26,28 +26,48 @@ class NearestAPI final : public BaseAPI
     {
     }
 
+    // Responses to a single coordinate list its waypoints. Responses to many coordinates list the
+    // waypoints of each coordinate in a separate property, so every property has a single shape.
     void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
                       util::json::Object &response) const
     {
-        BOOST_ASSERT(phantom_nodes.size() == 1);
-        BOOST_ASSERT(parameters.coordinates.size() == 1);
+        BOOST_ASSERT(phantom_nodes.size() == parameters.coordinates.size());
 
+        if (phantom_nodes.size() == 1)
+        {
+            response.values["waypoints"] = MakeWaypoints(phantom_nodes.front());
+        }
+        else
+        {
+            util::json::Array snapped;
+            snapped.values.reserve(phantom_nodes.size());
+            for (const auto &coordinate_phantom_nodes : phantom_nodes)
+            {
+                snapped.values.push_back(MakeWaypoints(coordinate_phantom_nodes));
+            }
+            response.values["snapped"] = std::move(snapped);
+        }
+        response.values["code"] = "Ok";
+    }
+
+    const NearestParameters &parameters;
+
+  private:
+    util::json::Array
+    MakeWaypoints(const std::vector<PhantomNodeWithDistance> &phantom_nodes) const
+    {
         util::json::Array waypoints;
-        waypoints.values.resize(phantom_nodes.front().size());
-        std::transform(phantom_nodes.front().begin(),
-                       phantom_nodes.front().end(),
+        waypoints.values.resize(phantom_nodes.size());
+        std::transform(phantom_nodes.begin(),
+                       phantom_nodes.end(),
                        waypoints.values.begin(),
                        [this](const PhantomNodeWithDistance &phantom_with_distance) {
                            auto waypoint = MakeWaypoint(phantom_with_distance.phantom_node);
                            waypoint.values["distance"] = phantom_with_distance.distance;
                            return waypoint;
                        });
-
-        response.values["code"] = "Ok";
-        response.values["waypoints"] = std::move(waypoints);
+        return waypoints;
     }
-
-    const NearestParameters &parameters;
 };
 
 } // ns api
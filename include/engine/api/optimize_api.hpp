@@ -0,0 +1,98 @@
+#ifndef ENGINE_API_OPTIMIZE_HPP
+#define ENGINE_API_OPTIMIZE_HPP
+
+#include "engine/api/optimize_parameters.hpp"
+#include "engine/api/route_api.hpp"
+
+#include "engine/datafacade/datafacade_base.hpp"
+
+#include "engine/internal_route_result.hpp"
+#include "engine/vehicle_routing.hpp"
+
+#include "util/integer_range.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class OptimizeAPI final : public RouteAPI
+{
+  public:
+    OptimizeAPI(const datafacade::BaseDataFacade &facade_, const OptimizeParameters &parameters_)
+        : RouteAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // `vehicle_routes` holds one route for every vehicle that serves any location
+    void MakeResponse(const VehicleRoutingSolution &solution,
+                      const std::vector<std::size_t> &vehicles,
+                      const std::vector<InternalRouteResult> &vehicle_routes,
+                      const std::vector<PhantomNode> &phantoms,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(vehicles.size() == vehicle_routes.size());
+
+        util::json::Array routes;
+        routes.values.reserve(vehicle_routes.size());
+        for (const auto index : util::irange<std::size_t>(0UL, vehicle_routes.size()))
+        {
+            auto route = MakeRoute(vehicle_routes[index].segment_end_coordinates,
+                                   vehicle_routes[index].unpacked_path_segments,
+                                   vehicle_routes[index].source_traversed_in_reverse,
+                                   vehicle_routes[index].target_traversed_in_reverse);
+            route.values["vehicle"] = vehicles[index];
+            routes.values.push_back(std::move(route));
+        }
+
+        util::json::Array unassigned;
+        unassigned.values.reserve(solution.unassigned.size());
+        for (const auto location : solution.unassigned)
+        {
+            unassigned.values.push_back(location);
+        }
+
+        response.values["waypoints"] = MakeWaypoints(solution, vehicles, phantoms);
+        response.values["routes"] = std::move(routes);
+        response.values["unassigned"] = std::move(unassigned);
+        response.values["code"] = "Ok";
+    }
+
+  protected:
+    util::json::Array MakeWaypoints(const VehicleRoutingSolution &solution,
+                                    const std::vector<std::size_t> &vehicles,
+                                    const std::vector<PhantomNode> &phantoms) const
+    {
+        util::json::Array waypoints;
+        waypoints.values.reserve(parameters.coordinates.size());
+        for (const auto location : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        {
+            waypoints.values.push_back(BaseAPI::MakeWaypoint(phantoms[location]));
+        }
+
+        // the depot starts every route, so stops begin at waypoint index 1
+        for (const auto routes_index : util::irange<std::size_t>(0UL, vehicles.size()))
+        {
+            const auto &route = solution.routes[vehicles[routes_index]];
+            for (const auto position : util::irange<std::size_t>(0UL, route.size()))
+            {
+                auto &waypoint = waypoints.values[route[position]].get<util::json::Object>();
+                waypoint.values["routes_index"] = routes_index;
+                waypoint.values["waypoint_index"] = position + 1;
+                waypoint.values["arrival"] = solution.arrivals[route[position]] / 10.;
+            }
+        }
+
+        return waypoints;
+    }
+
+    const OptimizeParameters &parameters;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
@@ -0,0 +1,96 @@
+/*
+
+Copyright (c) 2017, Project OSRM contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ENGINE_API_OPTIMIZE_PARAMETERS_HPP
+#define ENGINE_API_OPTIMIZE_PARAMETERS_HPP
+
+#include "engine/api/route_parameters.hpp"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+/**
+ * Parameters specific to the OSRM Optimize service.
+ *
+ * Holds member attributes:
+ *  - depot: index of the coordinate all vehicles start and end at
+ *  - vehicles: number of vehicles, at most one per coordinate other than the depot
+ *  - capacities: capacity of each vehicle, no limit if empty
+ *  - demands: demand of each coordinate, none if empty
+ *  - time_windows: time window in seconds for each coordinate, none if empty
+ *  - service_times: time in seconds spent at each coordinate, none if empty
+ *
+ * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
+ *      NearestParameters, TripParameters, MatchParameters, TileParameters and
+ *      OptimizeParameters
+ */
+struct OptimizeParameters : public RouteParameters
+{
+    struct TimeWindow
+    {
+        unsigned begin;
+        unsigned end;
+    };
+
+    unsigned depot = 0;
+    unsigned vehicles = 1;
+    std::vector<unsigned> capacities;
+    std::vector<unsigned> demands;
+    std::vector<boost::optional<TimeWindow>> time_windows;
+    std::vector<unsigned> service_times;
+
+    bool IsValid() const
+    {
+        const auto per_coordinate = [this](const std::size_t size) {
+            return size == 0 || size == coordinates.size();
+        };
+        return RouteParameters::IsValid() && coordinates.size() >= 2 &&
+               depot < coordinates.size() && vehicles > 0 && vehicles < coordinates.size() &&
+               (capacities.empty() || capacities.size() == vehicles) &&
+               per_coordinate(demands.size()) && per_coordinate(time_windows.size()) &&
+               per_coordinate(service_times.size()) &&
+               std::all_of(time_windows.begin(),
+                           time_windows.end(),
+                           [](const boost::optional<TimeWindow> &time_window) {
+                               return !time_window || time_window->begin <= time_window->end;
+                           });
+    }
+};
+}
+}
+}
+
+#endif // ENGINE_API_OPTIMIZE_PARAMETERS_HPP
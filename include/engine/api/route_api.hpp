@@ -41,21 +41,23 @@ class RouteAPI : public BaseAPI
 
     void MakeResponse(const InternalRouteResult &raw_route, util::json::Object &response) const
     {
-        auto number_of_routes = raw_route.has_alternative() ? 2UL : 1UL;
         util::json::Array routes;
-        routes.values.resize(number_of_routes);
-        routes.values[0] = MakeRoute(raw_route.segment_end_coordinates,
-                                     raw_route.unpacked_path_segments,
-                                     raw_route.source_traversed_in_reverse,
-                                     raw_route.target_traversed_in_reverse);
-        if (raw_route.has_alternative())
+        routes.values.reserve(1 + raw_route.unpacked_alternatives.size());
+        routes.values.push_back(MakeRoute(raw_route.segment_end_coordinates,
+                                          raw_route.unpacked_path_segments,
+                                          raw_route.source_traversed_in_reverse,
+                                          raw_route.target_traversed_in_reverse));
+        for (const auto index :
+             util::irange<std::size_t>(0UL, raw_route.unpacked_alternatives.size()))
         {
-            std::vector<std::vector<PathData>> wrapped_leg(1);
-            wrapped_leg.front() = std::move(raw_route.unpacked_alternative);
-            routes.values[1] = MakeRoute(raw_route.segment_end_coordinates,
-                                         wrapped_leg,
-                                         raw_route.alt_source_traversed_in_reverse,
-                                         raw_route.alt_target_traversed_in_reverse);
+            // alternatives only exist for routes with a single leg
+            const std::vector<std::vector<PathData>> wrapped_leg(
+                1, raw_route.unpacked_alternatives[index]);
+            routes.values.push_back(
+                MakeRoute(raw_route.segment_end_coordinates,
+                          wrapped_leg,
+                          {raw_route.alt_source_traversed_in_reverse[index]},
+                          {raw_route.alt_target_traversed_in_reverse[index]}));
         }
         response.values["waypoints"] = BaseAPI::MakeWaypoints(raw_route.segment_end_coordinates);
         response.values["routes"] = std::move(routes);
@@ -13,6 +13,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <thread>
 
@@ -27,7 +28,9 @@ namespace engine
 class DataWatchdog
 {
   public:
-    DataWatchdog() : barrier(boost::interprocess::open_only), active(true), timestamp(0)
+    DataWatchdog(const std::size_t unpacking_cache_size)
+        : barrier(boost::interprocess::open_only), active(true), timestamp(0),
+          unpacking_cache_size(unpacking_cache_size)
     {
         // create the initial facade before launching the watchdog thread
         {
@@ -35,7 +38,8 @@ class DataWatchdog
                 current_region_lock(barrier.GetMutex());
 
             facade = std::make_shared<datafacade::ContiguousInternalMemoryDataFacade>(
-                std::make_unique<datafacade::SharedMemoryAllocator>(barrier.GetRegion()));
+                std::make_unique<datafacade::SharedMemoryAllocator>(barrier.GetRegion()),
+                unpacking_cache_size);
             timestamp = barrier.GetTimestamp();
         }
 
@@ -67,7 +71,8 @@ class DataWatchdog
             if (timestamp != barrier.GetTimestamp())
             {
                 facade = std::make_shared<datafacade::ContiguousInternalMemoryDataFacade>(
-                    std::make_unique<datafacade::SharedMemoryAllocator>(barrier.GetRegion()));
+                    std::make_unique<datafacade::SharedMemoryAllocator>(barrier.GetRegion()),
+                    unpacking_cache_size);
                 timestamp = barrier.GetTimestamp();
                 util::Log() << "updated facade to region "
                             << storage::regionToString(barrier.GetRegion()) << " with timestamp "
@@ -82,6 +87,8 @@ class DataWatchdog
     std::thread watcher;
     bool active;
     unsigned timestamp;
+    // every new facade starts with an empty cache, unpacked shortcuts change with the data
+    const std::size_t unpacking_cache_size;
     std::shared_ptr<datafacade::ContiguousInternalMemoryDataFacade> facade;
 };
 }
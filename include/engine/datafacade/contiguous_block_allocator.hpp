@@ -17,7 +17,8 @@ class ContiguousBlockAllocator
 
     // interface to give access to the datafacades
     virtual storage::DataLayout &GetLayout() = 0;
-    virtual char *GetMemory() = 0;
+    // memory of each group of blocks, the groups do not need to be adjacent
+    virtual storage::DataLayout::GroupMemory GetMemory() = 0;
 };
 
 } // namespace datafacade
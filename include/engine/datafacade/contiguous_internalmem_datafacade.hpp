@@ -65,6 +65,7 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
     using SharedGeospatialQuery = GeospatialQuery<SharedRTree, BaseDataFacade>;
     using RTreeNode = SharedRTree::TreeNode;
+    using RTreeLeafNode = SharedRTree::LeafNode;
 
     unsigned m_check_sum;
     std::unique_ptr<QueryGraph> m_query_graph;
@@ -89,6 +90,9 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
     util::ShM<EdgeWeight, true>::vector m_geometry_fwd_duration_list;
     util::ShM<EdgeWeight, true>::vector m_geometry_rev_duration_list;
     util::ShM<bool, true>::vector m_is_core_node;
+    util::ShM<NodeID, true>::vector m_level_order;
+    util::ShM<contractor::ShortcutChildrenBlock, true>::vector m_shortcut_children_blocks;
+    util::ShM<contractor::ShortcutChildren, true>::vector m_shortcut_children;
     util::ShM<DatasourceID, true>::vector m_datasource_list;
     util::ShM<std::uint32_t, true>::vector m_lane_description_offsets;
     util::ShM<extractor::guidance::TurnLaneType::Mask, true>::vector m_lane_description_masks;
@@ -121,20 +125,26 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
     // allocator that keeps the allocation data
     std::unique_ptr<ContiguousBlockAllocator> allocator;
 
-    void InitializeChecksumPointer(storage::DataLayout &data_layout, char *memory_block)
+    // unpacked shortcuts are only valid for this dataset, so the cache lives with the facade
+    std::unique_ptr<UnpackingCache> m_unpacking_cache;
+
+    void InitializeChecksumPointer(storage::DataLayout &data_layout,
+                                   const storage::DataLayout::GroupMemory &memory_block)
     {
         m_check_sum =
             *data_layout.GetBlockPtr<unsigned>(memory_block, storage::DataLayout::HSGR_CHECKSUM);
         util::Log() << "set checksum: " << m_check_sum;
     }
 
-    void InitializeProfilePropertiesPointer(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeProfilePropertiesPointer(storage::DataLayout &data_layout,
+                                            const storage::DataLayout::GroupMemory &memory_block)
     {
         m_profile_properties = data_layout.GetBlockPtr<extractor::ProfileProperties>(
             memory_block, storage::DataLayout::PROPERTIES);
     }
 
-    void InitializeTimestampPointer(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeTimestampPointer(storage::DataLayout &data_layout,
+                                    const storage::DataLayout::GroupMemory &memory_block)
     {
         auto timestamp_ptr =
             data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::TIMESTAMP);
@@ -144,10 +154,31 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
                   m_timestamp.begin());
     }
 
-    void InitializeRTreePointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeRTreePointers(storage::DataLayout &data_layout,
+                                 const storage::DataLayout::GroupMemory &memory_block)
     {
         BOOST_ASSERT_MSG(!m_coordinate_list.empty(), "coordinates must be loaded before r-tree");
 
+        auto tree_ptr =
+            data_layout.GetBlockPtr<RTreeNode>(memory_block, storage::DataLayout::R_SEARCH_TREE);
+
+        const auto number_of_leaves =
+            data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE_LEAVES];
+        if (number_of_leaves > 0)
+        {
+            auto leaves_ptr = data_layout.GetBlockPtr<RTreeLeafNode>(
+                memory_block, storage::DataLayout::R_SEARCH_TREE_LEAVES);
+            m_static_rtree.reset(
+                new SharedRTree(tree_ptr,
+                                data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
+                                leaves_ptr,
+                                number_of_leaves,
+                                m_coordinate_list));
+            m_geospatial_query.reset(
+                new SharedGeospatialQuery(*m_static_rtree, m_coordinate_list, *this));
+            return;
+        }
+
         const auto file_index_ptr =
             data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::FILE_INDEX_PATH);
         file_index_path = boost::filesystem::path(file_index_ptr);
@@ -158,8 +189,6 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
                                   "Is any data loaded into shared memory?" + SOURCE_REF);
         }
 
-        auto tree_ptr =
-            data_layout.GetBlockPtr<RTreeNode>(memory_block, storage::DataLayout::R_SEARCH_TREE);
         m_static_rtree.reset(
             new SharedRTree(tree_ptr,
                             data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
@@ -169,7 +198,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
             new SharedGeospatialQuery(*m_static_rtree, m_coordinate_list, *this));
     }
 
-    void InitializeGraphPointer(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeGraphPointer(storage::DataLayout &data_layout,
+                                const storage::DataLayout::GroupMemory &memory_block)
     {
         auto graph_nodes_ptr =
             data_layout.GetBlockPtr<GraphNode>(memory_block, storage::DataLayout::GRAPH_NODE_LIST);
@@ -184,8 +214,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_query_graph.reset(new QueryGraph(node_list, edge_list));
     }
 
-    void InitializeNodeAndEdgeInformationPointers(storage::DataLayout &data_layout,
-                                                  char *memory_block)
+    void InitializeNodeAndEdgeInformationPointers(
+        storage::DataLayout &data_layout, const storage::DataLayout::GroupMemory &memory_block)
     {
         const auto coordinate_list_ptr = data_layout.GetBlockPtr<util::Coordinate>(
             memory_block, storage::DataLayout::COORDINATE_LIST);
@@ -257,7 +287,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_post_turn_bearing = std::move(post_turn_bearing);
     }
 
-    void InitializeViaNodeListPointer(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeViaNodeListPointer(storage::DataLayout &data_layout,
+                                      const storage::DataLayout::GroupMemory &memory_block)
     {
         auto via_geometry_list_ptr =
             data_layout.GetBlockPtr<GeometryID>(memory_block, storage::DataLayout::VIA_NODE_LIST);
@@ -266,7 +297,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_via_geometry_list = std::move(via_geometry_list);
     }
 
-    void InitializeNamePointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeNamePointers(storage::DataLayout &data_layout,
+                                const storage::DataLayout::GroupMemory &memory_block)
     {
         auto name_data_ptr =
             data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::NAME_CHAR_DATA);
@@ -274,8 +306,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_name_table.reset(name_data_ptr, name_data_ptr + name_data_size);
     }
 
-    void InitializeTurnLaneDescriptionsPointers(storage::DataLayout &data_layout,
-                                                char *memory_block)
+    void InitializeTurnLaneDescriptionsPointers(
+        storage::DataLayout &data_layout, const storage::DataLayout::GroupMemory &memory_block)
     {
         auto offsets_ptr = data_layout.GetBlockPtr<std::uint32_t>(
             memory_block, storage::DataLayout::LANE_DESCRIPTION_OFFSETS);
@@ -291,16 +323,37 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_lane_description_masks = std::move(masks);
     }
 
-    void InitializeCoreInformationPointer(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeCoreInformationPointer(storage::DataLayout &data_layout,
+                                          const storage::DataLayout::GroupMemory &memory_block)
     {
         auto core_marker_ptr =
             data_layout.GetBlockPtr<unsigned>(memory_block, storage::DataLayout::CORE_MARKER);
         util::ShM<bool, true>::vector is_core_node(
             core_marker_ptr, data_layout.num_entries[storage::DataLayout::CORE_MARKER]);
         m_is_core_node = std::move(is_core_node);
+
+        auto level_order_ptr =
+            data_layout.GetBlockPtr<NodeID>(memory_block, storage::DataLayout::NODE_LEVEL_ORDER);
+        m_level_order.reset(level_order_ptr,
+                            data_layout.num_entries[storage::DataLayout::NODE_LEVEL_ORDER]);
+    }
+
+    void InitializeShortcutChildrenPointers(storage::DataLayout &data_layout,
+                                            const storage::DataLayout::GroupMemory &memory_block)
+    {
+        auto blocks_ptr = data_layout.GetBlockPtr<contractor::ShortcutChildrenBlock>(
+            memory_block, storage::DataLayout::SHORTCUT_CHILDREN_BLOCKS);
+        m_shortcut_children_blocks.reset(
+            blocks_ptr, data_layout.num_entries[storage::DataLayout::SHORTCUT_CHILDREN_BLOCKS]);
+
+        auto children_ptr = data_layout.GetBlockPtr<contractor::ShortcutChildren>(
+            memory_block, storage::DataLayout::SHORTCUT_CHILDREN);
+        m_shortcut_children.reset(children_ptr,
+                                  data_layout.num_entries[storage::DataLayout::SHORTCUT_CHILDREN]);
     }
 
-    void InitializeTurnPenalties(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeTurnPenalties(storage::DataLayout &data_layout,
+                                 const storage::DataLayout::GroupMemory &memory_block)
     {
         auto turn_weight_penalties_ptr = data_layout.GetBlockPtr<TurnPenalty>(
             memory_block, storage::DataLayout::TURN_WEIGHT_PENALTIES);
@@ -323,7 +376,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         }
     }
 
-    void InitializeGeometryPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeGeometryPointers(storage::DataLayout &data_layout,
+                                    const storage::DataLayout::GroupMemory &memory_block)
     {
         auto geometries_index_ptr =
             data_layout.GetBlockPtr<unsigned>(memory_block, storage::DataLayout::GEOMETRIES_INDEX);
@@ -394,7 +448,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_datasource_name_lengths = std::move(datasource_name_lengths);
     }
 
-    void InitializeIntersectionClassPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeIntersectionClassPointers(storage::DataLayout &data_layout,
+                                             const storage::DataLayout::GroupMemory &memory_block)
     {
         auto bearing_class_id_ptr = data_layout.GetBlockPtr<BearingClassID>(
             memory_block, storage::DataLayout::BEARING_CLASSID);
@@ -427,7 +482,8 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         m_entry_class_table = std::move(entry_class_table);
     }
 
-    void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeInternalPointers(storage::DataLayout &data_layout,
+                                    const storage::DataLayout::GroupMemory &memory_block)
     {
         InitializeGraphPointer(data_layout, memory_block);
         InitializeChecksumPointer(data_layout, memory_block);
@@ -439,6 +495,7 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
         InitializeNamePointers(data_layout, memory_block);
         InitializeTurnLaneDescriptionsPointers(data_layout, memory_block);
         InitializeCoreInformationPointer(data_layout, memory_block);
+        InitializeShortcutChildrenPointers(data_layout, memory_block);
         InitializeProfilePropertiesPointer(data_layout, memory_block);
         InitializeRTreePointers(data_layout, memory_block);
         InitializeIntersectionClassPointers(data_layout, memory_block);
@@ -446,11 +503,16 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
 
   public:
     // allows switching between process_memory/shared_memory datafacade, based on the type of
-    // allocator
-    ContiguousInternalMemoryDataFacade(std::unique_ptr<ContiguousBlockAllocator> allocator_)
+    // allocator. A positive unpacking cache size enables caching of unpacked shortcuts.
+    ContiguousInternalMemoryDataFacade(std::unique_ptr<ContiguousBlockAllocator> allocator_,
+                                       const std::size_t unpacking_cache_size = 0)
         : allocator(std::move(allocator_))
     {
         InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
+        if (unpacking_cache_size > 0)
+        {
+            m_unpacking_cache = std::make_unique<UnpackingCache>(unpacking_cache_size);
+        }
     }
 
     // search graph access
@@ -838,6 +900,20 @@ class ContiguousInternalMemoryDataFacade : public BaseDataFacade
 
     virtual std::size_t GetCoreSize() const override final { return m_is_core_node.size(); }
 
+    util::ShM<NodeID, true>::vector GetLevelOrder() const override final { return m_level_order; }
+
+    UnpackingCache *GetUnpackingCache() const override final { return m_unpacking_cache.get(); }
+
+    bool HasShortcutChildren() const override final { return !m_shortcut_children_blocks.empty(); }
+
+    contractor::ShortcutChildren GetShortcutChildren(const EdgeID shortcut,
+                                                     const bool reversed) const override final
+    {
+        BOOST_ASSERT(HasShortcutChildren());
+        return m_shortcut_children[contractor::getShortcutChildrenIndex(
+            m_shortcut_children_blocks, shortcut, reversed)];
+    }
+
     // Returns the data source ids that were used to supply the edge
     // weights.
     virtual std::vector<DatasourceID>
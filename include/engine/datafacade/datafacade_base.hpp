@@ -4,18 +4,21 @@
 // Exposes all data access interfaces to the algorithms via base class ptr
 
 #include "contractor/query_edge.hpp"
+#include "contractor/shortcut_children.hpp"
 #include "extractor/edge_based_node.hpp"
 #include "extractor/external_memory_node.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/guidance/turn_lane_types.hpp"
 #include "extractor/original_edge_data.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/unpacking_cache.hpp"
 #include "util/exception.hpp"
 #include "util/guidance/bearing_class.hpp"
 #include "util/guidance/entry_class.hpp"
 #include "util/guidance/turn_bearing.hpp"
 #include "util/guidance/turn_lanes.hpp"
 #include "util/integer_range.hpp"
+#include "util/shared_memory_vector_wrapper.hpp"
 #include "util/string_util.hpp"
 #include "util/string_view.hpp"
 #include "util/typedefs.hpp"
@@ -179,6 +182,18 @@ class BaseDataFacade
 
     virtual std::size_t GetCoreSize() const = 0;
 
+    // All nodes ordered by descending contraction level, empty if the hierarchy has a core
+    virtual util::ShM<NodeID, true>::vector GetLevelOrder() const = 0;
+
+    // Cache of unpacked shortcuts that lives as long as the dataset, nullptr if disabled
+    virtual UnpackingCache *GetUnpackingCache() const = 0;
+
+    // Direct access to the halves of a shortcut, only available if the dataset has them
+    virtual bool HasShortcutChildren() const = 0;
+
+    virtual contractor::ShortcutChildren GetShortcutChildren(const EdgeID shortcut,
+                                                             const bool reversed) const = 0;
+
     virtual std::string GetTimestamp() const = 0;
 
     virtual bool GetContinueStraightDefault() const = 0;
@@ -0,0 +1,46 @@
+#ifndef OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+#define OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+
+#include "storage/shared_datatype.hpp"
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <memory>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/**
+ * This allocator maps a container file written by osrm-datastore --export.
+ * The data is used in place, so nothing is copied on startup and all
+ * processes mapping the same file share its pages in the page cache.
+ * The header and the table of contents are verified, block checksums
+ * are not, that would read the whole file.
+ */
+class MMapMemoryAllocator : public ContiguousBlockAllocator
+{
+  public:
+    explicit MMapMemoryAllocator(const boost::filesystem::path &container_path);
+    ~MMapMemoryAllocator() override final;
+
+    // interface to give access to the datafacades
+    storage::DataLayout &GetLayout() override final;
+    storage::DataLayout::GroupMemory GetMemory() override final;
+
+  private:
+    boost::iostreams::mapped_file_source mapped_container;
+    std::unique_ptr<storage::DataLayout> internal_layout;
+};
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
@@ -4,6 +4,8 @@
 #include "storage/storage_config.hpp"
 #include "engine/datafacade/contiguous_block_allocator.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 
 namespace osrm
@@ -19,19 +21,30 @@ namespace datafacade
  * shared memory.
  * This class holds a unique_ptr to the memory block, so it
  * is auto-freed upon destruction.
+ * With StorageConfig::use_huge_pages the memory block is advised
+ * to be backed by transparent huge pages.
  */
 class ProcessMemoryAllocator : public ContiguousBlockAllocator
 {
   public:
     explicit ProcessMemoryAllocator(const storage::StorageConfig &config);
+    // Copies the data into memory allocated by the calling thread, see EngineConfig::use_numa
+    ProcessMemoryAllocator(const ProcessMemoryAllocator &other);
     ~ProcessMemoryAllocator() override final;
 
     // interface to give access to the datafacades
     storage::DataLayout &GetLayout() override final;
-    char *GetMemory() override final;
+    storage::DataLayout::GroupMemory GetMemory() override final;
+
+    using MemoryPtr = std::unique_ptr<char, std::function<void(char *)>>;
+
+    // Zero initialized memory. With huge pages it is advised to be backed by transparent huge
+    // pages and falls back to normal pages if they are not available.
+    static MemoryPtr AllocateMemory(const std::size_t size, const bool use_huge_pages);
 
   private:
-    std::unique_ptr<char[]> internal_memory;
+    bool use_huge_pages;
+    MemoryPtr internal_memory;
     std::unique_ptr<storage::DataLayout> internal_layout;
 };
 
@@ -19,6 +19,8 @@ namespace datafacade
 * This allocator uses an IPC shared memory block as the data location.
 * Many SharedMemoryDataFacade objects can be created that point to the same shared
 * memory block.
+* The data region holds the layout and the metric blocks, the static blocks live in
+* the region named in its header.
 */
 class SharedMemoryAllocator : public ContiguousBlockAllocator
 {
@@ -28,10 +30,11 @@ class SharedMemoryAllocator : public ContiguousBlockAllocator
 
     // interface to give access to the datafacades
     storage::DataLayout &GetLayout() override final;
-    char *GetMemory() override final;
+    storage::DataLayout::GroupMemory GetMemory() override final;
 
   private:
     std::unique_ptr<storage::SharedMemory> m_large_memory;
+    std::unique_ptr<storage::SharedMemory> m_static_memory;
 };
 
 } // namespace datafacade
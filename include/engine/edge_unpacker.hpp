@@ -4,11 +4,18 @@
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/travel_mode.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/unpacking_cache.hpp"
 #include "osrm/coordinate.hpp"
 #include "util/guidance/turn_lanes.hpp"
 #include "util/typedefs.hpp"
 
+#include <boost/assert.hpp>
+
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <stack>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -16,6 +23,108 @@ namespace osrm
 namespace engine
 {
 
+namespace detail
+{
+
+// Finds the CH edge that connects both nodes in the direction of travel. This is either an edge
+// stored at `from` with the `.forward` flag or, for parts of the path that were found by the
+// backward search, an edge stored at `to` with the `.backward` flag.
+template <typename DataFacadeT>
+inline EdgeID
+FindCHEdge(const DataFacadeT &facade, const NodeID from, const NodeID to, bool &reversed)
+{
+    using EdgeData = typename DataFacadeT::EdgeData;
+
+    reversed = false;
+    EdgeID smaller_edge_id =
+        facade.FindSmallestEdge(from, to, [](const EdgeData &data) { return data.forward; });
+
+    if (SPECIAL_EDGEID == smaller_edge_id)
+    {
+        reversed = true;
+        smaller_edge_id =
+            facade.FindSmallestEdge(to, from, [](const EdgeData &data) { return data.backward; });
+    }
+
+    // If we didn't find anything *still*, then something is broken and someone has
+    // called this function with bad values.
+    BOOST_ASSERT_MSG(smaller_edge_id != SPECIAL_EDGEID, "Invalid smaller edge ID");
+
+    return smaller_edge_id;
+}
+
+// Depth-first unpacking of a single CH edge that was traversed from `packed_edge.first` to
+// `packed_edge.second`. Calls `callback` with the node pair and the edge id of every original
+// edge, in order. If the facade stores the children of shortcuts, they are used directly
+// instead of searching for the edges of both halves.
+template <typename DataFacadeT, typename Callback>
+inline void UnpackCHEdge(const DataFacadeT &facade,
+                         const std::pair<NodeID, NodeID> packed_edge,
+                         const EdgeID packed_edge_id,
+                         const bool packed_edge_reversed,
+                         Callback &&callback)
+{
+    struct StackEntry
+    {
+        std::pair<NodeID, NodeID> edge;
+        EdgeID edge_id;
+        bool reversed;
+    };
+
+    const bool has_shortcut_children = facade.HasShortcutChildren();
+
+    std::stack<StackEntry> recursion_stack;
+    recursion_stack.push({packed_edge, packed_edge_id, packed_edge_reversed});
+
+    while (!recursion_stack.empty())
+    {
+        StackEntry current = recursion_stack.top();
+        recursion_stack.pop();
+
+        const auto &data = facade.GetEdgeData(current.edge_id);
+        BOOST_ASSERT_MSG(data.weight != std::numeric_limits<EdgeWeight>::max(),
+                         "edge weight invalid");
+
+        // If the edge is a shortcut, we need to add the two halfs to the stack.
+        if (data.shortcut)
+        { // unpack
+            const NodeID middle_node_id = data.id;
+            const std::pair<NodeID, NodeID> first{current.edge.first, middle_node_id};
+            const std::pair<NodeID, NodeID> second{middle_node_id, current.edge.second};
+
+            // Note the order here - we're adding these to a stack, so we
+            // want the first->middle to get visited before middle->second
+            if (has_shortcut_children)
+            {
+                const auto children = facade.GetShortcutChildren(current.edge_id, current.reversed);
+                recursion_stack.push({second,
+                                      static_cast<EdgeID>(children.second.edge),
+                                      static_cast<bool>(children.second.reversed)});
+                recursion_stack.push({first,
+                                      static_cast<EdgeID>(children.first.edge),
+                                      static_cast<bool>(children.first.reversed)});
+            }
+            else
+            {
+                bool second_reversed;
+                const auto second_id =
+                    FindCHEdge(facade, second.first, second.second, second_reversed);
+                recursion_stack.push({second, second_id, second_reversed});
+
+                bool first_reversed;
+                const auto first_id = FindCHEdge(facade, first.first, first.second, first_reversed);
+                recursion_stack.push({first, first_id, first_reversed});
+            }
+        }
+        else
+        {
+            // We found an original edge, call our callback.
+            std::forward<Callback>(callback)(current.edge, current.edge_id);
+        }
+    }
+}
+}
+
 /**
  * Given a sequence of connected `NodeID`s in the CH graph, performs a depth-first unpacking of
  * the shortcut
@@ -31,6 +140,10 @@ namespace engine
  * the original route
  * from beginning to end.
  *
+ * If the facade provides an unpacking cache, the expansion of every shortcut on the path is
+ * looked up there first and stored after a miss. Shortcuts are expanded using their stored
+ * children if the dataset provides them.
+ *
  * @param packed_path_begin iterator pointing to the start of the NodeID list
  * @param packed_path_end iterator pointing to the end of the NodeID list
  * @param callback void(const std::pair<NodeID, NodeID>, const EdgeData &) called for each
@@ -47,57 +160,48 @@ inline void UnpackCHPath(const DataFacadeT &facade,
     if (packed_path_begin == packed_path_end)
         return;
 
-    using EdgeData = typename DataFacadeT::EdgeData;
-
-    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
+    const auto unpack_original_edge = [&facade, &callback](std::pair<NodeID, NodeID> &edge,
+                                                           const EdgeID edge_id) {
+        std::forward<Callback>(callback)(edge, facade.GetEdgeData(edge_id));
+    };
 
-    // We have to push the path in reverse order onto the stack because it's LIFO.
-    for (auto current = std::prev(packed_path_end); current != packed_path_begin;
-         current = std::prev(current))
-    {
-        recursion_stack.emplace(*std::prev(current), *current);
-    }
+    UnpackingCache *const cache = facade.GetUnpackingCache();
 
-    std::pair<NodeID, NodeID> edge;
-    while (!recursion_stack.empty())
+    for (auto current = packed_path_begin; std::next(current) != packed_path_end; ++current)
     {
-        edge = recursion_stack.top();
-        recursion_stack.pop();
+        std::pair<NodeID, NodeID> packed_edge{*current, *std::next(current)};
 
-        // Look for an edge on the forward CH graph (.forward)
-        EdgeID smaller_edge_id = facade.FindSmallestEdge(
-            edge.first, edge.second, [](const EdgeData &data) { return data.forward; });
+        bool reversed;
+        const EdgeID edge_id =
+            detail::FindCHEdge(facade, packed_edge.first, packed_edge.second, reversed);
 
-        // If we didn't find one there, the we might be looking at a part of the path that
-        // was found using the backward search.  Here, we flip the node order (.second, .first)
-        // and only consider edges with the `.backward` flag.
-        if (SPECIAL_EDGEID == smaller_edge_id)
+        if (!cache || !facade.GetEdgeData(edge_id).shortcut)
         {
-            smaller_edge_id = facade.FindSmallestEdge(
-                edge.second, edge.first, [](const EdgeData &data) { return data.backward; });
+            detail::UnpackCHEdge(facade, packed_edge, edge_id, reversed, unpack_original_edge);
+            continue;
         }
 
-        // If we didn't find anything *still*, then something is broken and someone has
-        // called this function with bad values.
-        BOOST_ASSERT_MSG(smaller_edge_id != SPECIAL_EDGEID, "Invalid smaller edge ID");
-
-        const auto &data = facade.GetEdgeData(smaller_edge_id);
-        BOOST_ASSERT_MSG(data.weight != std::numeric_limits<EdgeWeight>::max(),
-                         "edge weight invalid");
-
-        // If the edge is a shortcut, we need to add the two halfs to the stack.
-        if (data.shortcut)
-        { // unpack
-            const NodeID middle_node_id = data.id;
-            // Note the order here - we're adding these to a stack, so we
-            // want the first->middle to get visited before middle->second
-            recursion_stack.emplace(middle_node_id, edge.second);
-            recursion_stack.emplace(edge.first, middle_node_id);
+        auto unpacked_edges = cache->Find(edge_id, reversed);
+        if (!unpacked_edges)
+        {
+            auto new_unpacked_edges = std::make_shared<UnpackingCache::UnpackedEdges>();
+            detail::UnpackCHEdge(facade,
+                                 packed_edge,
+                                 edge_id,
+                                 reversed,
+                                 [&new_unpacked_edges](const std::pair<NodeID, NodeID> &edge,
+                                                       const EdgeID original_edge_id) {
+                                     new_unpacked_edges->push_back(
+                                         {edge.first, edge.second, original_edge_id});
+                                 });
+            unpacked_edges = new_unpacked_edges;
+            cache->Insert(edge_id, reversed, unpacked_edges);
         }
-        else
+
+        for (const auto &unpacked_edge : *unpacked_edges)
         {
-            // We found an original edge, call our callback.
-            std::forward<Callback>(callback)(edge, data);
+            std::pair<NodeID, NodeID> edge{unpacked_edge.from, unpacked_edge.to};
+            unpack_original_edge(edge, unpacked_edge.edge);
         }
     }
 }
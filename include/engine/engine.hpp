@@ -1,8 +1,10 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/optimize_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
@@ -11,8 +13,10 @@
 #include "engine/datafacade/contiguous_block_allocator.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/engine_config.hpp"
+#include "engine/plugins/isochrone.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
+#include "engine/plugins/optimize.hpp"
 #include "engine/plugins/table.hpp"
 #include "engine/plugins/tile.hpp"
 #include "engine/plugins/trip.hpp"
@@ -22,8 +26,10 @@
 #include "util/exception_utils.hpp"
 #include "util/json_container.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -47,18 +53,30 @@ class Engine final
     Status Trip(const api::TripParameters &parameters, util::json::Object &result) const;
     Status Match(const api::MatchParameters &parameters, util::json::Object &result) const;
     Status Tile(const api::TileParameters &parameters, std::string &result) const;
+    Status Isochrone(const api::IsochroneParameters &parameters,
+                     util::json::Object &result) const;
+    Status Optimize(const api::OptimizeParameters &parameters, util::json::Object &result) const;
 
   private:
+    // Loads the files into a facade for each NUMA node, see EngineConfig::use_numa
+    void LoadNodeReplicas(const storage::StorageConfig &storage_config,
+                          const unsigned number_of_nodes);
+
     const plugins::ViaRoutePlugin route_plugin;
     const plugins::TablePlugin table_plugin;
     const plugins::NearestPlugin nearest_plugin;
     const plugins::TripPlugin trip_plugin;
     const plugins::MatchPlugin match_plugin;
     const plugins::TilePlugin tile_plugin;
+    const plugins::IsochronePlugin isochrone_plugin;
+    const plugins::OptimizePlugin optimize_plugin;
+
+    const std::size_t unpacking_cache_size;
 
     // note in case of shared memory this will be empty, since the watchdog
-    // will provide us with the up-to-date facade
-    std::shared_ptr<const datafacade::BaseDataFacade> immutable_data_facade;
+    // will provide us with the up-to-date facade. Holds a facade per NUMA node
+    // if the data is copied to every node.
+    std::vector<std::shared_ptr<const datafacade::BaseDataFacade>> immutable_data_facades;
 };
 }
 }
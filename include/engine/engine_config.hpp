@@ -32,6 +32,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace osrm
@@ -52,8 +53,25 @@ namespace engine
  *  - Table
  *  - Match
  *  - Nearest
+ *  - Optimize
  *
- * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * The maximal travel time in seconds of isochrones can be limited (-1 for unlimited), as well as
+ * the number of alternative routes a Route request may ask for (-1 for unlimited) and the number
+ * of open Match sessions (-1 for unlimited).
+ *
+ * Trips with many locations are improved by a local search that is restarted until the given
+ * time in milliseconds is up (0 to run the local search once). The same holds for the vehicle
+ * routes of the Optimize service, which are improved by ruin and recreate.
+ *
+ * Unpacked shortcuts can be cached, the cache size is the number of original edges it keeps
+ * (0 to disable the cache).
+ *
+ * In addition, shared memory can be used for datasets loaded with osrm-datastore. Without
+ * shared memory, the container written by osrm-datastore --export can be mapped instead of
+ * loading the files, which shares the data between processes through the page cache.
+ *
+ * With use_numa, data loaded from files is copied to every NUMA node and each query uses the
+ * copy of the node it runs on, which multiplies the memory usage by the number of nodes.
  *
  * \see OSRM, StorageConfig
  */
@@ -66,8 +84,18 @@ struct EngineConfig final
     int max_locations_viaroute = -1;
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
+    int max_matching_sessions = -1;
     int max_results_nearest = -1;
+    int max_locations_nearest = -1;
+    int max_duration_isochrone = -1;
+    int max_alternatives = -1;
+    int max_locations_optimize = -1;
+    int trip_search_time = 0;
+    int optimize_search_time = 0;
+    std::size_t unpacking_cache_size = 0;
     bool use_shared_memory = true;
+    bool use_mmap = false;
+    bool use_numa = false;
 };
 }
 }
@@ -12,6 +12,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -52,13 +54,14 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     NearestPhantomNodesInRange(const util::Coordinate input_coordinate,
                                const double max_distance) const
     {
-        auto results =
-            rtree.Nearest(input_coordinate,
-                          [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
-                          [this, max_distance, input_coordinate](const std::size_t,
-                                                                 const CandidateSegment &segment) {
-                              return CheckSegmentDistance(input_coordinate, segment, max_distance);
-                          });
+        auto results = rtree.Nearest(
+            input_coordinate,
+            [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
+            [this, max_distance, input_coordinate](const std::size_t,
+                                                   const CandidateSegment &segment) {
+                return CheckSegmentDistance(input_coordinate, segment, max_distance);
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         return MakePhantomNodes(input_coordinate, results);
     }
@@ -80,7 +83,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
             [this, max_distance, input_coordinate](const std::size_t,
                                                    const CandidateSegment &segment) {
                 return CheckSegmentDistance(input_coordinate, segment, max_distance);
-            });
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         return MakePhantomNodes(input_coordinate, results);
     }
@@ -126,7 +130,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                                                                 const CandidateSegment &segment) {
                 return num_results >= max_results ||
                        CheckSegmentDistance(input_coordinate, segment, max_distance);
-            });
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         return MakePhantomNodes(input_coordinate, results);
     }
@@ -153,14 +158,15 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                         const unsigned max_results,
                         const double max_distance) const
     {
-        auto results =
-            rtree.Nearest(input_coordinate,
-                          [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
-                          [this, max_distance, max_results, input_coordinate](
-                              const std::size_t num_results, const CandidateSegment &segment) {
-                              return num_results >= max_results ||
-                                     CheckSegmentDistance(input_coordinate, segment, max_distance);
-                          });
+        auto results = rtree.Nearest(
+            input_coordinate,
+            [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
+            [this, max_distance, max_results, input_coordinate](const std::size_t num_results,
+                                                                const CandidateSegment &segment) {
+                return num_results >= max_results ||
+                       CheckSegmentDistance(input_coordinate, segment, max_distance);
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         return MakePhantomNodes(input_coordinate, results);
     }
@@ -193,7 +199,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 const std::size_t num_results, const CandidateSegment &segment) {
                 return (num_results > 0 && has_big_component) ||
                        CheckSegmentDistance(input_coordinate, segment, max_distance);
-            });
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         if (results.size() == 0)
         {
@@ -327,7 +334,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 const std::size_t num_results, const CandidateSegment &segment) {
                 return (num_results > 0 && has_big_component) ||
                        CheckSegmentDistance(input_coordinate, segment, max_distance);
-            });
+            },
+            GetMaxSquaredDistance(input_coordinate, max_distance));
 
         if (results.size() == 0)
         {
@@ -432,6 +440,32 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         return transformed;
     }
 
+    // Bounds the squared distance in the r-tree of all segments within max_distance from above.
+    // Web mercator stretches lengths by 1 / cos(latitude), so the bound uses the latitude
+    // farthest from the equator that is still within max_distance. The margin covers rounding
+    // to fixed point coordinates. Returns no bound close to the poles.
+    std::uint64_t GetMaxSquaredDistance(const Coordinate input_coordinate,
+                                        const double max_distance) const
+    {
+        using namespace util::coordinate_calculation::detail;
+        const constexpr double MAX_BOUNDED_LATITUDE = 85.;
+
+        const double max_degrees = max_distance / EARTH_RADIUS * RAD_TO_DEGREE;
+        const double max_latitude =
+            std::abs(static_cast<double>(util::toFloating(input_coordinate.lat))) + max_degrees;
+        // also catches unlimited distances
+        if (!(max_latitude < MAX_BOUNDED_LATITUDE))
+        {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+
+        const double max_projected_distance =
+            1.01 * max_degrees / std::cos(max_latitude * DEGREE_TO_RAD) * COORDINATE_PRECISION +
+            4.;
+        const auto bound = static_cast<std::uint64_t>(std::ceil(max_projected_distance));
+        return bound * bound;
+    }
+
     bool CheckSegmentDistance(const Coordinate input_coordinate,
                               const CandidateSegment &segment,
                               const double max_distance) const
@@ -0,0 +1,64 @@
+#ifndef ENGINE_ISOCHRONE_GRID_HPP
+#define ENGINE_ISOCHRONE_GRID_HPP
+
+#include "util/coordinate.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// A polygon with closed rings. The outer ring is counter-clockwise, holes are clockwise.
+struct IsochronePolygon
+{
+    std::vector<util::Coordinate> outer;
+    std::vector<std::vector<util::Coordinate>> holes;
+};
+
+// Raster of arrival times around a set of road segments.
+//
+// Segments are sampled into square cells of roughly cell_size meters, each cell keeps the
+// earliest time of all samples that fall into it. Contouring a threshold returns the polygons
+// that enclose all cells within the threshold, buffered by one cell to close the gaps between
+// roads.
+class IsochroneGrid
+{
+  public:
+    // The grid is limited to MAX_CELLS, the cell size is increased for larger areas.
+    static const constexpr std::size_t MAX_CELLS = 1 << 20;
+
+    IsochroneGrid(const util::Coordinate south_west,
+                  const util::Coordinate north_east,
+                  const double cell_size);
+
+    // Samples the segment, the time is interpolated linearly between both ends.
+    // Parts of the segment with a negative time are ignored.
+    void AddSegment(const util::Coordinate from,
+                    const util::Coordinate to,
+                    const EdgeWeight from_time,
+                    const EdgeWeight to_time);
+
+    std::vector<IsochronePolygon> Contour(const EdgeWeight max_time) const;
+
+    std::size_t GetWidth() const { return width; }
+    std::size_t GetHeight() const { return height; }
+
+  private:
+    util::Coordinate ToCoordinate(const double x, const double y) const;
+
+    double origin_lon;
+    double origin_lat;
+    double cell_lon;
+    double cell_lat;
+    std::size_t width;
+    std::size_t height;
+    std::vector<EdgeWeight> times;
+};
+}
+}
+
+#endif
@@ -5,9 +5,13 @@
 
 #include <boost/assert.hpp>
 #include <boost/math/constants/constants.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -48,73 +52,106 @@ struct TransitionLogProbability
     double operator()(const double d_t) const { return -log_beta - d_t / beta; }
 };
 
-template <class CandidateLists> struct HiddenMarkovModel
+// A column of the model holds the values of all candidates of one timestamp
+template <typename T> using Column = boost::iterator_range<T *>;
+
+template <typename T> inline Column<T> makeColumn(std::vector<T> &values)
+{
+    return {values.data(), values.data() + values.size()};
+}
+
+template <typename T> inline Column<const T> makeColumn(const std::vector<T> &values)
+{
+    return {values.data(), values.data() + values.size()};
+}
+
+// The values of all candidates of a trace are stored back to back, the candidates of timestamp t
+// start at `offsets[t]`. Loading the next trace keeps the capacity of the arrays, so a model
+// that is reused for many traces does not allocate.
+struct HiddenMarkovModel
 {
-    std::vector<std::vector<double>> viterbi;
-    std::vector<std::vector<std::pair<unsigned, unsigned>>> parents;
-    std::vector<std::vector<float>> path_distances;
-    std::vector<std::vector<bool>> pruned;
-    std::vector<bool> breakage;
-
-    const CandidateLists &candidates_list;
-    const std::vector<std::vector<double>> &emission_log_probabilities;
-
-    HiddenMarkovModel(const CandidateLists &candidates_list,
-                      const std::vector<std::vector<double>> &emission_log_probabilities)
-        : breakage(candidates_list.size()), candidates_list(candidates_list),
-          emission_log_probabilities(emission_log_probabilities)
+    std::vector<std::size_t> offsets;
+
+    // per candidate
+    std::vector<double> emission_log_probabilities;
+    std::vector<double> viterbi;
+    // candidate of the parent timestamp
+    std::vector<unsigned> parents;
+    std::vector<float> path_distances;
+    std::vector<std::uint8_t> pruned;
+
+    // per timestamp, all candidates of a timestamp are reached from the same timestamp
+    std::vector<std::size_t> parent_timestamps;
+    std::vector<std::uint8_t> breakage;
+
+    template <class CandidateLists> void Load(const CandidateLists &candidates_list)
     {
-        viterbi.resize(candidates_list.size());
-        parents.resize(candidates_list.size());
-        path_distances.resize(candidates_list.size());
-        pruned.resize(candidates_list.size());
-        breakage.resize(candidates_list.size());
-        for (const auto i : util::irange<std::size_t>(0UL, candidates_list.size()))
+        offsets.resize(candidates_list.size() + 1);
+        offsets.front() = 0;
+        for (const auto t : util::irange<std::size_t>(0UL, candidates_list.size()))
         {
-            const auto &num_candidates = candidates_list[i].size();
-            // add empty vectors
-            if (num_candidates > 0)
-            {
-                viterbi[i].resize(num_candidates);
-                parents[i].resize(num_candidates);
-                path_distances[i].resize(num_candidates);
-                pruned[i].resize(num_candidates);
-            }
+            offsets[t + 1] = offsets[t] + candidates_list[t].size();
         }
 
+        const auto number_of_states = offsets.back();
+        emission_log_probabilities.resize(number_of_states);
+        viterbi.resize(number_of_states);
+        parents.resize(number_of_states);
+        path_distances.resize(number_of_states);
+        pruned.resize(number_of_states);
+
+        parent_timestamps.resize(candidates_list.size());
+        breakage.resize(candidates_list.size());
+
         Clear(0);
     }
 
-    void Clear(std::size_t initial_timestamp)
+    std::size_t NumberOfTimestamps() const { return breakage.size(); }
+
+    Column<double> EmissionLogProbabilities(const std::size_t t)
     {
-        BOOST_ASSERT(viterbi.size() == parents.size() && parents.size() == path_distances.size() &&
-                     path_distances.size() == pruned.size() && pruned.size() == breakage.size());
+        return GetColumn(emission_log_probabilities, t);
+    }
+    Column<double> Viterbi(const std::size_t t) { return GetColumn(viterbi, t); }
+    Column<unsigned> Parents(const std::size_t t) { return GetColumn(parents, t); }
+    Column<float> PathDistances(const std::size_t t) { return GetColumn(path_distances, t); }
+    Column<std::uint8_t> Pruned(const std::size_t t) { return GetColumn(pruned, t); }
 
-        for (const auto t : util::irange(initial_timestamp, viterbi.size()))
-        {
-            std::fill(viterbi[t].begin(), viterbi[t].end(), IMPOSSIBLE_LOG_PROB);
-            std::fill(parents[t].begin(), parents[t].end(), std::make_pair(0u, 0u));
-            std::fill(path_distances[t].begin(), path_distances[t].end(), 0);
-            std::fill(pruned[t].begin(), pruned[t].end(), true);
-        }
+    void Clear(std::size_t initial_timestamp)
+    {
+        BOOST_ASSERT(offsets.size() == breakage.size() + 1);
+        BOOST_ASSERT(initial_timestamp < offsets.size());
+
+        const auto first_state = offsets[initial_timestamp];
+        std::fill(viterbi.begin() + first_state, viterbi.end(), IMPOSSIBLE_LOG_PROB);
+        std::fill(parents.begin() + first_state, parents.end(), 0);
+        std::fill(path_distances.begin() + first_state, path_distances.end(), 0);
+        std::fill(pruned.begin() + first_state, pruned.end(), true);
+        std::fill(parent_timestamps.begin() + initial_timestamp, parent_timestamps.end(), 0);
         std::fill(breakage.begin() + initial_timestamp, breakage.end(), true);
     }
 
     std::size_t initialize(std::size_t initial_timestamp)
     {
-        auto num_points = candidates_list.size();
+        auto num_points = NumberOfTimestamps();
         do
         {
             BOOST_ASSERT(initial_timestamp < num_points);
 
-            for (const auto s : util::irange<std::size_t>(0UL, viterbi[initial_timestamp].size()))
+            auto current_viterbi = Viterbi(initial_timestamp);
+            auto current_parents = Parents(initial_timestamp);
+            auto current_pruned = Pruned(initial_timestamp);
+            const auto current_emission_log_probabilities =
+                EmissionLogProbabilities(initial_timestamp);
+
+            parent_timestamps[initial_timestamp] = initial_timestamp;
+            for (const auto s : util::irange<std::size_t>(0UL, current_viterbi.size()))
             {
-                viterbi[initial_timestamp][s] = emission_log_probabilities[initial_timestamp][s];
-                parents[initial_timestamp][s] = std::make_pair(initial_timestamp, s);
-                pruned[initial_timestamp][s] = viterbi[initial_timestamp][s] < MINIMAL_LOG_PROB;
+                current_viterbi[s] = current_emission_log_probabilities[s];
+                current_parents[s] = s;
+                current_pruned[s] = current_viterbi[s] < MINIMAL_LOG_PROB;
 
-                breakage[initial_timestamp] =
-                    breakage[initial_timestamp] && pruned[initial_timestamp][s];
+                breakage[initial_timestamp] = breakage[initial_timestamp] && current_pruned[s];
             }
 
             ++initial_timestamp;
@@ -132,6 +169,13 @@ template <class CandidateLists> struct HiddenMarkovModel
 
         return initial_timestamp;
     }
+
+  private:
+    template <typename T> Column<T> GetColumn(std::vector<T> &values, const std::size_t t)
+    {
+        BOOST_ASSERT(t + 1 < offsets.size());
+        return {values.data() + offsets[t], values.data() + offsets[t + 1]};
+    }
 };
 }
 }
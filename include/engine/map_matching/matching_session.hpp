@@ -0,0 +1,70 @@
+#ifndef MAP_MATCHING_MATCHING_SESSION_HPP
+#define MAP_MATCHING_MATCHING_SESSION_HPP
+
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+// Viterbi state of a trace that is matched while it is recorded.
+//
+// Only the trace points that are not confirmed yet are kept. A trace point is confirmed once
+// all candidates of the latest trace point that can still be part of the matching descend from
+// the same candidate of that trace point, since no later trace point can change its matching.
+struct MatchingSession
+{
+    struct TracePoint
+    {
+        // position of the trace point in all trace points the session received
+        unsigned index;
+        util::Coordinate coordinate;
+        boost::optional<unsigned> timestamp;
+
+        std::vector<PhantomNodeWithDistance> candidates;
+        std::vector<double> viterbi;
+        // candidate of the previous trace point in the window
+        std::vector<unsigned> parents;
+        std::vector<float> path_distances;
+        std::vector<std::uint8_t> pruned;
+    };
+
+    // Unconfirmed trace points that could be matched. If `anchored` is set, the first one is the
+    // last confirmed trace point and has exactly one candidate left that is not pruned.
+    std::deque<TracePoint> window;
+    bool anchored = false;
+
+    // timestamps of the latest trace points to estimate the sample time
+    std::deque<unsigned> recent_timestamps;
+    // trace points without any transition since the last trace point in the window
+    unsigned broken_points = 0;
+    unsigned number_of_points = 0;
+
+    // checksum of the dataset the candidates were snapped on
+    unsigned checksum = 0;
+
+    void Reset(const unsigned checksum_)
+    {
+        window.clear();
+        anchored = false;
+        recent_timestamps.clear();
+        broken_points = 0;
+        checksum = checksum_;
+    }
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef MAP_MATCHING_MATCHING_SESSIONS_HPP
+#define MAP_MATCHING_MATCHING_SESSIONS_HPP
+
+#include "engine/map_matching/matching_session.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+// The open matching sessions by their id.
+//
+// Sessions that were not accessed within the timeout are dropped. At most max_sessions sessions
+// are kept open (-1 for unlimited), new sessions are rejected at the limit so the memory used by
+// the sessions stays bounded.
+class MatchingSessions
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Session
+    {
+        std::mutex mutex;
+        MatchingSession state;
+        Clock::time_point last_access;
+    };
+
+    MatchingSessions(const Clock::duration timeout, const int max_sessions)
+        : timeout(timeout), max_sessions(max_sessions)
+    {
+    }
+
+    // Returns the session with the given id and creates it if it does not exist. Returns no
+    // session if it would need to be created but the limit is reached.
+    std::shared_ptr<Session> Get(const std::string &id, const Clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto iter = sessions.begin(); iter != sessions.end();)
+        {
+            if (now - iter->second->last_access > timeout)
+            {
+                iter = sessions.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        auto iter = sessions.find(id);
+        if (iter == sessions.end())
+        {
+            if (max_sessions >= 0 && sessions.size() >= static_cast<std::size_t>(max_sessions))
+            {
+                return {};
+            }
+            iter = sessions.emplace(id, std::make_shared<Session>()).first;
+        }
+        iter->second->last_access = now;
+        return iter->second;
+    }
+
+    void Remove(const std::string &id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sessions.erase(id);
+    }
+
+    std::size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sessions.size();
+    }
+
+  private:
+    const Clock::duration timeout;
+    const int max_sessions;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Session>> sessions;
+};
+}
+}
+}
+
+#endif
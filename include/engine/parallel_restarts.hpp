@@ -0,0 +1,86 @@
+#ifndef ENGINE_PARALLEL_RESTARTS_HPP
+#define ENGINE_PARALLEL_RESTARTS_HPP
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Improves a solution by a local search that is restarted once per hardware thread in parallel.
+//
+// Each restart copies the initial solution and calls start(restart, solution, generator), which
+// can move it to a different starting point. It then applies move(candidate, generator) to copies
+// of its solution and keeps those with a lower get_cost(candidate), until max_failed_moves moves
+// in a row did not improve or the deadline passed. The cheapest solution of all restarts, the
+// first one on ties, replaces the initial solution if it is cheaper. Every restart has its own
+// generator seeded by its index, so the result only depends on the deadline and the number of
+// hardware threads.
+template <typename Solution, typename StartFunction, typename MoveFunction, typename CostFunction>
+void runParallelRestarts(Solution &best_solution,
+                         const std::chrono::steady_clock::time_point deadline,
+                         const std::size_t max_failed_moves,
+                         StartFunction &&start,
+                         MoveFunction &&move,
+                         CostFunction &&get_cost)
+{
+    using Cost = decltype(get_cost(best_solution));
+
+    const std::size_t number_of_restarts = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Solution> solutions(number_of_restarts, best_solution);
+    std::vector<Cost> costs(number_of_restarts);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, number_of_restarts, 1),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            for (auto restart = range.begin(); restart != range.end(); ++restart)
+            {
+                std::mt19937 generator(restart);
+
+                auto &solution = solutions[restart];
+                start(restart, solution, generator);
+                auto cost = get_cost(solution);
+
+                std::size_t failed_moves = 0;
+                while (failed_moves < max_failed_moves &&
+                       std::chrono::steady_clock::now() < deadline)
+                {
+                    auto candidate = solution;
+                    move(candidate, generator);
+                    const auto candidate_cost = get_cost(candidate);
+                    if (candidate_cost < cost)
+                    {
+                        solution = std::move(candidate);
+                        cost = candidate_cost;
+                        failed_moves = 0;
+                    }
+                    else
+                    {
+                        ++failed_moves;
+                    }
+                }
+                costs[restart] = cost;
+            }
+        });
+
+    const auto best_restart =
+        std::distance(costs.begin(), std::min_element(costs.begin(), costs.end()));
+    if (costs[best_restart] < get_cost(best_solution))
+    {
+        best_solution = std::move(solutions[best_restart]);
+    }
+}
+}
+}
+
+#endif // ENGINE_PARALLEL_RESTARTS_HPP
@@ -0,0 +1,40 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include "engine/plugins/plugin_base.hpp"
+
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/routing_algorithms/one_to_all.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/json_container.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Computes the areas reachable from a coordinate within the given travel times.
+//
+// A single one-to-all search labels all nodes, the reached road segments around the source
+// are rasterized and the grid is contoured into polygons for each threshold.
+class IsochronePlugin final : public BasePlugin
+{
+  public:
+    explicit IsochronePlugin(const int max_duration_isochrone);
+
+    Status HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                         const api::IsochroneParameters &params,
+                         util::json::Object &result) const;
+
+  private:
+    mutable SearchEngineData heaps;
+    mutable routing_algorithms::OneToAllRouting one_to_all;
+    const int max_duration_isochrone;
+};
+}
+}
+}
+
+#endif // ISOCHRONE_HPP
@@ -5,10 +5,14 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "engine/map_matching/bayes_classifier.hpp"
+#include "engine/map_matching/matching_sessions.hpp"
 #include "engine/routing_algorithms/map_matching.hpp"
 #include "engine/routing_algorithms/shortest_path.hpp"
 #include "util/json_util.hpp"
 
+#include <chrono>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -26,9 +30,12 @@ class MatchPlugin : public BasePlugin
     using CandidateLists = routing_algorithms::CandidateLists;
     static const constexpr double DEFAULT_GPS_PRECISION = 5;
     static const constexpr double RADIUS_MULTIPLIER = 3;
+    // sessions that were not extended for this long are dropped
+    static const constexpr std::chrono::seconds::rep SESSION_TIMEOUT = 300;
 
-    MatchPlugin(const int max_locations_map_matching)
-        : map_matching(heaps, DEFAULT_GPS_PRECISION), shortest_path(heaps),
+    MatchPlugin(const int max_locations_map_matching, const int max_matching_sessions)
+        : sessions(std::chrono::seconds(SESSION_TIMEOUT), max_matching_sessions),
+          map_matching(heaps, DEFAULT_GPS_PRECISION), shortest_path(heaps),
           max_locations_map_matching(max_locations_map_matching)
     {
     }
@@ -37,7 +44,27 @@ class MatchPlugin : public BasePlugin
                          const api::MatchParameters &parameters,
                          util::json::Object &json_result) const;
 
+    // Matches a trace without building a response, to process many traces offline. The
+    // parameters need to be valid and checked as in HandleRequest. Returns no sub matchings if
+    // the trace could not be matched.
+    SubMatchingList MatchTrace(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                               const api::MatchParameters &parameters,
+                               std::vector<InternalRouteResult> &sub_routes) const;
+
   private:
+    Status HandleSessionRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                const api::MatchParameters &parameters,
+                                util::json::Object &json_result) const;
+
+    CandidateLists GetCandidates(const datafacade::BaseDataFacade &facade,
+                                 const api::MatchParameters &parameters) const;
+
+    std::vector<InternalRouteResult>
+    GetSubRoutes(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                 const SubMatchingList &sub_matchings) const;
+
+    mutable map_matching::MatchingSessions sessions;
+
     mutable SearchEngineData heaps;
     mutable routing_algorithms::MapMatching map_matching;
     mutable routing_algorithms::ShortestPathRouting shortest_path;
@@ -5,6 +5,8 @@
 #include "engine/plugins/plugin_base.hpp"
 #include "osrm/json_container.hpp"
 
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -15,14 +17,22 @@ namespace plugins
 class NearestPlugin final : public BasePlugin
 {
   public:
-    explicit NearestPlugin(const int max_results);
+    NearestPlugin(const int max_results, const int max_locations);
 
     Status HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                          const api::NearestParameters &params,
                          util::json::Object &result) const;
 
   private:
+    // Snaps all coordinates in parallel. The coordinates are ordered along a Hilbert curve and
+    // split into batches of close coordinates, so the queries of a batch traverse the same parts
+    // of the R-tree while they are still cached.
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    GetBulkPhantomNodes(const datafacade::BaseDataFacade &facade,
+                        const api::NearestParameters &params) const;
+
     const int max_results;
+    const int max_locations;
 };
 }
 }
@@ -0,0 +1,49 @@
+#ifndef OPTIMIZE_HPP
+#define OPTIMIZE_HPP
+
+#include "engine/plugins/plugin_base.hpp"
+
+#include "engine/api/optimize_parameters.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/shortest_path.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "util/json_container.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Routes several vehicles from a depot to the coordinates.
+//
+// All coordinates are snapped once, the durations between them are computed by a single
+// many-to-many search and the vehicle routing problem is solved on that table. Only the routes
+// of the vehicles that serve any coordinate are computed.
+class OptimizePlugin final : public BasePlugin
+{
+  public:
+    OptimizePlugin(const int max_locations_optimize, const int optimize_search_time);
+
+    Status HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                         const api::OptimizeParameters &parameters,
+                         util::json::Object &json_result) const;
+
+  private:
+    mutable SearchEngineData heaps;
+    mutable routing_algorithms::ShortestPathRouting shortest_path;
+    mutable routing_algorithms::ManyToManyRouting duration_table;
+    const int max_locations_optimize;
+    const std::chrono::milliseconds optimize_search_time;
+};
+}
+}
+}
+
+#endif // OPTIMIZE_HPP
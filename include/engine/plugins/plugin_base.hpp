@@ -149,6 +149,51 @@ class BasePlugin
         return phantom_nodes;
     }
 
+    // Returns the phantom nodes of the coordinate with the given index
+    std::vector<PhantomNodeWithDistance>
+    GetPhantomNodesOfCoordinate(const datafacade::BaseDataFacade &facade,
+                                const api::BaseParameters &parameters,
+                                const std::size_t i,
+                                unsigned number_of_results) const
+    {
+        const bool use_hints = !parameters.hints.empty();
+        const bool use_bearings = !parameters.bearings.empty();
+        const bool use_radiuses = !parameters.radiuses.empty();
+
+        if (use_hints && parameters.hints[i] &&
+            parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+        {
+            return {PhantomNodeWithDistance{
+                parameters.hints[i]->phantom,
+                util::coordinate_calculation::haversineDistance(
+                    parameters.coordinates[i], parameters.hints[i]->phantom.location),
+            }};
+        }
+
+        if (use_bearings && parameters.bearings[i])
+        {
+            if (use_radiuses && parameters.radiuses[i])
+            {
+                return facade.NearestPhantomNodes(parameters.coordinates[i],
+                                                  number_of_results,
+                                                  *parameters.radiuses[i],
+                                                  parameters.bearings[i]->bearing,
+                                                  parameters.bearings[i]->range);
+            }
+            return facade.NearestPhantomNodes(parameters.coordinates[i],
+                                              number_of_results,
+                                              parameters.bearings[i]->bearing,
+                                              parameters.bearings[i]->range);
+        }
+
+        if (use_radiuses && parameters.radiuses[i])
+        {
+            return facade.NearestPhantomNodes(
+                parameters.coordinates[i], number_of_results, *parameters.radiuses[i]);
+        }
+        return facade.NearestPhantomNodes(parameters.coordinates[i], number_of_results);
+    }
+
     std::vector<std::vector<PhantomNodeWithDistance>>
     GetPhantomNodes(const datafacade::BaseDataFacade &facade,
                     const api::BaseParameters &parameters,
@@ -157,55 +202,11 @@ class BasePlugin
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
-        const bool use_bearings = !parameters.bearings.empty();
-        const bool use_radiuses = !parameters.radiuses.empty();
-
         BOOST_ASSERT(parameters.IsValid());
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
-            {
-                phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                    parameters.hints[i]->phantom,
-                    util::coordinate_calculation::haversineDistance(
-                        parameters.coordinates[i], parameters.hints[i]->phantom.location),
-                });
-                continue;
-            }
-
-            if (use_bearings && parameters.bearings[i])
-            {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(parameters.coordinates[i],
-                                                                  number_of_results,
-                                                                  *parameters.radiuses[i],
-                                                                  parameters.bearings[i]->bearing,
-                                                                  parameters.bearings[i]->range);
-                }
-                else
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(parameters.coordinates[i],
-                                                                  number_of_results,
-                                                                  parameters.bearings[i]->bearing,
-                                                                  parameters.bearings[i]->range);
-                }
-            }
-            else
-            {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(
-                        parameters.coordinates[i], number_of_results, *parameters.radiuses[i]);
-                }
-                else
-                {
-                    phantom_nodes[i] =
-                        facade.NearestPhantomNodes(parameters.coordinates[i], number_of_results);
-                }
-            }
+            phantom_nodes[i] =
+                GetPhantomNodesOfCoordinate(facade, parameters, i, number_of_results);
 
             // we didn't find a fitting node, return error
             if (phantom_nodes[i].empty())
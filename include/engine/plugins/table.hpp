@@ -5,6 +5,7 @@
 
 #include "engine/api/table_parameters.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/one_to_all.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
 
@@ -27,6 +28,7 @@ class TablePlugin final : public BasePlugin
   private:
     mutable SearchEngineData heaps;
     mutable routing_algorithms::ManyToManyRouting distance_table;
+    mutable routing_algorithms::OneToAllRouting one_to_all_table;
     const int max_locations_distance_table;
 };
 }
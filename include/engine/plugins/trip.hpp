@@ -12,6 +12,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iterator>
 #include <memory>
@@ -33,6 +34,7 @@ class TripPlugin final : public BasePlugin
     mutable routing_algorithms::ShortestPathRouting shortest_path;
     mutable routing_algorithms::ManyToManyRouting duration_table;
     const int max_locations_trip;
+    const std::chrono::milliseconds trip_search_time;
 
     InternalRouteResult ComputeRoute(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                                      const std::vector<PhantomNode> &phantom_node_list,
@@ -40,8 +42,9 @@ class TripPlugin final : public BasePlugin
                                      const bool roundtrip) const;
 
   public:
-    explicit TripPlugin(const int max_locations_trip_)
-        : shortest_path(heaps), duration_table(heaps), max_locations_trip(max_locations_trip_)
+    TripPlugin(const int max_locations_trip_, const int trip_search_time_)
+        : shortest_path(heaps), duration_table(heaps), max_locations_trip(max_locations_trip_),
+          trip_search_time(trip_search_time_)
     {
     }
 
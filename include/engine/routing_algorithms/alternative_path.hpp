@@ -26,6 +26,8 @@ namespace routing_algorithms
 const double constexpr VIAPATH_ALPHA = 0.10;
 const double constexpr VIAPATH_EPSILON = 0.15; // alternative at most 15% longer
 const double constexpr VIAPATH_GAMMA = 0.75;   // alternative shares at most 75% with the shortest.
+// bounds the search effort, number of T-tests per requested alternative
+const unsigned constexpr VIAPATH_MAX_T_TESTS = 8;
 
 class AlternativeRouting final : private BasicRoutingInterface
 {
@@ -59,8 +61,11 @@ class AlternativeRouting final : private BasicRoutingInterface
 
     virtual ~AlternativeRouting() {}
 
+    // Finds up to number_of_alternatives alternatives to the shortest path. Alternatives share
+    // at most VIAPATH_GAMMA with the shortest path and with each other.
     void operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                     const PhantomNodes &phantom_node_pair,
+                    const unsigned number_of_alternatives,
                     InternalRouteResult &raw_route_data);
 
   private:
@@ -76,14 +81,16 @@ class AlternativeRouting final : private BasicRoutingInterface
     // TODO: reorder parameters
     // compute and unpack <s,..,v> and <v,..,t> by exploring search spaces
     // from v and intersecting against queues. only half-searches have to be
-    // done at this stage
+    // done at this stage. Uses thread local heaps, so it can be run in parallel.
     void
     ComputeLengthAndSharingOfViaPath(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                     const QueryHeap &existing_forward_heap,
+                                     const QueryHeap &existing_reverse_heap,
                                      const NodeID via_node,
                                      int *real_length_of_via_path,
                                      int *sharing_of_via_path,
                                      const std::vector<NodeID> &packed_shortest_path,
-                                     const EdgeWeight min_edge_offset);
+                                     const EdgeWeight min_edge_offset) const;
 
     // todo: reorder parameters
     template <bool is_forward_directed>
@@ -180,17 +187,15 @@ class AlternativeRouting final : private BasicRoutingInterface
         }
     }
 
-    // conduct T-Test
+    // conduct T-Test, returns the packed alternative path if the candidate passes.
+    // Uses thread local heaps, so it can be run in parallel.
     bool ViaNodeCandidatePassesTTest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
-                                     QueryHeap &existing_forward_heap,
-                                     QueryHeap &existing_reverse_heap,
-                                     QueryHeap &new_forward_heap,
-                                     QueryHeap &new_reverse_heap,
+                                     const QueryHeap &existing_forward_heap,
+                                     const QueryHeap &existing_reverse_heap,
                                      const RankedCandidateNode &candidate,
                                      const int length_of_shortest_path,
                                      int *length_of_via_path,
-                                     NodeID *s_v_middle,
-                                     NodeID *v_t_middle,
+                                     std::vector<NodeID> &packed_alternate_path,
                                      const EdgeWeight min_edge_offset) const;
 };
 
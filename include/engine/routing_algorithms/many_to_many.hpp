@@ -4,10 +4,12 @@
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
 
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -31,8 +33,12 @@ class ManyToManyRouting final : public BasicRoutingInterface
         unsigned target_id; // essentially a row in the weight matrix
         EdgeWeight weight;
         EdgeWeight duration;
-        NodeBucket(const unsigned target_id, const EdgeWeight weight, const EdgeWeight duration)
-            : target_id(target_id), weight(weight), duration(duration)
+        NodeID parent_node; // parent in the backward search, to retrieve paths
+        NodeBucket(const unsigned target_id,
+                   const EdgeWeight weight,
+                   const EdgeWeight duration,
+                   const NodeID parent_node)
+            : target_id(target_id), weight(weight), duration(duration), parent_node(parent_node)
         {
         }
     };
@@ -52,6 +58,93 @@ class ManyToManyRouting final : public BasicRoutingInterface
                const std::vector<std::size_t> &source_indices,
                const std::vector<std::size_t> &target_indices) const;
 
+    // Calls visitor(source_index, target_index, get_distance) for all pairs of sources and
+    // targets, one source after the other. get_distance() returns the length in meters of the
+    // shortest path, or std::numeric_limits<double>::max() if the target is not reachable.
+    // Computing the length needs to unpack the path, so it is only done on demand.
+    // All distances are computed with one search per source and target, instead of a search per
+    // pair. Needs a fully contracted graph.
+    template <typename Visitor>
+    void ForEachNetworkDistance(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                const std::vector<PhantomNode> &source_phantoms,
+                                const std::vector<PhantomNode> &target_phantoms,
+                                Visitor &&visitor) const
+    {
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade->GetNumberOfNodes());
+
+        QueryHeap &query_heap = *(engine_working_data.many_to_many_heap);
+
+        SearchSpaceWithBuckets search_space_with_buckets;
+        for (const auto column_idx : util::irange<unsigned>(0u, target_phantoms.size()))
+        {
+            SearchTarget(facade,
+                         column_idx,
+                         target_phantoms[column_idx],
+                         query_heap,
+                         search_space_with_buckets);
+        }
+
+        std::vector<EdgeWeight> weights(target_phantoms.size());
+        std::vector<NodeID> middle_nodes(target_phantoms.size());
+        for (const auto row_idx : util::irange<std::size_t>(0UL, source_phantoms.size()))
+        {
+            SearchSourceWithMiddleNodes(facade,
+                                        source_phantoms[row_idx],
+                                        query_heap,
+                                        search_space_with_buckets,
+                                        weights,
+                                        middle_nodes);
+
+            for (const auto column_idx : util::irange<unsigned>(0u, target_phantoms.size()))
+            {
+                const auto get_distance = [&]() -> double {
+                    if (weights[column_idx] == INVALID_EDGE_WEIGHT)
+                    {
+                        return std::numeric_limits<double>::max();
+                    }
+
+                    std::vector<NodeID> packed_path;
+                    RetrievePackedPath(query_heap,
+                                       search_space_with_buckets,
+                                       column_idx,
+                                       weights[column_idx],
+                                       middle_nodes[column_idx],
+                                       packed_path);
+                    return super::GetPathDistance(facade,
+                                                  packed_path,
+                                                  source_phantoms[row_idx],
+                                                  target_phantoms[column_idx]);
+                };
+                visitor(row_idx, column_idx, get_distance);
+            }
+        }
+    }
+
+    // backward search from a target, stores the settled nodes in the buckets
+    void SearchTarget(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                      const unsigned column_idx,
+                      const PhantomNode &phantom,
+                      QueryHeap &query_heap,
+                      SearchSpaceWithBuckets &search_space_with_buckets) const;
+
+    // forward search from a source, notes the best weight and middle node of every target
+    void
+    SearchSourceWithMiddleNodes(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                const PhantomNode &phantom,
+                                QueryHeap &query_heap,
+                                const SearchSpaceWithBuckets &search_space_with_buckets,
+                                std::vector<EdgeWeight> &weights,
+                                std::vector<NodeID> &middle_nodes) const;
+
+    // packed path from the source of the forward search in the heap to a target
+    void RetrievePackedPath(const QueryHeap &query_heap,
+                            const SearchSpaceWithBuckets &search_space_with_buckets,
+                            const unsigned column_idx,
+                            const EdgeWeight weight,
+                            const NodeID middle_node,
+                            std::vector<NodeID> &packed_path) const;
+
     void ForwardRoutingStep(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                             const unsigned row_idx,
                             const unsigned number_of_targets,
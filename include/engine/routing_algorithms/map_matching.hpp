@@ -2,10 +2,12 @@
 #define MAP_MATCHING_HPP
 
 #include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 
 #include "engine/map_matching/hidden_markov_model.hpp"
 #include "engine/map_matching/matching_confidence.hpp"
+#include "engine/map_matching/matching_session.hpp"
 #include "engine/map_matching/sub_matching.hpp"
 
 #include "extractor/profile_properties.hpp"
@@ -13,6 +15,7 @@
 #include "util/for_each_pair.hpp"
 
 #include <cstddef>
+#include <cstdint>
 
 #include <algorithm>
 #include <deque>
@@ -31,12 +34,14 @@ namespace routing_algorithms
 
 using CandidateList = std::vector<PhantomNodeWithDistance>;
 using CandidateLists = std::vector<CandidateList>;
-using HMM = map_matching::HiddenMarkovModel<CandidateLists>;
+using HMM = map_matching::HiddenMarkovModel;
 using SubMatchingList = std::vector<map_matching::SubMatching>;
 
 constexpr static const unsigned MAX_BROKEN_STATES = 10;
 static const constexpr double MATCHING_BETA = 10;
 constexpr static const double MAX_DISTANCE_DELTA = 2000.;
+// trace points of a session that are confirmed even if the viterbi paths did not converge
+constexpr static const std::size_t MAX_UNCONFIRMED_POINTS = 32;
 
 // implements a hidden markov model map matching algorithm
 class MapMatching final : public BasicRoutingInterface
@@ -48,14 +53,64 @@ class MapMatching final : public BasicRoutingInterface
     map_matching::TransitionLogProbability transition_log_probability;
     map_matching::MatchingConfidence confidence;
     extractor::ProfileProperties m_profile_properties;
+    ManyToManyRouting many_to_many;
 
     unsigned GetMedianSampleTime(const std::vector<unsigned> &timestamps) const;
 
+    // Updates the viterbi values of the current candidates with the transitions from the
+    // previous ones. Returns false if no candidate can be reached.
+    bool UpdateTransitions(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                           const CandidateList &prev_candidates,
+                           const map_matching::Column<const double> prev_viterbi,
+                           const map_matching::Column<const std::uint8_t> prev_pruned,
+                           const util::Coordinate prev_coordinate,
+                           const CandidateList &current_candidates,
+                           const map_matching::Column<const double> current_emissions,
+                           const util::Coordinate current_coordinate,
+                           const double max_distance_delta,
+                           const map_matching::Column<double> current_viterbi,
+                           const map_matching::Column<unsigned> current_parents,
+                           const map_matching::Column<float> current_lengths,
+                           const map_matching::Column<std::uint8_t> current_pruned) const;
+
+    template <typename OutputIter>
+    void GetEmissionLogProbabilities(const CandidateList &candidates,
+                                     const boost::optional<double> &gps_precision,
+                                     OutputIter emission_log_probabilities) const
+    {
+        if (gps_precision)
+        {
+            map_matching::EmissionLogProbability emission_log_probability(*gps_precision);
+            std::transform(candidates.begin(),
+                           candidates.end(),
+                           emission_log_probabilities,
+                           [&emission_log_probability](const PhantomNodeWithDistance &candidate) {
+                               return emission_log_probability(candidate.distance);
+                           });
+        }
+        else
+        {
+            std::transform(candidates.begin(),
+                           candidates.end(),
+                           emission_log_probabilities,
+                           [this](const PhantomNodeWithDistance &candidate) {
+                               return default_emission_log_probability(candidate.distance);
+                           });
+        }
+    }
+
+    // Confirms the trace points of the session window up to `last_index` along the path that
+    // ends in `last_candidate`
+    void ConfirmSessionPoints(map_matching::MatchingSession &session,
+                              const std::size_t last_index,
+                              const std::size_t last_candidate,
+                              SubMatchingList &sub_matchings) const;
+
   public:
     MapMatching(SearchEngineData &engine_working_data, const double default_gps_precision)
         : engine_working_data(engine_working_data),
           default_emission_log_probability(default_gps_precision),
-          transition_log_probability(MATCHING_BETA)
+          transition_log_probability(MATCHING_BETA), many_to_many(engine_working_data)
     {
     }
 
@@ -65,6 +120,17 @@ class MapMatching final : public BasicRoutingInterface
                const std::vector<util::Coordinate> &trace_coordinates,
                const std::vector<unsigned> &trace_timestamps,
                const std::vector<boost::optional<double>> &trace_gps_precision) const;
+
+    // Extends the matching of a session with new trace points. Returns the sub matchings of the
+    // trace points that were confirmed, their indices refer to all trace points of the session.
+    // If `finish` is set, the remaining trace points are confirmed along the best path.
+    SubMatchingList Extend(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                           map_matching::MatchingSession &session,
+                           const CandidateLists &candidates_list,
+                           const std::vector<util::Coordinate> &trace_coordinates,
+                           const std::vector<unsigned> &trace_timestamps,
+                           const std::vector<boost::optional<double>> &trace_gps_precision,
+                           const bool finish) const;
 };
 }
 }
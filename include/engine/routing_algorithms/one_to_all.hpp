@@ -0,0 +1,68 @@
+#ifndef ONE_TO_ALL_ROUTING_HPP
+#define ONE_TO_ALL_ROUTING_HPP
+
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms/routing_base.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/typedefs.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Computes the weights from one source to all nodes of the graph (PHAST): an upward search
+// from the source is followed by a single linear sweep over all nodes in descending level
+// order that relaxes the downward edges. The sweep needs no priority queue and accesses the
+// graph in a fixed order, which makes it much faster than a Dijkstra search on large graphs.
+//
+// Only applicable if the hierarchy is fully contracted and the level order was loaded.
+// The labels are per edge based node, so they are only exposed through the table and the
+// isochrone plugins instead of a service of their own.
+class OneToAllRouting final : public BasicRoutingInterface
+{
+    using super = BasicRoutingInterface;
+    using QueryHeap = SearchEngineData::ManyToManyQueryHeap;
+    SearchEngineData &engine_working_data;
+
+  public:
+    OneToAllRouting(SearchEngineData &engine_working_data)
+        : engine_working_data(engine_working_data)
+    {
+    }
+
+    static bool IsAvailable(const datafacade::BaseDataFacade &facade);
+
+    // Same semantic as ManyToManyRouting, one sweep is done per source
+    std::vector<EdgeWeight>
+    operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+               const std::vector<PhantomNode> &phantom_nodes,
+               const std::vector<std::size_t> &source_indices,
+               const std::vector<std::size_t> &target_indices) const;
+
+    // Labels every node with the weight and duration from the source to the start of the node.
+    // The nodes with a duration up to max_reached_duration are collected as well, unless it is
+    // INVALID_EDGE_WEIGHT. The result is stored in the thread local storage and valid until the
+    // next search.
+    const OneToAllLabels &Search(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                 const PhantomNode &source,
+                                 const EdgeWeight max_reached_duration = INVALID_EDGE_WEIGHT) const;
+
+  private:
+    void RelaxOutgoingEdges(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                            const NodeID node,
+                            const EdgeWeight weight,
+                            const EdgeWeight duration,
+                            QueryHeap &query_heap) const;
+};
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
+
+#endif
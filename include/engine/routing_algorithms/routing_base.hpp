@@ -69,7 +69,7 @@ class BasicRoutingInterface
     */
     void RoutingStep(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                      SearchEngineData::QueryHeap &forward_heap,
-                     SearchEngineData::QueryHeap &reverse_heap,
+                     const SearchEngineData::QueryHeap &reverse_heap,
                      NodeID &middle_node_id,
                      std::int32_t &upper_bound,
                      std::int32_t min_edge_offset,
@@ -405,6 +405,10 @@ class BasicRoutingInterface
                            const PhantomNode &source_phantom,
                            const PhantomNode &target_phantom) const;
 
+    double GetPhantomNodeOffset(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                const PhantomNode &phantom,
+                                const NodeID node) const;
+
     // Requires the heaps for be empty
     // If heaps should be adjusted to be initialized outside of this function,
     // the addition of force_loop parameters might be required
@@ -3,9 +3,13 @@
 
 #include <boost/thread/tss.hpp>
 
+#include "engine/map_matching/hidden_markov_model.hpp"
 #include "util/binary_heap.hpp"
 #include "util/typedefs.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -23,6 +27,16 @@ struct ManyToManyHeapData : HeapData
     ManyToManyHeapData(NodeID p, EdgeWeight duration) : HeapData(p), duration(duration) {}
 };
 
+// Per node labels of a one-to-all search, indexed by NodeID
+struct OneToAllLabels
+{
+    std::vector<EdgeWeight> weights;
+    std::vector<EdgeWeight> durations;
+    // Nodes within the duration bound of the search, each with a turn leaving it. The geometry
+    // index of the turn is the one of the node. A node can be listed more than once.
+    std::vector<std::pair<NodeID, EdgeID>> reached;
+};
+
 struct SearchEngineData
 {
     using QueryHeap = util::
@@ -37,6 +51,10 @@ struct SearchEngineData
 
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
 
+    using OneToAllLabelsPtr = boost::thread_specific_ptr<OneToAllLabels>;
+
+    using HiddenMarkovModelPtr = boost::thread_specific_ptr<map_matching::HiddenMarkovModel>;
+
     static SearchEngineHeapPtr forward_heap_1;
     static SearchEngineHeapPtr reverse_heap_1;
     static SearchEngineHeapPtr forward_heap_2;
@@ -44,6 +62,8 @@ struct SearchEngineData
     static SearchEngineHeapPtr forward_heap_3;
     static SearchEngineHeapPtr reverse_heap_3;
     static ManyToManyHeapPtr many_to_many_heap;
+    static OneToAllLabelsPtr one_to_all_labels;
+    static HiddenMarkovModelPtr hidden_markov_model;
 
     void InitializeOrClearFirstThreadLocalStorage(const unsigned number_of_nodes);
 
@@ -52,6 +72,11 @@ struct SearchEngineData
     void InitializeOrClearThirdThreadLocalStorage(const unsigned number_of_nodes);
 
     void InitializeOrClearManyToManyThreadLocalStorage(const unsigned number_of_nodes);
+
+    void InitializeOrClearOneToAllThreadLocalStorage(const unsigned number_of_nodes);
+
+    // the model is cleared when the next trace is loaded into it
+    void InitializeHiddenMarkovModelThreadLocalStorage();
 };
 }
 }
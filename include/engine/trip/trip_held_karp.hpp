@@ -0,0 +1,146 @@
+#ifndef TRIP_HELD_KARP_HPP
+#define TRIP_HELD_KARP_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+// Computes the optimal roundtrip with the Held-Karp dynamic program in O(2^n * n^2).
+//
+// The roundtrip starts at location 0. All other locations are numbered 0..n-2 and subsets of
+// them are bitmasks. `weights[subset * (n - 1) + k]` is the weight of the shortest path that
+// starts at k, visits all locations of the subset (which contains k) and returns to location 0.
+// Entries of locations that are not in the subset are infinite, so the minimum over the
+// candidates for the second location of a path is a branch free loop over two contiguous rows.
+//
+// Weights are summed up in 64 bit, so the INVALID_EDGE_WEIGHT entries of tables for trips with
+// fixed start and end are larger than any valid trip instead of overflowing. Of all optimal
+// roundtrips the lexicographically smallest one is returned.
+inline std::vector<NodeID> HeldKarpTrip(const std::size_t number_of_locations,
+                                        const util::DistTableWrapper<EdgeWeight> &dist_table)
+{
+    using Weight = std::int64_t;
+    const constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::max() / 4;
+
+    BOOST_ASSERT(number_of_locations > 0);
+    BOOST_ASSERT_MSG(number_of_locations * number_of_locations == dist_table.size(),
+                     "number_of_locations and dist_table size do not match");
+    BOOST_ASSERT_MSG(number_of_locations < 32, "too many locations for Held-Karp");
+
+    if (number_of_locations < 3)
+    {
+        std::vector<NodeID> route(number_of_locations);
+        std::iota(route.begin(), route.end(), 0);
+        return route;
+    }
+
+    const std::size_t number_of_others = number_of_locations - 1;
+    const std::uint32_t all_others = (1u << number_of_others) - 1;
+
+    // weights_between[k * number_of_others + i] is the weight from location k + 1 to i + 1
+    std::vector<Weight> weights_between(number_of_others * number_of_others);
+    for (std::size_t from = 0; from < number_of_others; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_others; ++to)
+        {
+            weights_between[from * number_of_others + to] =
+                from == to ? INFINITE_WEIGHT : dist_table(from + 1, to + 1);
+        }
+    }
+
+    std::vector<Weight> weights((static_cast<std::size_t>(all_others) + 1) * number_of_others,
+                                INFINITE_WEIGHT);
+    const auto row = [&](const std::uint32_t subset) {
+        return weights.data() + subset * number_of_others;
+    };
+
+    for (std::uint32_t subset = 1; subset <= all_others; ++subset)
+    {
+        auto subset_row = row(subset);
+        for (std::size_t first = 0; first < number_of_others; ++first)
+        {
+            const std::uint32_t first_bit = 1u << first;
+            if ((subset & first_bit) == 0)
+            {
+                continue;
+            }
+
+            const auto rest = subset ^ first_bit;
+            if (rest == 0)
+            {
+                subset_row[first] = dist_table(first + 1, 0);
+                continue;
+            }
+
+            const auto rest_row = row(rest);
+            const auto first_weights = weights_between.data() + first * number_of_others;
+            Weight best = INFINITE_WEIGHT;
+            for (std::size_t second = 0; second < number_of_others; ++second)
+            {
+                best = std::min(best, first_weights[second] + rest_row[second]);
+            }
+            subset_row[first] = best;
+        }
+    }
+
+    // follow the optimal weights from location 0, preferring the smallest next location
+    std::vector<NodeID> route;
+    route.reserve(number_of_locations);
+    route.push_back(0);
+
+    std::uint32_t remaining = all_others;
+    Weight remaining_weight = INFINITE_WEIGHT;
+    for (std::size_t next = 0; next < number_of_others; ++next)
+    {
+        remaining_weight =
+            std::min(remaining_weight, Weight{dist_table(0, next + 1)} + row(remaining)[next]);
+    }
+
+    while (remaining != 0)
+    {
+        const NodeID current = route.back();
+        for (std::size_t next = 0; next < number_of_others; ++next)
+        {
+            if ((remaining & (1u << next)) == 0)
+            {
+                continue;
+            }
+            const Weight step_weight = dist_table(current, next + 1);
+            const auto path_weight = row(remaining)[next];
+            if (step_weight + path_weight == remaining_weight)
+            {
+                route.push_back(next + 1);
+                remaining ^= 1u << next;
+                remaining_weight = path_weight;
+                break;
+            }
+        }
+        BOOST_ASSERT_MSG(route.size() + std::bitset<32>(remaining).count() ==
+                             number_of_locations,
+                         "no optimal successor found");
+    }
+
+    return route;
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_HELD_KARP_HPP
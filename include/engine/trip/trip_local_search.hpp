@@ -0,0 +1,258 @@
+#ifndef TRIP_LOCAL_SEARCH_HPP
+#define TRIP_LOCAL_SEARCH_HPP
+
+#include "engine/parallel_restarts.hpp"
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+// Tables of trips with fixed start and end contain INVALID_EDGE_WEIGHT entries that must never
+// be chosen, summing them up in 64 bit keeps them larger than any valid trip.
+using TripWeight = std::int64_t;
+
+// computes the weight of the roundtrip visiting the locations in the order of the route
+inline TripWeight GetTripWeight(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                const std::vector<NodeID> &route)
+{
+    TripWeight weight = 0;
+    for (std::size_t index = 0; index < route.size(); ++index)
+    {
+        weight += dist_table(route[index], route[(index + 1) % route.size()]);
+    }
+    return weight;
+}
+
+// Improves the route by replacing two edges (a, b) and (c, d) by (a, c) and (b, d), which
+// reverses the locations between them. Since the table is not symmetric, the weight of the
+// reversed part is looked up in prefix sums of both traversal directions of the route.
+// The first improving reversal is applied and the scan restarts, until no pair of edges can be
+// exchanged for less. Returns if any part of the route was reversed.
+inline bool TwoOpt(const util::DistTableWrapper<EdgeWeight> &dist_table, std::vector<NodeID> &route)
+{
+    const auto number_of_locations = route.size();
+    if (number_of_locations < 4)
+    {
+        return false;
+    }
+
+    std::vector<TripWeight> forward_prefix(number_of_locations);
+    std::vector<TripWeight> backward_prefix(number_of_locations);
+    const auto update_prefixes = [&] {
+        for (std::size_t index = 1; index < number_of_locations; ++index)
+        {
+            forward_prefix[index] =
+                forward_prefix[index - 1] + dist_table(route[index - 1], route[index]);
+            backward_prefix[index] =
+                backward_prefix[index - 1] + dist_table(route[index], route[index - 1]);
+        }
+    };
+    update_prefixes();
+
+    bool changed = false;
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        for (std::size_t first = 0; first + 2 < number_of_locations && !improved; ++first)
+        {
+            const auto a = route[first];
+            const auto b = route[first + 1];
+            // (a, b) and the last edge of the route are adjacent if the route starts at a
+            const auto last = first == 0 ? number_of_locations - 1 : number_of_locations;
+            for (std::size_t second = first + 2; second < last; ++second)
+            {
+                const auto c = route[second];
+                const auto d = route[(second + 1) % number_of_locations];
+
+                const TripWeight removed = TripWeight{dist_table(a, b)} + dist_table(c, d) +
+                                           forward_prefix[second] - forward_prefix[first + 1];
+                const TripWeight added = TripWeight{dist_table(a, c)} + dist_table(b, d) +
+                                         backward_prefix[second] - backward_prefix[first + 1];
+                if (added < removed)
+                {
+                    std::reverse(route.begin() + first + 1, route.begin() + second + 1);
+                    update_prefixes();
+                    improved = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// Improves the route by moving a chain of up to three consecutive locations to a different
+// place in the route, keeping its direction. A chain moves if inserting it between two other
+// locations costs less than removing it saves, shorter chains are tried first. Returns if any
+// chain was moved.
+inline bool OrOpt(const util::DistTableWrapper<EdgeWeight> &dist_table, std::vector<NodeID> &route)
+{
+    const constexpr std::size_t MAX_CHAIN_LENGTH = 3;
+    const auto number_of_locations = route.size();
+    if (number_of_locations < 4)
+    {
+        return false;
+    }
+
+    const auto at = [&](const std::size_t index) { return route[index % number_of_locations]; };
+
+    bool changed = false;
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        for (std::size_t length = 1; length <= MAX_CHAIN_LENGTH && !improved; ++length)
+        {
+            if (length + 2 > number_of_locations)
+            {
+                break;
+            }
+            for (std::size_t begin = 0; begin < number_of_locations && !improved; ++begin)
+            {
+                // chain route[begin], ..., route[begin + length - 1] between prev and next
+                const auto prev = at(begin + number_of_locations - 1);
+                const auto chain_first = at(begin);
+                const auto chain_last = at(begin + length - 1);
+                const auto next = at(begin + length);
+
+                const TripWeight removal_gain = TripWeight{dist_table(prev, chain_first)} +
+                                                dist_table(chain_last, next) -
+                                                dist_table(prev, next);
+
+                // insert between the edges (p, q) of the route without the chain
+                for (std::size_t offset = 0; offset + length + 1 < number_of_locations; ++offset)
+                {
+                    const auto p = at(begin + length + offset);
+                    const auto q = at(begin + length + offset + 1);
+                    const TripWeight insertion_cost = TripWeight{dist_table(p, chain_first)} +
+                                                      dist_table(chain_last, q) -
+                                                      dist_table(p, q);
+                    if (insertion_cost < removal_gain)
+                    {
+                        std::vector<NodeID> moved;
+                        moved.reserve(number_of_locations);
+                        for (std::size_t index = 0; index <= offset; ++index)
+                        {
+                            moved.push_back(at(begin + length + index));
+                        }
+                        for (std::size_t index = 0; index < length; ++index)
+                        {
+                            moved.push_back(at(begin + index));
+                        }
+                        for (std::size_t index = begin + length + offset + 1;
+                             moved.size() < number_of_locations;
+                             ++index)
+                        {
+                            moved.push_back(at(index));
+                        }
+                        route = std::move(moved);
+                        improved = true;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// applies 2-opt and Or-opt moves until the route is a local optimum for both
+inline void ImproveTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                        std::vector<NodeID> &route)
+{
+    TwoOpt(dist_table, route);
+    // each move type leaves a local optimum for itself, so stop once one of them does not move
+    while (OrOpt(dist_table, route) && TwoOpt(dist_table, route))
+    {
+    }
+}
+
+// Reconnects four random parts A B C D of the route to A C B D. The move can not be undone by a
+// single 2-opt or Or-opt move, so the local search continues from a different local optimum.
+template <typename RandomGenerator>
+void DoubleBridge(std::vector<NodeID> &route, RandomGenerator &generator)
+{
+    BOOST_ASSERT(route.size() >= 8);
+    std::uniform_int_distribution<std::size_t> distribution(1, route.size() - 1);
+    std::size_t cuts[3];
+    do
+    {
+        for (auto &cut : cuts)
+        {
+            cut = distribution(generator);
+        }
+        std::sort(std::begin(cuts), std::end(cuts));
+    } while (cuts[0] == cuts[1] || cuts[1] == cuts[2]);
+
+    std::rotate(route.begin() + cuts[0], route.begin() + cuts[1], route.begin() + cuts[2]);
+}
+
+// Computes the route with farthest insertion and improves it with 2-opt and Or-opt moves.
+//
+// If a search time is given, the local search is restarted in parallel until the time is up or
+// the restarts stop finding shorter routes. Each restart repeatedly applies a random double
+// bridge move to its best route and keeps the new local optimum if it is shorter. The shortest
+// route of all restarts is returned.
+//
+// Restarts never begin with farthest insertion from random locations: tables of trips with a
+// fixed start and end do not allow inserting locations into every initial roundtrip.
+inline std::vector<NodeID> LocalSearchTrip(const std::size_t number_of_locations,
+                                           const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                           const std::chrono::milliseconds search_time)
+{
+    const auto deadline = std::chrono::steady_clock::now() + search_time;
+
+    auto best_route = FarthestInsertionTrip(number_of_locations, dist_table);
+    ImproveTrip(dist_table, best_route);
+
+    // double bridge moves need four non-empty parts
+    if (search_time.count() <= 0 || number_of_locations < 8)
+    {
+        return best_route;
+    }
+
+    // small trips reach their best route long before the time is up
+    runParallelRestarts(
+        best_route,
+        deadline,
+        number_of_locations,
+        [&](const std::size_t restart, std::vector<NodeID> &route, std::mt19937 &generator) {
+            // all but one restart begin at a different local optimum
+            if (restart > 0)
+            {
+                DoubleBridge(route, generator);
+                ImproveTrip(dist_table, route);
+            }
+        },
+        [&](std::vector<NodeID> &route, std::mt19937 &generator) {
+            DoubleBridge(route, generator);
+            ImproveTrip(dist_table, route);
+        },
+        [&](const std::vector<NodeID> &route) { return GetTripWeight(dist_table, route); });
+
+    return best_route;
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_LOCAL_SEARCH_HPP
@@ -0,0 +1,77 @@
+#ifndef ENGINE_UNPACKING_CACHE_HPP
+#define ENGINE_UNPACKING_CACHE_HPP
+
+#include "util/typedefs.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Bounded least-recently-used cache of unpacked CH shortcuts.
+//
+// Maps a shortcut (its edge id and the direction it was traversed in) to the sequence of
+// original edges it expands to. The cache is split into independently locked shards so that
+// concurrent requests rarely contend. The capacity counts original edges, not shortcuts, to
+// bound the memory use independent of how long the cached shortcuts are.
+class UnpackingCache
+{
+  public:
+    struct UnpackedEdge
+    {
+        NodeID from;
+        NodeID to;
+        EdgeID edge;
+    };
+    using UnpackedEdges = std::vector<UnpackedEdge>;
+    using UnpackedEdgesPtr = std::shared_ptr<const UnpackedEdges>;
+
+    explicit UnpackingCache(const std::size_t capacity);
+
+    // Returns nullptr if the shortcut is not cached
+    UnpackedEdgesPtr Find(const EdgeID shortcut, const bool reversed);
+
+    void Insert(const EdgeID shortcut, const bool reversed, UnpackedEdgesPtr unpacked_edges);
+
+    std::size_t GetCapacity() const { return shard_capacity * NUM_SHARDS; }
+
+  private:
+    static const constexpr std::size_t NUM_SHARDS = 16;
+
+    using Key = std::uint64_t;
+    using Entries = std::list<std::pair<Key, UnpackedEdgesPtr>>;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        // most recently used entry first
+        Entries entries;
+        std::unordered_map<Key, Entries::iterator> index;
+        // number of cached original edges
+        std::size_t size = 0;
+    };
+
+    static Key MakeKey(const EdgeID shortcut, const bool reversed)
+    {
+        return (static_cast<Key>(shortcut) << 1) | static_cast<Key>(reversed);
+    }
+
+    Shard &GetShard(const Key key) { return shards[key % NUM_SHARDS]; }
+
+    std::size_t shard_capacity;
+    std::array<Shard, NUM_SHARDS> shards;
+};
+}
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ENGINE_VEHICLE_ROUTING_HPP
+#define ENGINE_VEHICLE_ROUTING_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Vehicles that start and end at a depot and serve the locations of a duration table.
+//
+// All durations and times are in the unit of the table (deciseconds). Vehicles depart at the
+// beginning of the time window of the depot. Locations without demand or time window use the
+// defaults.
+struct VehicleRoutingProblem
+{
+    struct TimeWindow
+    {
+        EdgeWeight begin = 0;
+        EdgeWeight end = std::numeric_limits<EdgeWeight>::max();
+    };
+
+    VehicleRoutingProblem(util::DistTableWrapper<EdgeWeight> durations_,
+                          const std::size_t depot_,
+                          std::vector<unsigned> capacities_)
+        : durations(std::move(durations_)), depot(depot_), capacities(std::move(capacities_)),
+          demands(durations.GetNumberOfNodes(), 0),
+          time_windows(durations.GetNumberOfNodes()),
+          service_times(durations.GetNumberOfNodes(), 0)
+    {
+    }
+
+    std::size_t GetNumberOfLocations() const { return durations.GetNumberOfNodes(); }
+    std::size_t GetNumberOfVehicles() const { return capacities.size(); }
+
+    util::DistTableWrapper<EdgeWeight> durations;
+    std::size_t depot;
+    // per vehicle
+    std::vector<unsigned> capacities;
+    // per location, the time window of the depot limits the return of the vehicles
+    std::vector<unsigned> demands;
+    std::vector<TimeWindow> time_windows;
+    std::vector<EdgeWeight> service_times;
+};
+
+struct VehicleRoutingSolution
+{
+    // locations served by each vehicle in order, without the depot
+    std::vector<std::vector<NodeID>> routes;
+    // arrival time at each location, INVALID_EDGE_WEIGHT if it is not served
+    std::vector<EdgeWeight> arrivals;
+    std::vector<NodeID> unassigned;
+    // total duration of all routes, including waiting times
+    std::int64_t duration = 0;
+};
+
+// Solves the problem by ruin and recreate.
+//
+// An initial solution inserts every location at its cheapest feasible position, or at the first
+// feasible one once the search time is up. Each iteration removes a random location together
+// with its closest neighbours and reinserts them in random order, keeping the result if it serves
+// more locations or takes less time. The search runs in parallel from different random seeds
+// until the search time is up or it stops improving. Locations that can not be served by any
+// vehicle are unassigned.
+VehicleRoutingSolution solveVehicleRouting(const VehicleRoutingProblem &problem,
+                                           const std::chrono::milliseconds search_time);
+}
+}
+
+#endif
@@ -22,6 +22,7 @@ struct EdgeBasedEdge
                   const NodeID edge_id,
                   const EdgeWeight weight,
                   const EdgeWeight duration,
+                  const EdgeDistance distance,
                   const bool forward,
                   const bool backward);
 
@@ -34,8 +35,10 @@ struct EdgeBasedEdge
     EdgeWeight duration : 30;
     std::uint32_t forward : 1;
     std::uint32_t backward : 1;
+    // length of the source edge based node
+    EdgeDistance distance;
 };
-static_assert(sizeof(extractor::EdgeBasedEdge) == 20,
+static_assert(sizeof(extractor::EdgeBasedEdge) == 24,
               "Size of extractor::EdgeBasedEdge type is "
               "bigger than expected. This will influence "
               "memory consumption.");
@@ -43,7 +46,8 @@ static_assert(sizeof(extractor::EdgeBasedEdge) == 20,
 // Impl.
 
 inline EdgeBasedEdge::EdgeBasedEdge()
-    : source(0), target(0), edge_id(0), weight(0), duration(0), forward(false), backward(false)
+    : source(0), target(0), edge_id(0), weight(0), duration(0), forward(false), backward(false),
+      distance(0)
 {
 }
 
@@ -52,10 +56,11 @@ inline EdgeBasedEdge::EdgeBasedEdge(const NodeID source,
                                     const NodeID edge_id,
                                     const EdgeWeight weight,
                                     const EdgeWeight duration,
+                                    const EdgeDistance distance,
                                     const bool forward,
                                     const bool backward)
     : source(source), target(target), edge_id(edge_id), weight(weight), duration(duration),
-      forward(forward), backward(backward)
+      forward(forward), backward(backward), distance(distance)
 {
 }
 
@@ -44,6 +44,8 @@ using engine::api::NearestParameters;
 using engine::api::TripParameters;
 using engine::api::MatchParameters;
 using engine::api::TileParameters;
+using engine::api::IsochroneParameters;
+using engine::api::OptimizeParameters;
 
 /**
  * Represents a Open Source Routing Machine with access to its services.
@@ -56,6 +58,8 @@ using engine::api::TileParameters;
  *  - Trip: shortest round trip between coordinates
  *  - Match: snaps noisy coordinate traces to the road network
  *  - Tile: vector tiles with internal graph representation
+ *  - Isochrone: polygons of the area reachable within travel times
+ *  - Optimize: routes of several vehicles serving coordinates from a depot
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
  */
@@ -130,6 +134,24 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * Isochrone: polygons of the area reachable within travel times
+     *
+     * \param parameters isochrone query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, IsochroneParameters and json::Object
+     */
+    Status Isochrone(const IsochroneParameters &parameters, json::Object &result) const;
+
+    /**
+     * Optimize: routes of several vehicles serving coordinates from a depot
+     *
+     * \param parameters optimize query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, OptimizeParameters and json::Object
+     */
+    Status Optimize(const OptimizeParameters &parameters, json::Object &result) const;
+
   private:
     std::unique_ptr<engine::Engine> engine_;
 };
@@ -52,6 +52,8 @@ struct NearestParameters;
 struct TripParameters;
 struct MatchParameters;
 struct TileParameters;
+struct IsochroneParameters;
+struct OptimizeParameters;
 } // ns api
 
 class Engine;
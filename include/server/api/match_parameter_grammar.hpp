@@ -33,13 +33,25 @@ struct MatchParametersGrammar final : public RouteParametersGrammar<Iterator, Si
             (qi::uint_ %
              ';')[ph::bind(&engine::api::MatchParameters::timestamps, qi::_r1) = qi::_1];
 
+        session_char = qi::char_("a-zA-Z0-9_-");
+        session_rule =
+            (qi::lit("session=") >
+             qi::as_string[+session_char]
+                          [ph::bind(&engine::api::MatchParameters::session, qi::_r1) = qi::_1]) |
+            (qi::lit("finish=") >
+             qi::bool_[ph::bind(&engine::api::MatchParameters::finish, qi::_r1) = qi::_1]);
+
         root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
-                    -('?' > (timestamps_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
+                    -('?' > (timestamps_rule(qi::_r1) | session_rule(qi::_r1) |
+                             BaseGrammar::base_rule(qi::_r1)) %
+                                '&');
     }
 
   private:
     qi::rule<Iterator, Signature> root_rule;
     qi::rule<Iterator, Signature> timestamps_rule;
+    qi::rule<Iterator, Signature> session_rule;
+    qi::rule<Iterator, char()> session_char;
 };
 }
 }
@@ -0,0 +1,91 @@
+#ifndef OPTIMIZE_PARAMETERS_GRAMMAR_HPP
+#define OPTIMIZE_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/route_parameters_grammar.hpp"
+#include "engine/api/optimize_parameters.hpp"
+
+#include <boost/spirit/include/phoenix.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+namespace
+{
+namespace ph = boost::phoenix;
+namespace qi = boost::spirit::qi;
+}
+
+template <typename Iterator = std::string::iterator,
+          typename Signature = void(engine::api::OptimizeParameters &)>
+struct OptimizeParametersGrammar final : public RouteParametersGrammar<Iterator, Signature>
+{
+    using BaseGrammar = RouteParametersGrammar<Iterator, Signature>;
+
+    OptimizeParametersGrammar() : BaseGrammar(root_rule)
+    {
+        const auto add_time_window =
+            [](engine::api::OptimizeParameters &parameters,
+               boost::optional<boost::fusion::vector2<unsigned, unsigned>> time_window) {
+                boost::optional<engine::api::OptimizeParameters::TimeWindow> window;
+                if (time_window)
+                {
+                    window = engine::api::OptimizeParameters::TimeWindow{
+                        boost::fusion::at_c<0>(*time_window), boost::fusion::at_c<1>(*time_window)};
+                }
+                parameters.time_windows.push_back(std::move(window));
+            };
+
+        depot_rule =
+            qi::lit("depot=") >
+            qi::uint_[ph::bind(&engine::api::OptimizeParameters::depot, qi::_r1) = qi::_1];
+
+        vehicles_rule =
+            qi::lit("vehicles=") >
+            qi::uint_[ph::bind(&engine::api::OptimizeParameters::vehicles, qi::_r1) = qi::_1];
+
+        capacities_rule =
+            qi::lit("capacities=") >
+            (qi::uint_ %
+             ';')[ph::bind(&engine::api::OptimizeParameters::capacities, qi::_r1) = qi::_1];
+
+        demands_rule =
+            qi::lit("demands=") >
+            (qi::uint_ %
+             ';')[ph::bind(&engine::api::OptimizeParameters::demands, qi::_r1) = qi::_1];
+
+        time_windows_rule =
+            qi::lit("time_windows=") >
+            (-(qi::uint_ > ',' > qi::uint_))[ph::bind(add_time_window, qi::_r1, qi::_1)] % ';';
+
+        service_times_rule =
+            qi::lit("service_times=") >
+            (qi::uint_ %
+             ';')[ph::bind(&engine::api::OptimizeParameters::service_times, qi::_r1) = qi::_1];
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+                    -('?' > (depot_rule(qi::_r1) | vehicles_rule(qi::_r1) |
+                             capacities_rule(qi::_r1) | demands_rule(qi::_r1) |
+                             time_windows_rule(qi::_r1) | service_times_rule(qi::_r1) |
+                             BaseGrammar::base_rule(qi::_r1)) %
+                                '&');
+    }
+
+  private:
+    qi::rule<Iterator, Signature> depot_rule;
+    qi::rule<Iterator, Signature> vehicles_rule;
+    qi::rule<Iterator, Signature> capacities_rule;
+    qi::rule<Iterator, Signature> demands_rule;
+    qi::rule<Iterator, Signature> time_windows_rule;
+    qi::rule<Iterator, Signature> service_times_rule;
+    qi::rule<Iterator, Signature> root_rule;
+};
+}
+}
+}
+
+#endif
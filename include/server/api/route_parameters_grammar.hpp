@@ -28,9 +28,17 @@ struct RouteParametersGrammar : public BaseParametersGrammar<Iterator, Signature
 
     RouteParametersGrammar() : RouteParametersGrammar(root_rule)
     {
+        const auto set_number_of_alternatives = [](engine::api::RouteParameters &route_parameters,
+                                                   const unsigned number_of_alternatives) {
+            route_parameters.alternatives = number_of_alternatives > 0;
+            route_parameters.number_of_alternatives = number_of_alternatives;
+        };
+
+        // alternatives=true|false is a shorthand for a single or no alternative
         route_rule =
             (qi::lit("alternatives=") >
-             qi::bool_[ph::bind(&engine::api::RouteParameters::alternatives, qi::_r1) = qi::_1]) |
+             (qi::uint_[ph::bind(set_number_of_alternatives, qi::_r1, qi::_1)] |
+              qi::bool_[ph::bind(set_number_of_alternatives, qi::_r1, qi::_1)])) |
             (qi::lit("continue_straight=") >
              (qi::lit("default") |
               qi::bool_[ph::bind(&engine::api::RouteParameters::continue_straight, qi::_r1) =
@@ -15,6 +15,8 @@ namespace http
 struct request
 {
     std::string uri;
+    // the body of POST requests is appended to the path of the uri
+    std::string body;
     std::string referrer;
     std::string agent;
     boost::asio::ip::address endpoint;
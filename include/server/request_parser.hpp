@@ -4,6 +4,8 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
+#include <string>
 #include <tuple>
 
 namespace osrm
@@ -64,11 +66,14 @@ class RequestParser
         space_before_header_value,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        body
     } state;
 
+    std::string method;
     http::header current_header;
     http::compression_type selected_compression;
+    std::size_t content_length;
 };
 }
 }
@@ -7,6 +7,7 @@
 
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/numa.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
@@ -33,17 +34,24 @@ class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                bool pin_threads = false)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        return std::make_shared<Server>(ip_address, ip_port, real_num_threads, pin_threads);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_service),
+    // With pin_threads the threads are distributed over the NUMA nodes and only run on the
+    // CPUs of their node
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned thread_pool_size,
+                    const bool pin_threads = false)
+        : thread_pool_size(thread_pool_size), pin_threads(pin_threads), acceptor(io_service),
           new_connection(std::make_shared<Connection>(io_service, request_handler))
     {
         const auto port_string = std::to_string(port);
@@ -70,11 +78,25 @@ class Server
 
     void Run()
     {
+        std::vector<unsigned> nodes;
+        for (const auto node : util::irange(0u, util::numa::GetNumberOfNodes()))
+        {
+            if (util::numa::IsNodeOnline(node))
+            {
+                nodes.push_back(node);
+            }
+        }
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
-            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-                boost::bind(&boost::asio::io_service::run, &io_service));
+            const auto node = nodes[i % nodes.size()];
+            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>([this, node] {
+                if (pin_threads && !util::numa::RunOnNode(node))
+                {
+                    util::Log(logWARNING) << "Could not pin a thread to NUMA node " << node;
+                }
+                io_service.run();
+            });
             threads.push_back(thread);
         }
         for (auto thread : threads)
@@ -104,6 +126,7 @@ class Server
     }
 
     unsigned thread_pool_size;
+    bool pin_threads;
     boost::asio::io_service io_service;
     boost::asio::ip::tcp::acceptor acceptor;
     std::shared_ptr<Connection> new_connection;
@@ -0,0 +1,142 @@
+#ifndef OSRM_STORAGE_CONTAINER_HPP_
+#define OSRM_STORAGE_CONTAINER_HPP_
+
+#include "storage/io.hpp"
+#include "storage/shared_datatype.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/crc.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace storage
+{
+
+// A container file holds all data of a dataset. The fingerprint is followed by a header, the
+// DataLayout and a table of contents with an entry per block. The memory block starts at a page
+// aligned offset and holds the groups of blocks one after the other. Every block is page aligned,
+// so it can be loaded on its own or the whole container can be mapped without copying.
+const constexpr std::uint32_t CONTAINER_VERSION = 3;
+const constexpr std::size_t CONTAINER_ALIGNMENT = 4096;
+
+struct ContainerHeader
+{
+    std::uint32_t version;
+    std::uint32_t number_of_blocks;
+    // of the version, the number of blocks, the layout and the table of contents
+    std::uint32_t checksum;
+    std::uint32_t unused;
+};
+
+struct ContainerBlock
+{
+    // from the start of the file
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t checksum;
+    std::uint32_t unused;
+};
+
+using ContainerTOC = std::array<ContainerBlock, DataLayout::NUM_BLOCKS>;
+
+const constexpr std::size_t CONTAINER_DATA_OFFSET =
+    (sizeof(util::FingerPrint) + sizeof(ContainerHeader) + sizeof(DataLayout) +
+     sizeof(ContainerTOC) + CONTAINER_ALIGNMENT - 1) /
+    CONTAINER_ALIGNMENT * CONTAINER_ALIGNMENT;
+
+inline std::uint32_t getBlockChecksum(const char *data, const std::size_t size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+inline std::uint32_t getContainerChecksum(const ContainerHeader &header,
+                                          const DataLayout &layout,
+                                          const ContainerTOC &toc)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(&header.version, sizeof(header.version));
+    crc.process_bytes(&header.number_of_blocks, sizeof(header.number_of_blocks));
+    crc.process_bytes(&layout, sizeof(layout));
+    crc.process_bytes(toc.data(), sizeof(toc));
+    return crc.checksum();
+}
+
+// Offset of a block in the file as computed from the layout. The memory block starts at a page
+// aligned offset, so the blocks are aligned like in any page aligned memory.
+inline std::uint64_t getContainerBlockOffset(const DataLayout &layout,
+                                             const DataLayout::BlockID bid)
+{
+    const auto base = reinterpret_cast<char *>(CONTAINER_ALIGNMENT);
+    const auto block = static_cast<char *>(layout.GetAlignedBlockPtr(base, bid));
+    return CONTAINER_DATA_OFFSET + static_cast<std::uint64_t>(block - base);
+}
+
+// Writes everything up to the memory block after the fingerprint
+inline void writeContainerHeader(io::FileWriter &container_file,
+                                 const DataLayout &layout,
+                                 const ContainerTOC &toc)
+{
+    ContainerHeader header{CONTAINER_VERSION, DataLayout::NUM_BLOCKS, 0, 0};
+    header.checksum = getContainerChecksum(header, layout, toc);
+    container_file.WriteOne(header);
+    container_file.WriteOne(layout);
+    container_file.WriteFrom(toc.data(), toc.size());
+    const std::vector<char> padding(CONTAINER_DATA_OFFSET - sizeof(util::FingerPrint) -
+                                        sizeof(ContainerHeader) - sizeof(layout) - sizeof(toc),
+                                    0);
+    container_file.WriteFrom(padding.data(), padding.size());
+}
+
+// Reads everything up to the memory block, the fingerprint needs to be verified already. Throws
+// if the header is corrupted or the table of contents does not match the layout, because all
+// readers use the layout to find the blocks.
+inline void
+readContainerHeader(io::FileReader &container_file, DataLayout &layout, ContainerTOC &toc)
+{
+    const auto header = container_file.ReadOne<ContainerHeader>();
+    if (header.version != CONTAINER_VERSION)
+    {
+        throw util::exception("Container version " + std::to_string(header.version) +
+                              " is not supported, expected " +
+                              std::to_string(CONTAINER_VERSION) + SOURCE_REF);
+    }
+    if (header.number_of_blocks != DataLayout::NUM_BLOCKS)
+    {
+        throw util::exception("Container has " + std::to_string(header.number_of_blocks) +
+                              " blocks, expected " + std::to_string(DataLayout::NUM_BLOCKS) +
+                              SOURCE_REF);
+    }
+
+    container_file.ReadInto(layout);
+    container_file.ReadInto(toc.data(), toc.size());
+    if (header.checksum != getContainerChecksum(header, layout, toc))
+    {
+        throw util::exception("Checksum mismatch of the container header" + SOURCE_REF);
+    }
+
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(block);
+        if (toc[block].size != layout.GetBlockSize(bid) ||
+            toc[block].offset != getContainerBlockOffset(layout, bid))
+        {
+            throw util::exception("Block " + std::string(block_id_to_name[bid]) +
+                                  " of the container does not match its layout" + SOURCE_REF);
+        }
+    }
+}
+}
+}
+
+#endif
@@ -10,6 +10,10 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/seek.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 #include <type_traits>
@@ -102,6 +106,34 @@ class FileReader
         }
     }
 
+    /* Read count objects of type T into pointer dest in chunks that are read concurrently
+       through their own file handles, so large blocks are not limited by a single reader */
+    template <typename T> void ReadIntoParallel(T *dest, const std::size_t count)
+    {
+        const constexpr std::size_t CHUNK_SIZE = 64 * 1024 * 1024;
+        const std::size_t objects_per_chunk = std::max<std::size_t>(1, CHUNK_SIZE / sizeof(T));
+        if (count <= objects_per_chunk)
+        {
+            ReadInto(dest, count);
+            return;
+        }
+
+        const boost::filesystem::ifstream::pos_type position = input_stream.tellg();
+        if (position == boost::filesystem::ifstream::pos_type(-1))
+        {
+            throw util::exception("Error reading from " + filepath.string() + " " + SOURCE_REF);
+        }
+
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, objects_per_chunk),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              const std::streamoff offset = range.begin() * sizeof(T);
+                              FileReader chunk_reader(filepath, HasNoFingerprint);
+                              chunk_reader.input_stream.seekg(position + offset);
+                              chunk_reader.ReadInto(dest + range.begin(), range.size());
+                          });
+        Skip<T>(count);
+    }
+
     template <typename T> void ReadInto(std::vector<T> &target)
     {
         ReadInto(target.data(), target.size());
@@ -14,10 +14,12 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/seek.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace osrm
 {
@@ -26,6 +28,9 @@ namespace storage
 namespace serialization
 {
 
+// Number of records that are read at once from files that are not copied as a whole
+const constexpr std::uint64_t READ_BATCH_SIZE = 64 * 1024;
+
 // To make function calls consistent, this function returns the fixed number of properties
 inline std::size_t readPropertiesCount() { return 1; }
 
@@ -66,8 +71,8 @@ inline void readHSGR(io::FileReader &input_file,
 {
     BOOST_ASSERT(node_buffer);
     BOOST_ASSERT(edge_buffer);
-    input_file.ReadInto(node_buffer, number_of_nodes);
-    input_file.ReadInto(edge_buffer, number_of_edges);
+    input_file.ReadIntoParallel(node_buffer, number_of_nodes);
+    input_file.ReadIntoParallel(edge_buffer, number_of_edges);
 }
 
 // Loads datasource_indexes from .datasource_indexes into memory
@@ -100,19 +105,27 @@ inline void readEdges(io::FileReader &edges_input_file,
     BOOST_ASSERT(lane_data_id_list);
     BOOST_ASSERT(travel_mode_list);
     BOOST_ASSERT(entry_class_id_list);
-    extractor::OriginalEdgeData current_edge_data;
-    for (std::uint64_t i = 0; i < number_of_edges; ++i)
+    // edges are read in batches, a read per edge is slow for large files
+    std::vector<extractor::OriginalEdgeData> batch;
+    for (std::uint64_t batch_begin = 0; batch_begin < number_of_edges;
+         batch_begin += READ_BATCH_SIZE)
     {
-        edges_input_file.ReadInto(current_edge_data);
-
-        geometry_list[i] = current_edge_data.via_geometry;
-        name_id_list[i] = current_edge_data.name_id;
-        turn_instruction_list[i] = current_edge_data.turn_instruction;
-        lane_data_id_list[i] = current_edge_data.lane_data_id;
-        travel_mode_list[i] = current_edge_data.travel_mode;
-        entry_class_id_list[i] = current_edge_data.entry_classid;
-        pre_turn_bearing_list[i] = current_edge_data.pre_turn_bearing;
-        post_turn_bearing_list[i] = current_edge_data.post_turn_bearing;
+        batch.resize(std::min<std::uint64_t>(READ_BATCH_SIZE, number_of_edges - batch_begin));
+        edges_input_file.ReadInto(batch);
+
+        for (std::size_t j = 0; j < batch.size(); ++j)
+        {
+            const auto &current_edge_data = batch[j];
+            const auto i = batch_begin + j;
+            geometry_list[i] = current_edge_data.via_geometry;
+            name_id_list[i] = current_edge_data.name_id;
+            turn_instruction_list[i] = current_edge_data.turn_instruction;
+            lane_data_id_list[i] = current_edge_data.lane_data_id;
+            travel_mode_list[i] = current_edge_data.travel_mode;
+            entry_class_id_list[i] = current_edge_data.entry_classid;
+            pre_turn_bearing_list[i] = current_edge_data.pre_turn_bearing;
+            post_turn_bearing_list[i] = current_edge_data.post_turn_bearing;
+        }
     }
 }
 
@@ -125,13 +138,22 @@ void readNodes(io::FileReader &nodes_file,
                const std::uint64_t number_of_coordinates)
 {
     BOOST_ASSERT(coordinate_list);
-    extractor::QueryNode current_node;
-    for (std::uint64_t i = 0; i < number_of_coordinates; ++i)
+    std::vector<extractor::QueryNode> batch;
+    for (std::uint64_t batch_begin = 0; batch_begin < number_of_coordinates;
+         batch_begin += READ_BATCH_SIZE)
     {
-        nodes_file.ReadInto(current_node);
-        coordinate_list[i] = util::Coordinate(current_node.lon, current_node.lat);
-        osmnodeid_list.push_back(current_node.node_id);
-        BOOST_ASSERT(coordinate_list[i].IsValid());
+        batch.resize(
+            std::min<std::uint64_t>(READ_BATCH_SIZE, number_of_coordinates - batch_begin));
+        nodes_file.ReadInto(batch);
+
+        for (std::size_t j = 0; j < batch.size(); ++j)
+        {
+            const auto &current_node = batch[j];
+            const auto i = batch_begin + j;
+            coordinate_list[i] = util::Coordinate(current_node.lon, current_node.lat);
+            osmnodeid_list.push_back(current_node.node_id);
+            BOOST_ASSERT(coordinate_list[i].IsValid());
+        }
     }
 }
 
@@ -56,7 +56,11 @@ const constexpr char *block_id_to_name[] = {"NAME_CHAR_DATA",
                                             "LANE_DESCRIPTION_OFFSETS",
                                             "LANE_DESCRIPTION_MASKS",
                                             "TURN_WEIGHT_PENALTIES",
-                                            "TURN_DURATION_PENALTIES"};
+                                            "TURN_DURATION_PENALTIES",
+                                            "NODE_LEVEL_ORDER",
+                                            "SHORTCUT_CHILDREN_BLOCKS",
+                                            "SHORTCUT_CHILDREN",
+                                            "R_SEARCH_TREE_LEAVES"};
 
 struct DataLayout
 {
@@ -101,15 +105,59 @@ struct DataLayout
         LANE_DESCRIPTION_MASKS,
         TURN_WEIGHT_PENALTIES,
         TURN_DURATION_PENALTIES,
+        NODE_LEVEL_ORDER,
+        SHORTCUT_CHILDREN_BLOCKS,
+        SHORTCUT_CHILDREN,
+        R_SEARCH_TREE_LEAVES,
         NUM_BLOCKS
     };
 
+    // Blocks of the static group only change with the extract, blocks of the metric group change
+    // with every update of the weights. Each group is stored in one piece of memory, so the
+    // static blocks can be shared between datasets that only differ in their metric.
+    enum BlockGroup
+    {
+        STATIC_GROUP = 0,
+        METRIC_GROUP,
+        NUM_BLOCK_GROUPS
+    };
+
+    using GroupMemory = std::array<char *, NUM_BLOCK_GROUPS>;
+
     std::array<std::uint64_t, NUM_BLOCKS> num_entries;
     std::array<std::size_t, NUM_BLOCKS> entry_size;
     std::array<std::size_t, NUM_BLOCKS> entry_align;
 
     DataLayout() : num_entries(), entry_size(), entry_align() {}
 
+    static BlockGroup GetBlockGroup(BlockID bid)
+    {
+        switch (bid)
+        {
+        case GRAPH_NODE_LIST:
+        case GRAPH_EDGE_LIST:
+        case GEOMETRIES_FWD_WEIGHT_LIST:
+        case GEOMETRIES_REV_WEIGHT_LIST:
+        case GEOMETRIES_FWD_DURATION_LIST:
+        case GEOMETRIES_REV_DURATION_LIST:
+        case HSGR_CHECKSUM:
+        case TIMESTAMP:
+        case CORE_MARKER:
+        case DATASOURCES_LIST:
+        case DATASOURCE_NAME_DATA:
+        case DATASOURCE_NAME_OFFSETS:
+        case DATASOURCE_NAME_LENGTHS:
+        case TURN_WEIGHT_PENALTIES:
+        case TURN_DURATION_PENALTIES:
+        case NODE_LEVEL_ORDER:
+        case SHORTCUT_CHILDREN_BLOCKS:
+        case SHORTCUT_CHILDREN:
+            return METRIC_GROUP;
+        default:
+            return STATIC_GROUP;
+        }
+    }
+
     template <typename T> inline void SetBlockSize(BlockID bid, uint64_t entries)
     {
         static_assert(sizeof(T) % alignof(T) == 0, "aligned T* can't be used as an array pointer");
@@ -128,17 +176,53 @@ struct DataLayout
         return num_entries[bid] * entry_size[bid];
     }
 
-    inline uint64_t GetSizeOfLayout() const
+    inline uint64_t GetSizeOfLayout(BlockGroup group) const
     {
         uint64_t result = 0;
         for (auto i = 0; i < NUM_BLOCKS; i++)
         {
             BOOST_ASSERT(entry_align[i] > 0);
-            result += 2 * sizeof(CANARY) + GetBlockSize((BlockID)i) + entry_align[i];
+            if (GetBlockGroup((BlockID)i) == group)
+            {
+                result += 2 * sizeof(CANARY) + GetBlockSize((BlockID)i) + entry_align[i];
+            }
         }
         return result;
     }
 
+    inline uint64_t GetSizeOfLayout() const
+    {
+        return GetSizeOfLayout(STATIC_GROUP) + GetSizeOfLayout(METRIC_GROUP);
+    }
+
+    // Blocks of the same group have the same size, alignment and number of entries
+    inline bool HasSameBlocks(const DataLayout &other, BlockGroup group) const
+    {
+        for (auto i = 0; i < NUM_BLOCKS; i++)
+        {
+            if (GetBlockGroup((BlockID)i) == group &&
+                (num_entries[i] != other.num_entries[i] || entry_size[i] != other.entry_size[i] ||
+                 entry_align[i] != other.entry_align[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // \brief Splits one contiguous memory block into the memory of the groups.
+    // The groups are stored one after the other in the order of their ids.
+    inline GroupMemory GetGroupMemory(char *memory) const
+    {
+        GroupMemory group_memory;
+        for (auto group = 0; group < NUM_BLOCK_GROUPS; group++)
+        {
+            group_memory[group] = memory;
+            memory += GetSizeOfLayout((BlockGroup)group);
+        }
+        return group_memory;
+    }
+
     // \brief Fit aligned storage in buffer.
     // Interface Similar to [ptr.align] but omits space computation.
     // The method can be removed and changed directly to an std::align
@@ -150,10 +234,17 @@ struct DataLayout
         return ptr = reinterpret_cast<void *>(aligned);
     }
 
-    inline void *GetAlignedBlockPtr(void *ptr, BlockID bid) const
+    inline void *GetAlignedBlockPtr(const GroupMemory &memory, BlockID bid) const
     {
+        const auto group = GetBlockGroup(bid);
+        void *ptr = memory[group];
+        BOOST_ASSERT(ptr != nullptr);
         for (auto i = 0; i < bid; i++)
         {
+            if (GetBlockGroup((BlockID)i) != group)
+            {
+                continue;
+            }
             ptr = static_cast<char *>(ptr) + sizeof(CANARY);
             ptr = align(entry_align[i], entry_size[i], ptr);
             ptr = static_cast<char *>(ptr) + GetBlockSize((BlockID)i);
@@ -165,10 +256,21 @@ struct DataLayout
         return ptr;
     }
 
+    inline void *GetAlignedBlockPtr(void *ptr, BlockID bid) const
+    {
+        return GetAlignedBlockPtr(GetGroupMemory(static_cast<char *>(ptr)), bid);
+    }
+
     template <typename T, bool WRITE_CANARY = false>
     inline T *GetBlockPtr(char *shared_memory, BlockID bid) const
     {
-        char *ptr = (char *)GetAlignedBlockPtr(shared_memory, bid);
+        return GetBlockPtr<T, WRITE_CANARY>(GetGroupMemory(shared_memory), bid);
+    }
+
+    template <typename T, bool WRITE_CANARY = false>
+    inline T *GetBlockPtr(const GroupMemory &memory, BlockID bid) const
+    {
+        char *ptr = (char *)GetAlignedBlockPtr(memory, bid);
         if (WRITE_CANARY)
         {
             char *start_canary_ptr = ptr - sizeof(CANARY);
@@ -202,7 +304,10 @@ enum SharedDataType
 {
     REGION_NONE,
     REGION_1,
-    REGION_2
+    REGION_2,
+    // hold the blocks of the static group, which can be shared by both regions
+    STATIC_REGION_1,
+    STATIC_REGION_2
 };
 
 struct SharedDataTimestamp
@@ -211,6 +316,15 @@ struct SharedDataTimestamp
     unsigned timestamp;
 };
 
+// Stored at the start of REGION_1 and REGION_2, followed by the blocks of the metric group
+struct SharedRegionHeader
+{
+    DataLayout layout;
+    SharedDataType static_region;
+    // identifies the data of the static blocks, see Storage::GetStaticChecksum
+    std::uint32_t static_checksum;
+};
+
 inline std::string regionToString(const SharedDataType region)
 {
     switch (region)
@@ -219,6 +333,10 @@ inline std::string regionToString(const SharedDataType region)
         return "REGION_1";
     case REGION_2:
         return "REGION_2";
+    case STATIC_REGION_1:
+        return "STATIC_REGION_1";
+    case STATIC_REGION_2:
+        return "STATIC_REGION_2";
     case REGION_NONE:
         return "REGION_NONE";
     default:
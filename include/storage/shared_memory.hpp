@@ -16,6 +16,7 @@
 
 #ifdef __linux__
 #include <sys/ipc.h>
+#include <sys/mman.h>
 #include <sys/shm.h>
 #endif
 
@@ -49,10 +50,13 @@ class SharedMemory
     SharedMemory(const SharedMemory &) = delete;
     SharedMemory &operator=(const SharedMemory &) = delete;
 
+    // With use_huge_pages a new region is backed by huge pages, falling back to normal pages
+    // that are advised to be merged into transparent huge pages if none are available
     template <typename IdentifierT>
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
-                 const uint64_t size = 0)
+                 const uint64_t size = 0,
+                 const bool use_huge_pages = false)
         : key(lock_file.string().c_str(), id)
     {
         // open only
@@ -67,6 +71,13 @@ class SharedMemory
         // open or create
         else
         {
+#ifdef __linux__
+            if (use_huge_pages && !CreateHugePages(key, size))
+            {
+                util::Log(logWARNING) << "could not allocate huge pages for shared memory, "
+                                         "using normal pages";
+            }
+#endif
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::Log(logDEBUG) << "opening/creating " << shm.get_shmid() << " from id " << id
@@ -81,6 +92,13 @@ class SharedMemory
             }
 #endif
             region = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
+#ifdef __linux__
+            if (use_huge_pages &&
+                -1 == madvise(region.get_address(), region.get_size(), MADV_HUGEPAGE))
+            {
+                util::Log(logDEBUG) << "could not advise transparent huge pages";
+            }
+#endif
         }
     }
 
@@ -159,6 +177,23 @@ class SharedMemory
 #endif
 
   private:
+#ifdef __linux__
+    // Creates the region with huge pages, unless it exists. Fails if no huge pages are reserved
+    // or the user is not allowed to use them.
+    static bool CreateHugePages(const boost::interprocess::xsi_key &key, const uint64_t size)
+    {
+        const auto shmid = ::shmget(key.get_key(), size, IPC_CREAT | SHM_HUGETLB | 0644);
+        if (shmid < 0)
+        {
+            const auto error_code = errno;
+            util::Log(logDEBUG) << "shmget with SHM_HUGETLB failed with error " << error_code;
+            return false;
+        }
+        util::Log(logDEBUG) << "created " << shmid << " with huge pages";
+        return true;
+    }
+#endif
+
     static bool RegionExists(const boost::interprocess::xsi_key &key)
     {
         bool result = true;
@@ -199,7 +234,11 @@ class SharedMemory
   public:
     void *Ptr() const { return region.get_address(); }
 
-    SharedMemory(const boost::filesystem::path &lock_file, const int id, const uint64_t size = 0)
+    // huge pages are not supported for shared memory on Windows
+    SharedMemory(const boost::filesystem::path &lock_file,
+                 const int id,
+                 const uint64_t size = 0,
+                 const bool /*use_huge_pages*/ = false)
     {
         sprintf(key, "%s.%d", "osrm.lock", id);
         if (0 == size)
@@ -281,7 +320,9 @@ class SharedMemory
 #endif
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
-std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint64_t size = 0)
+std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id,
+                                               const uint64_t size = 0,
+                                               const bool use_huge_pages = false)
 {
     try
     {
@@ -297,7 +338,7 @@ std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint
                 boost::filesystem::ofstream ofs(lock_file());
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(), id, size);
+        return std::make_unique<SharedMemory>(lock_file(), id, size, use_huge_pages);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
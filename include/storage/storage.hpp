@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace osrm
@@ -44,12 +45,25 @@ class Storage
   public:
     Storage(StorageConfig config);
 
-    int Run(int max_wait);
+    // Only loads the metric blocks if the static blocks match the data in use
+    int Run(int max_wait, bool only_metric);
+    // Writes the data to the container file instead of shared memory
+    int Export();
 
     void PopulateLayout(DataLayout &layout);
     void PopulateData(const DataLayout &layout, char *memory_ptr);
+    // The blocks of groups without memory are not loaded
+    void PopulateData(const DataLayout &layout, const DataLayout::GroupMemory &memory_ptr);
+
+    // Identifies the data of the static blocks without reading it. A container has checksums of
+    // its blocks. Otherwise the static blocks come from files that only osrm-extract writes, so
+    // their sizes and modification times identify them.
+    std::uint32_t GetStaticChecksum() const;
 
   private:
+    void PopulateDataFromContainer(const DataLayout &layout,
+                                   const DataLayout::GroupMemory &memory_ptr);
+
     StorageConfig config;
 };
 }
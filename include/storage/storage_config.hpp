@@ -36,7 +36,7 @@ namespace storage
 {
 
 /**
- * Configures OSRM's file storage paths.
+ * Configures OSRM's file storage paths and which of the files are loaded into memory.
  *
  * \see OSRM, EngineConfig
  */
@@ -58,6 +58,8 @@ struct StorageConfig final
     boost::filesystem::path nodes_data_path;
     boost::filesystem::path edges_data_path;
     boost::filesystem::path core_data_path;
+    boost::filesystem::path level_order_path;
+    boost::filesystem::path shortcut_children_path;
     boost::filesystem::path geometries_path;
     boost::filesystem::path timestamp_path;
     boost::filesystem::path turn_weight_penalties_path;
@@ -69,6 +71,17 @@ struct StorageConfig final
     boost::filesystem::path intersection_class_path;
     boost::filesystem::path turn_lane_data_path;
     boost::filesystem::path turn_lane_description_path;
+    // written by osrm-datastore --export, not needed to load the data from the other files
+    boost::filesystem::path container_path;
+
+    // Copy the leaves of the r-tree into memory instead of mapping the file index on demand
+    bool load_rtree_leaves = false;
+    // Load all data from the container instead of the other files
+    bool use_container = false;
+    // Back the memory the data is loaded into with huge pages where available
+    bool use_huge_pages = false;
+    // Spread the shared memory over all NUMA nodes instead of the node of osrm-datastore
+    bool interleave_numa_nodes = false;
 };
 }
 }
@@ -0,0 +1,55 @@
+#ifndef OSRM_UTIL_NUMA_HPP
+#define OSRM_UTIL_NUMA_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace numa
+{
+
+// Placement of threads and memory on the NUMA nodes of the system. Only implemented on Linux,
+// other systems behave like a single node.
+
+// Parses a list of ranges like 0-7,16-23 as used by sysfs. Throws std::invalid_argument if the
+// list does not start with a number.
+std::vector<unsigned> ParseList(const std::string &list);
+
+struct Topology
+{
+    // Online nodes, their ids can have gaps
+    std::vector<unsigned> nodes;
+    // Node of each CPU
+    std::vector<unsigned> node_of_cpu;
+};
+
+// Reads the online nodes and their CPUs from a directory laid out like /sys/devices/system/node.
+// Lists that can not be read are empty.
+Topology ReadTopology(const std::string &nodes_path);
+
+// Upper bound of the ids of the online NUMA nodes in /sys/devices/system/node/online, 1 if they
+// can not be determined. The ids can have gaps.
+unsigned GetNumberOfNodes();
+
+bool IsNodeOnline(const unsigned node);
+
+// Node of the CPU the calling thread runs on. The nodes of the CPUs are read once with the online
+// nodes, so this is cheap enough to call per request.
+unsigned GetCurrentNode();
+
+// Restricts the calling thread to the CPUs of the node. Memory that the thread touches first is
+// allocated on the node.
+bool RunOnNode(const unsigned node);
+
+// Spreads the pages of the memory over all nodes. Only applies to pages that were not touched
+// yet, the memory has to start at a page boundary.
+bool InterleaveMemory(void *memory, const std::size_t size);
+}
+}
+}
+
+#endif // OSRM_UTIL_NUMA_HPP
@@ -6,6 +6,7 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/deallocating_vector.hpp"
 #include "util/exception.hpp"
+#include "util/fingerprint.hpp"
 #include "util/hilbert_value.hpp"
 #include "util/integer_range.hpp"
 #include "util/rectangle.hpp"
@@ -24,8 +25,14 @@
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -62,10 +69,13 @@ class StaticRTree
     using EdgeData = EdgeDataT;
     using CoordinateList = CoordinateListT;
 
-    static_assert(LEAF_PAGE_SIZE >= sizeof(uint32_t) + sizeof(EdgeDataT), "page size is too small");
+    // every object of a leaf stores the projected coordinates of its two endpoints
+    static constexpr std::size_t LEAF_OBJECT_SIZE = sizeof(EdgeDataT) + 4 * sizeof(std::int32_t);
+    static_assert(LEAF_PAGE_SIZE >= sizeof(uint32_t) + sizeof(Rectangle) + LEAF_OBJECT_SIZE,
+                  "page size is too small");
     static_assert(((LEAF_PAGE_SIZE - 1) & LEAF_PAGE_SIZE) == 0, "page size is not a power of 2");
     static constexpr std::uint32_t LEAF_NODE_SIZE =
-        (LEAF_PAGE_SIZE - sizeof(uint32_t) - sizeof(Rectangle)) / sizeof(EdgeDataT);
+        (LEAF_PAGE_SIZE - sizeof(uint32_t) - sizeof(Rectangle)) / LEAF_OBJECT_SIZE;
 
     struct CandidateSegment
     {
@@ -91,13 +101,28 @@ class StaticRTree
 
     struct ALIGNED(LEAF_PAGE_SIZE) LeafNode
     {
-        LeafNode() : object_count(0), objects() {}
+        LeafNode()
+            : object_count(0), objects(), projected_u_lon(), projected_u_lat(), projected_v_lon(),
+              projected_v_lat()
+        {
+        }
         std::uint32_t object_count;
         Rectangle minimum_bounding_rectangle;
         std::array<EdgeDataT, LEAF_NODE_SIZE> objects;
+        // Web Mercator coordinates of the endpoints u and v of each object. Queries do not need to
+        // project them and the separate arrays let the distances to all objects of a leaf be
+        // computed in one vectorized loop.
+        std::array<std::int32_t, LEAF_NODE_SIZE> projected_u_lon;
+        std::array<std::int32_t, LEAF_NODE_SIZE> projected_u_lat;
+        std::array<std::int32_t, LEAF_NODE_SIZE> projected_v_lon;
+        std::array<std::int32_t, LEAF_NODE_SIZE> projected_v_lat;
     };
     static_assert(sizeof(LeafNode) == LEAF_PAGE_SIZE, "LeafNode size does not fit the page size");
 
+    // the leaf file starts with a page that holds the fingerprint, so the leaves stay page aligned
+    static constexpr std::size_t LEAF_FILE_HEADER_SIZE = LEAF_PAGE_SIZE;
+    static_assert(LEAF_FILE_HEADER_SIZE >= sizeof(FingerPrint), "page size is too small");
+
   private:
     struct WrappedInputElement
     {
@@ -152,6 +177,42 @@ class StaticRTree
         Coordinate fixed_projected_coordinate;
     };
 
+    // Min-heap of query candidates like std::priority_queue, but it keeps its storage when it is
+    // cleared so that one heap can serve many queries. Storage that a single large query grew
+    // beyond MAX_RETAINED_CANDIDATES is released again, so threads do not hold on to it.
+    class QueryHeap
+    {
+      public:
+        static constexpr std::size_t MAX_RETAINED_CANDIDATES = 1 << 16;
+
+        bool empty() const { return candidates.empty(); }
+        const QueryCandidate &top() const { return candidates.front(); }
+
+        void push(const QueryCandidate &candidate)
+        {
+            candidates.push_back(candidate);
+            std::push_heap(candidates.begin(), candidates.end());
+        }
+
+        void pop()
+        {
+            std::pop_heap(candidates.begin(), candidates.end());
+            candidates.pop_back();
+        }
+
+        void clear()
+        {
+            if (candidates.capacity() > MAX_RETAINED_CANDIDATES)
+            {
+                std::vector<QueryCandidate>().swap(candidates);
+            }
+            candidates.clear();
+        }
+
+      private:
+        std::vector<QueryCandidate> candidates;
+    };
+
     typename ShM<TreeNode, UseSharedMemory>::vector m_search_tree;
     const CoordinateListT &m_coordinate_list;
 
@@ -202,8 +263,14 @@ class StaticRTree
                 }
             });
 
-        // open leaf file
+        // open leaf file, the fingerprint rejects leaves of a different format
         boost::filesystem::ofstream leaf_node_file(leaf_node_filename, std::ios::binary);
+        std::array<char, LEAF_FILE_HEADER_SIZE> leaf_file_header{};
+        const auto fingerprint = FingerPrint::GetValid();
+        std::copy_n(reinterpret_cast<const char *>(&fingerprint),
+                    sizeof(fingerprint),
+                    leaf_file_header.begin());
+        leaf_node_file.write(leaf_file_header.data(), leaf_file_header.size());
 
         // sort the hilbert-value representatives
         tbb::parallel_sort(input_wrapper_vector.begin(), input_wrapper_vector.end());
@@ -241,6 +308,15 @@ class StaticRTree
                     BOOST_ASSERT(std::abs(toFloating(projected_v.lon).operator double()) <= 180.);
                     BOOST_ASSERT(std::abs(toFloating(projected_v.lat).operator double()) <= 180.);
 
+                    current_leaf.projected_u_lon[object_index] =
+                        static_cast<std::int32_t>(projected_u.lon);
+                    current_leaf.projected_u_lat[object_index] =
+                        static_cast<std::int32_t>(projected_u.lat);
+                    current_leaf.projected_v_lon[object_index] =
+                        static_cast<std::int32_t>(projected_v.lon);
+                    current_leaf.projected_v_lat[object_index] =
+                        static_cast<std::int32_t>(projected_v.lat);
+
                     rectangle.min_lon =
                         std::min(rectangle.min_lon, std::min(projected_u.lon, projected_v.lon));
                     rectangle.max_lon =
@@ -330,13 +406,14 @@ class StaticRTree
                 }
             });
 
-        // open tree file
-        boost::filesystem::ofstream tree_node_file(tree_node_filename, std::ios::binary);
+        // open tree file, the fingerprint rejects trees whose leaves have a different format
+        storage::io::FileWriter tree_node_file(tree_node_filename,
+                                               storage::io::FileWriter::GenerateFingerprint);
 
         std::uint64_t size_of_tree = m_search_tree.size();
         BOOST_ASSERT_MSG(0 < size_of_tree, "tree empty");
-        tree_node_file.write((char *)&size_of_tree, sizeof(size_of_tree));
-        tree_node_file.write((char *)&m_search_tree[0], sizeof(TreeNode) * size_of_tree);
+        tree_node_file.WriteElementCount64(size_of_tree);
+        tree_node_file.WriteFrom(&m_search_tree[0], size_of_tree);
 
         MapLeafNodesFile(leaf_node_filename);
     }
@@ -347,7 +424,7 @@ class StaticRTree
         : m_coordinate_list(coordinate_list)
     {
         storage::io::FileReader tree_node_file(node_file,
-                                               storage::io::FileReader::HasNoFingerprint);
+                                               storage::io::FileReader::VerifyFingerprint);
 
         const auto tree_size = tree_node_file.ReadElementCount64();
 
@@ -366,16 +443,42 @@ class StaticRTree
         MapLeafNodesFile(leaf_file);
     }
 
+    // Uses leaves that were loaded into memory instead of mapping the leaf file
+    explicit StaticRTree(TreeNode *tree_node_ptr,
+                         const uint64_t number_of_nodes,
+                         const LeafNode *leaf_node_ptr,
+                         const uint64_t number_of_leaves,
+                         const CoordinateListT &coordinate_list)
+        : m_search_tree(tree_node_ptr, number_of_nodes), m_coordinate_list(coordinate_list),
+          m_leaves(leaf_node_ptr, number_of_leaves)
+    {
+        BOOST_ASSERT(reinterpret_cast<uintptr_t>(leaf_node_ptr) % alignof(LeafNode) == 0);
+    }
+
     void MapLeafNodesFile(const boost::filesystem::path &leaf_file)
     {
         // open leaf node file and return a pointer to the mapped leaves data
         try
         {
+            {
+                storage::io::FileReader leaf_header(leaf_file,
+                                                    storage::io::FileReader::VerifyFingerprint);
+                if (leaf_header.GetSize() < LEAF_FILE_HEADER_SIZE)
+                {
+                    throw exception("unexpected end of file");
+                }
+            }
             m_leaves_region.open(leaf_file);
-            std::size_t num_leaves = m_leaves_region.size() / sizeof(LeafNode);
-            auto data_ptr = m_leaves_region.data();
+            std::size_t num_leaves =
+                (m_leaves_region.size() - LEAF_FILE_HEADER_SIZE) / sizeof(LeafNode);
+            auto data_ptr = m_leaves_region.data() + LEAF_FILE_HEADER_SIZE;
             BOOST_ASSERT(reinterpret_cast<uintptr_t>(data_ptr) % alignof(LeafNode) == 0);
             m_leaves.reset(reinterpret_cast<const LeafNode *>(data_ptr), num_leaves);
+#ifdef __linux__
+            // start reading the leaves in the background, so the first queries after loading
+            // new data take fewer page faults. This is only a hint and may be ignored.
+            madvise(const_cast<char *>(data_ptr), num_leaves * sizeof(LeafNode), MADV_WILLNEED);
+#endif
         }
         catch (const std::exception &exc)
         {
@@ -471,13 +574,30 @@ class StaticRTree
     std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
                                    const FilterT filter,
                                    const TerminationT terminate) const
+    {
+        return Nearest(
+            input_coordinate, filter, terminate, std::numeric_limits<std::uint64_t>::max());
+    }
+
+    // Nodes and segments with a squared distance in projected fixed point units above
+    // max_squared_distance are never queued. The results only stay the same if the terminator
+    // stops at every candidate beyond that distance.
+    template <typename FilterT, typename TerminationT>
+    std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
+                                   const FilterT filter,
+                                   const TerminationT terminate,
+                                   const std::uint64_t max_squared_distance) const
     {
         std::vector<EdgeDataT> results;
         auto projected_coordinate = web_mercator::fromWGS84(input_coordinate);
         Coordinate fixed_projected_coordinate{projected_coordinate};
 
+        // The queue is reused by all queries of a thread. Snapping many coordinates would
+        // otherwise allocate and grow a new queue for each of them.
+        thread_local QueryHeap traversal_queue;
+        traversal_queue.clear();
+
         // initialize queue with root element
-        std::priority_queue<QueryCandidate> traversal_queue;
         traversal_queue.push(QueryCandidate{0, TreeIndex{}});
 
         while (!traversal_queue.empty())
@@ -493,12 +613,15 @@ class StaticRTree
                     ExploreLeafNode(current_tree_index,
                                     fixed_projected_coordinate,
                                     projected_coordinate,
+                                    max_squared_distance,
                                     traversal_queue);
                 }
                 else
                 {
-                    ExploreTreeNode(
-                        current_tree_index, fixed_projected_coordinate, traversal_queue);
+                    ExploreTreeNode(current_tree_index,
+                                    fixed_projected_coordinate,
+                                    max_squared_distance,
+                                    traversal_queue);
                 }
             }
             else
@@ -528,6 +651,8 @@ class StaticRTree
                 results.push_back(std::move(edge_data));
             }
         }
+        // releases the storage right away if this query grew the queue past the cap
+        traversal_queue.clear();
 
         return results;
     }
@@ -537,34 +662,61 @@ class StaticRTree
     void ExploreLeafNode(const TreeIndex &leaf_id,
                          const Coordinate &projected_input_coordinate_fixed,
                          const FloatCoordinate &projected_input_coordinate,
+                         const std::uint64_t max_squared_distance,
                          QueueT &traversal_queue) const
     {
         const LeafNode &current_leaf_node = m_leaves[leaf_id.index];
-
-        // current object represents a block on disk
-        for (const auto i : irange(0u, current_leaf_node.object_count))
+        const std::uint32_t object_count = current_leaf_node.object_count;
+
+        // Projects the input onto all segments of the leaf like
+        // coordinate_calculation::projectPointOnSegment, in fixed point units. The ratios are
+        // computed in a loop without branches over contiguous arrays, so it is vectorized.
+        const double input_lon =
+            static_cast<double>(projected_input_coordinate.lon) * COORDINATE_PRECISION;
+        const double input_lat =
+            static_cast<double>(projected_input_coordinate.lat) * COORDINATE_PRECISION;
+        std::array<double, LEAF_NODE_SIZE> ratios;
+        for (std::uint32_t i = 0; i < object_count; ++i)
         {
-            const auto &current_edge = current_leaf_node.objects[i];
-            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
-            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+            const double u_lon = current_leaf_node.projected_u_lon[i];
+            const double u_lat = current_leaf_node.projected_u_lat[i];
+            const double slope_lon = current_leaf_node.projected_v_lon[i] - u_lon;
+            const double slope_lat = current_leaf_node.projected_v_lat[i] - u_lat;
+            // segments of length zero have a ratio of NaN
+            ratios[i] = (slope_lon * (input_lon - u_lon) + slope_lat * (input_lat - u_lat)) /
+                        (slope_lon * slope_lon + slope_lat * slope_lat);
+        }
 
-            FloatCoordinate projected_nearest;
-            std::tie(std::ignore, projected_nearest) =
-                coordinate_calculation::projectPointOnSegment(
-                    projected_u, projected_v, projected_input_coordinate);
+        for (std::uint32_t i = 0; i < object_count; ++i)
+        {
+            // clamps NaN to zero as well
+            const double clamped_ratio = std::min(1., std::max(0., ratios[i]));
+            const double u_lon = current_leaf_node.projected_u_lon[i];
+            const double u_lat = current_leaf_node.projected_u_lat[i];
+            const double nearest_lon =
+                u_lon + clamped_ratio * (current_leaf_node.projected_v_lon[i] - u_lon);
+            const double nearest_lat =
+                u_lat + clamped_ratio * (current_leaf_node.projected_v_lat[i] - u_lat);
+            const Coordinate projected_nearest{
+                FixedLongitude{static_cast<std::int32_t>(std::round(nearest_lon))},
+                FixedLatitude{static_cast<std::int32_t>(std::round(nearest_lat))}};
 
             const auto squared_distance = coordinate_calculation::squaredEuclideanDistance(
                 projected_input_coordinate_fixed, projected_nearest);
             // distance must be non-negative
             BOOST_ASSERT(0. <= squared_distance);
-            traversal_queue.push(
-                QueryCandidate{squared_distance, leaf_id, i, Coordinate{projected_nearest}});
+            if (squared_distance <= max_squared_distance)
+            {
+                traversal_queue.push(
+                    QueryCandidate{squared_distance, leaf_id, i, projected_nearest});
+            }
         }
     }
 
     template <class QueueT>
     void ExploreTreeNode(const TreeIndex &parent_id,
                          const Coordinate &fixed_projected_input_coordinate,
+                         const std::uint64_t max_squared_distance,
                          QueueT &traversal_queue) const
     {
         const TreeNode &parent = m_search_tree[parent_id.index];
@@ -576,7 +728,11 @@ class StaticRTree
                                  : m_search_tree[child_id.index].minimum_bounding_rectangle;
             const auto squared_lower_bound_to_element =
                 child_rectangle.GetMinSquaredDist(fixed_projected_input_coordinate);
-            traversal_queue.push(QueryCandidate{squared_lower_bound_to_element, child_id});
+            // nothing in the child can be closer than its bounding box
+            if (squared_lower_bound_to_element <= max_squared_distance)
+            {
+                traversal_queue.push(QueryCandidate{squared_lower_bound_to_element, child_id});
+            }
         }
     }
 };
@@ -2,12 +2,15 @@
 #include "contractor/crc32_processor.hpp"
 #include "contractor/graph_contractor.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/graph_customizer.hpp"
+#include "contractor/shortcut_children.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
 #include "extractor/node_based_edge.hpp"
 
 #include "storage/io.hpp"
+#include "storage/serialization.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/graph_loader.hpp"
@@ -46,6 +49,8 @@
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <numeric>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -379,6 +384,33 @@ int Contractor::Run()
     }
 #endif
 
+    if (config.customize)
+    {
+        TIMER_START(customization);
+        std::vector<QueryEdge> contracted_edges;
+        ReadContractedGraph(max_edge_id, contracted_edges);
+        if (contracted_edges.empty() && !edge_based_edge_list.empty())
+        {
+            throw util::exception(config.graph_output_path + " has no edges to customize" +
+                                  SOURCE_REF);
+        }
+        auto customized_edge_list =
+            customizeContractedGraph(contracted_edges, edge_based_edge_list);
+        TIMER_STOP(customization);
+
+        util::Log() << "Customization took " << TIMER_SEC(customization) << " sec";
+
+        // the core markers and the level order only depend on the hierarchy and are kept
+        WriteContractedGraph(max_edge_id, customized_edge_list);
+        WriteShortcutChildren(max_edge_id, customized_edge_list);
+
+        TIMER_STOP(preparing);
+        util::Log() << "Preprocessing : " << TIMER_SEC(preparing) << " seconds";
+        util::Log() << "finished preprocessing";
+
+        return 0;
+    }
+
     // Contracting the edge-expanded graph
 
     TIMER_START(contraction);
@@ -405,7 +437,10 @@ int Contractor::Run()
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
     std::size_t number_of_used_edges = WriteContractedGraph(max_edge_id, contracted_edge_list);
+    WriteShortcutChildren(max_edge_id, contracted_edge_list);
+    const bool has_core = !is_core_node.empty();
     WriteCoreNodeMarker(std::move(is_core_node));
+    WriteLevelOrder(node_levels, has_core);
     if (!config.use_cached_priority)
     {
         WriteNodeLevels(std::move(node_levels));
@@ -947,6 +982,44 @@ void Contractor::ReadNodeLevels(std::vector<float> &node_levels) const
     order_file.ReadInto(node_levels);
 }
 
+// Reads the edges of the .hsgr file of a previous run, sorted by source and target
+void Contractor::ReadContractedGraph(const unsigned max_node_id,
+                                     std::vector<QueryEdge> &contracted_edge_list) const
+{
+    storage::io::FileReader hsgr_file(config.graph_output_path,
+                                      storage::io::FileReader::VerifyFingerprint);
+    const auto hsgr_header = storage::serialization::readHSGRHeader(hsgr_file);
+
+    // the node array has a sentinel, see WriteContractedGraph
+    if (hsgr_header.number_of_nodes != static_cast<std::uint64_t>(max_node_id) + 2)
+    {
+        throw util::exception(config.graph_output_path + " has " +
+                              std::to_string(hsgr_header.number_of_nodes) +
+                              " nodes, but the edge expanded graph needs " +
+                              std::to_string(static_cast<std::uint64_t>(max_node_id) + 2) +
+                              ". Contract the graph again." + SOURCE_REF);
+    }
+
+    std::vector<storage::serialization::NodeT> node_list(hsgr_header.number_of_nodes);
+    std::vector<storage::serialization::EdgeT> edge_list(hsgr_header.number_of_edges);
+    storage::serialization::readHSGR(hsgr_file,
+                                     node_list.data(),
+                                     hsgr_header.number_of_nodes,
+                                     edge_list.data(),
+                                     hsgr_header.number_of_edges);
+
+    contracted_edge_list.clear();
+    contracted_edge_list.reserve(edge_list.size());
+    for (const auto node : util::irange<std::size_t>(1UL, node_list.size()))
+    {
+        for (auto edge = node_list[node - 1].first_edge; edge < node_list[node].first_edge; ++edge)
+        {
+            contracted_edge_list.emplace_back(
+                static_cast<NodeID>(node - 1), edge_list[edge].target, edge_list[edge].data);
+        }
+    }
+}
+
 void Contractor::WriteNodeLevels(std::vector<float> &&in_node_levels) const
 {
     std::vector<float> node_levels(std::move(in_node_levels));
@@ -958,6 +1031,29 @@ void Contractor::WriteNodeLevels(std::vector<float> &&in_node_levels) const
     order_output_stream.write((char *)node_levels.data(), sizeof(float) * node_levels.size());
 }
 
+// Writes all nodes sorted by descending contraction level. Settling the nodes in this order
+// after an upward search yields the distances to all nodes (PHAST). Only a fully contracted
+// hierarchy admits such a sweep, a core needs a real search, so we write an empty order then.
+void Contractor::WriteLevelOrder(const std::vector<float> &node_levels, const bool has_core) const
+{
+    std::vector<NodeID> level_order;
+    if (!has_core)
+    {
+        level_order.resize(node_levels.size());
+        std::iota(level_order.begin(), level_order.end(), 0);
+        tbb::parallel_sort(level_order.begin(),
+                           level_order.end(),
+                           [&node_levels](const NodeID lhs, const NodeID rhs) {
+                               return std::tie(node_levels[rhs], lhs) <
+                                      std::tie(node_levels[lhs], rhs);
+                           });
+    }
+
+    storage::io::FileWriter level_order_file(config.level_order_output_path,
+                                             storage::io::FileWriter::GenerateFingerprint);
+    level_order_file.SerializeVector(level_order);
+}
+
 void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
 {
     std::vector<bool> is_core_node(std::move(in_is_core_node));
@@ -975,6 +1071,94 @@ void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
                                     sizeof(char) * unpacked_bool_flags.size());
 }
 
+void Contractor::WriteShortcutChildren(
+    unsigned max_node_id, const util::DeallocatingVector<QueryEdge> &contracted_edge_list) const
+{
+    util::Log() << "Writing shortcut children";
+    const std::uint64_t number_of_edges = contracted_edge_list.size();
+    if (number_of_edges > CHEdgeReference::MAX_NUMBER_OF_EDGES)
+    {
+        throw util::exception("Too many edges to store their shortcut children: " +
+                              std::to_string(number_of_edges) + SOURCE_REF);
+    }
+
+    // The edge ids are the positions in the sorted edge list, which is also what the static
+    // graph of the query uses.
+    std::vector<EdgeID> first_edge(max_node_id + 2, 0);
+    for (const auto &edge : contracted_edge_list)
+    {
+        ++first_edge[edge.source + 1];
+    }
+    std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+
+    const auto find_traversed_edge = [&](const NodeID from, const NodeID to) {
+        return findTraversedEdge(
+            contracted_edge_list, first_edge, from, to, [&](const EdgeID edge, const bool) {
+                return contracted_edge_list[edge].data.weight;
+            });
+    };
+
+    std::vector<ShortcutChildrenBlock> blocks(
+        (2 * number_of_edges + ShortcutChildrenBlock::BITS_PER_BLOCK - 1) /
+        ShortcutChildrenBlock::BITS_PER_BLOCK);
+    std::uint32_t number_of_shortcuts = 0;
+    for (const auto edge : util::irange<EdgeID>(0, number_of_edges))
+    {
+        const auto &data = contracted_edge_list[edge].data;
+        for (const bool reversed : {false, true})
+        {
+            const auto bit = getShortcutChildrenBit(edge, reversed);
+            auto &block = blocks[bit / ShortcutChildrenBlock::BITS_PER_BLOCK];
+            if (bit % ShortcutChildrenBlock::BITS_PER_BLOCK == 0)
+            {
+                block.offset = number_of_shortcuts;
+            }
+
+            if (data.shortcut && (reversed ? data.backward : data.forward))
+            {
+                block.mask |= 1u << (bit % ShortcutChildrenBlock::BITS_PER_BLOCK);
+                ++number_of_shortcuts;
+            }
+        }
+    }
+
+    std::vector<ShortcutChildren> children(number_of_shortcuts);
+    tbb::parallel_for(tbb::blocked_range<EdgeID>(0, number_of_edges),
+                      [&](const tbb::blocked_range<EdgeID> &range) {
+                          for (auto edge = range.begin(); edge != range.end(); ++edge)
+                          {
+                              const auto &contracted_edge = contracted_edge_list[edge];
+                              const auto &data = contracted_edge.data;
+                              if (!data.shortcut)
+                                  continue;
+
+                              const NodeID middle = data.id;
+                              if (data.forward)
+                              {
+                                  children[getShortcutChildrenIndex(blocks, edge, false)] = {
+                                      find_traversed_edge(contracted_edge.source, middle),
+                                      find_traversed_edge(middle, contracted_edge.target)};
+                              }
+                              if (data.backward)
+                              {
+                                  children[getShortcutChildrenIndex(blocks, edge, true)] = {
+                                      find_traversed_edge(contracted_edge.target, middle),
+                                      find_traversed_edge(middle, contracted_edge.source)};
+                              }
+                          }
+                      });
+
+    RangebasedCRC32 crc32_calculator;
+    const unsigned edges_crc32 = crc32_calculator(contracted_edge_list);
+
+    // the checksum of the .hsgr file guards against using the children with another graph
+    storage::io::FileWriter shortcut_children_file(config.shortcut_children_output_path,
+                                                   storage::io::FileWriter::GenerateFingerprint);
+    shortcut_children_file.WriteOne(edges_crc32);
+    shortcut_children_file.SerializeVector(blocks);
+    shortcut_children_file.SerializeVector(children);
+}
+
 std::size_t
 Contractor::WriteContractedGraph(unsigned max_node_id,
                                  const util::DeallocatingVector<QueryEdge> &contracted_edge_list)
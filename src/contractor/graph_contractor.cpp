@@ -40,17 +40,23 @@ GraphContractor::GraphContractor(int nodes,
         forward_edge.data.originalEdges = reverse_edge.data.originalEdges = 1;
         forward_edge.data.weight = reverse_edge.data.weight = INVALID_EDGE_WEIGHT;
         forward_edge.data.duration = reverse_edge.data.duration = MAXIMAL_EDGE_DURATION;
+        forward_edge.data.distance = reverse_edge.data.distance = 0;
         // remove parallel edges
         while (i < edges.size() && edges[i].source == source && edges[i].target == target)
         {
             if (edges[i].data.forward)
             {
+                // the distance belongs to the edge we keep
+                if (edges[i].data.weight < forward_edge.data.weight)
+                    forward_edge.data.distance = edges[i].data.distance;
                 forward_edge.data.weight = std::min(edges[i].data.weight, forward_edge.data.weight);
                 forward_edge.data.duration =
                     std::min(edges[i].data.duration, forward_edge.data.duration);
             }
             if (edges[i].data.backward)
             {
+                if (edges[i].data.weight < reverse_edge.data.weight)
+                    reverse_edge.data.distance = edges[i].data.distance;
                 reverse_edge.data.weight = std::min(edges[i].data.weight, reverse_edge.data.weight);
                 reverse_edge.data.duration =
                     std::min(edges[i].data.duration, reverse_edge.data.duration);
@@ -206,6 +212,8 @@ void GraphContractor::Run(double core_factor)
         util::UnbufferedLog log;
         log << "using cached node priorities ...";
         node_priorities.swap(node_levels);
+        // the levels are still recorded, the cached priorities only determine the order
+        node_levels.resize(number_of_nodes);
         log << "ok";
     }
     else
@@ -273,34 +281,31 @@ void GraphContractor::Run(double core_factor)
             std::distance(remaining_nodes.begin(), begin_independent_nodes);
         auto end_independent_nodes_idx = remaining_nodes.size();
 
-        if (!use_cached_node_priorities)
-        {
-            // write out contraction level
-            tbb::parallel_for(
-                tbb::blocked_range<NodeID>(
-                    begin_independent_nodes_idx, end_independent_nodes_idx, ContractGrainSize),
-                [this, remaining_nodes, flushed_contractor, current_level](
-                    const tbb::blocked_range<NodeID> &range) {
-                    if (flushed_contractor)
+        // write out contraction level
+        tbb::parallel_for(
+            tbb::blocked_range<NodeID>(
+                begin_independent_nodes_idx, end_independent_nodes_idx, ContractGrainSize),
+            [this, &remaining_nodes, flushed_contractor, current_level](
+                const tbb::blocked_range<NodeID> &range) {
+                if (flushed_contractor)
+                {
+                    for (auto position = range.begin(), end = range.end(); position != end;
+                         ++position)
                     {
-                        for (auto position = range.begin(), end = range.end(); position != end;
-                             ++position)
-                        {
-                            const NodeID x = remaining_nodes[position].id;
-                            node_levels[orig_node_id_from_new_node_id_map[x]] = current_level;
-                        }
+                        const NodeID x = remaining_nodes[position].id;
+                        node_levels[orig_node_id_from_new_node_id_map[x]] = current_level;
                     }
-                    else
+                }
+                else
+                {
+                    for (auto position = range.begin(), end = range.end(); position != end;
+                         ++position)
                     {
-                        for (auto position = range.begin(), end = range.end(); position != end;
-                             ++position)
-                        {
-                            const NodeID x = remaining_nodes[position].id;
-                            node_levels[x] = current_level;
-                        }
+                        const NodeID x = remaining_nodes[position].id;
+                        node_levels[x] = current_level;
                     }
-                });
-        }
+                }
+            });
 
         // contract independent nodes
         tbb::parallel_for(
@@ -419,6 +424,14 @@ void GraphContractor::Run(double core_factor)
         // in this case we don't need core markers since we fully contracted
         // the graph
         is_core_node.clear();
+
+        // the last remaining nodes form the top of the hierarchy
+        for (const auto &node : remaining_nodes)
+        {
+            const auto orig_id =
+                flushed_contractor ? orig_node_id_from_new_node_id_map[node.id] : node.id;
+            node_levels[orig_id] = current_level;
+        }
     }
 
     util::Log() << "[core] " << remaining_nodes.size() << " nodes "
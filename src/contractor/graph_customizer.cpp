@@ -0,0 +1,433 @@
+#include "contractor/graph_customizer.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+namespace
+{
+struct EdgeMetric
+{
+    EdgeWeight weight;
+    EdgeWeight duration;
+    EdgeDistance distance;
+
+    bool operator==(const EdgeMetric &other) const
+    {
+        return std::tie(weight, duration, distance) ==
+               std::tie(other.weight, other.duration, other.distance);
+    }
+};
+
+// An edge based edge traversed in one of its directions
+struct Traversal
+{
+    NodeID from;
+    NodeID to;
+    EdgeMetric metric;
+
+    bool operator<(const Traversal &other) const
+    {
+        return std::tie(from, to) < std::tie(other.from, other.to);
+    }
+};
+
+const constexpr std::uint32_t UNKNOWN_ROUND = std::numeric_limits<std::uint32_t>::max();
+const constexpr std::size_t INVALID_METRIC_INDEX = std::numeric_limits<std::size_t>::max();
+
+// Every edge has a metric for each direction it is traversed in
+inline std::size_t getMetricIndex(const EdgeID edge, const bool reversed)
+{
+    return 2 * static_cast<std::size_t>(edge) + (reversed ? 1 : 0);
+}
+}
+
+util::DeallocatingVector<QueryEdge>
+customizeContractedGraph(const std::vector<QueryEdge> &edges,
+                         const std::vector<extractor::EdgeBasedEdge> &edge_based_edges)
+{
+    BOOST_ASSERT(std::is_sorted(edges.begin(), edges.end()));
+    const auto number_of_edges = static_cast<EdgeID>(edges.size());
+
+    NodeID number_of_nodes = 0;
+    for (const auto &edge : edges)
+    {
+        number_of_nodes = std::max({number_of_nodes, edge.source + 1, edge.target + 1});
+    }
+    std::vector<EdgeID> first_edge(number_of_nodes + 1, 0);
+    for (const auto &edge : edges)
+    {
+        ++first_edge[edge.source + 1];
+    }
+    std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+
+    // edges without an edge based edge keep their old metric
+    std::vector<EdgeMetric> metrics(2 * edges.size());
+    for (const auto edge : util::irange<EdgeID>(0, number_of_edges))
+    {
+        const auto &data = edges[edge].data;
+        const EdgeMetric metric{data.weight, data.duration, data.distance};
+        metrics[getMetricIndex(edge, false)] = metric;
+        metrics[getMetricIndex(edge, true)] = metric;
+    }
+
+    // The contractor merges all edge based edges between two nodes into one original edge per
+    // direction, which takes the smallest weight and duration. The id of the CH edge is that of
+    // one of them, so the new metric is looked up by the direction the edge is traversed in.
+    std::vector<Traversal> traversals;
+    traversals.reserve(edge_based_edges.size());
+    for (const auto &edge_based_edge : edge_based_edges)
+    {
+        const EdgeMetric metric{std::max(edge_based_edge.weight, 1),
+                                edge_based_edge.duration,
+                                edge_based_edge.distance};
+        if (edge_based_edge.forward)
+        {
+            traversals.push_back({edge_based_edge.source, edge_based_edge.target, metric});
+        }
+        if (edge_based_edge.backward)
+        {
+            traversals.push_back({edge_based_edge.target, edge_based_edge.source, metric});
+        }
+    }
+    std::stable_sort(traversals.begin(), traversals.end());
+    {
+        auto output = traversals.begin();
+        for (auto traversal = traversals.begin(); traversal != traversals.end(); ++traversal)
+        {
+            if (output != traversals.begin() && std::prev(output)->from == traversal->from &&
+                std::prev(output)->to == traversal->to)
+            {
+                // the distance belongs to the edge with the smallest weight
+                auto &merged = std::prev(output)->metric;
+                if (traversal->metric.weight < merged.weight)
+                {
+                    merged.distance = traversal->metric.distance;
+                }
+                merged.weight = std::min(merged.weight, traversal->metric.weight);
+                merged.duration = std::min(merged.duration, traversal->metric.duration);
+            }
+            else
+            {
+                *output++ = *traversal;
+            }
+        }
+        traversals.erase(output, traversals.end());
+    }
+    const auto find_traversal = [&](const NodeID from, const NodeID to) -> const EdgeMetric * {
+        const auto traversal =
+            std::lower_bound(traversals.begin(), traversals.end(), Traversal{from, to, {}});
+        if (traversal == traversals.end() || traversal->from != from || traversal->to != to)
+        {
+            return nullptr;
+        }
+        return &traversal->metric;
+    };
+
+    // The smallest edge stored at `lower` that is traversable up to `higher` or down from it, like
+    // findTraversedEdge finds it
+    const auto find_smallest_edge = [&](const NodeID lower, const NodeID higher, const bool up) {
+        const auto end = edges.begin() + first_edge[lower + 1];
+        auto edge = std::lower_bound(
+            edges.begin() + first_edge[lower],
+            end,
+            higher,
+            [](const QueryEdge &lhs, const NodeID rhs) { return lhs.target < rhs; });
+
+        std::size_t smallest_index = INVALID_METRIC_INDEX;
+        for (; edge != end && edge->target == higher; ++edge)
+        {
+            const auto id = static_cast<EdgeID>(std::distance(edges.begin(), edge));
+            const auto index = getMetricIndex(id, !up);
+            if ((up ? edge->data.forward : edge->data.backward) &&
+                (smallest_index == INVALID_METRIC_INDEX ||
+                 metrics[index].weight < metrics[smallest_index].weight))
+            {
+                smallest_index = index;
+            }
+        }
+        return smallest_index;
+    };
+    const auto has_edge = [&](const NodeID source, const NodeID target) {
+        return std::binary_search(
+            edges.begin() + first_edge[source],
+            edges.begin() + first_edge[source + 1],
+            QueryEdge{source, target, QueryEdge::EdgeData{}},
+            [](const QueryEdge &lhs, const QueryEdge &rhs) { return lhs.target < rhs.target; });
+    };
+
+    // Edges are stored at the node that was contracted first. The lower neighbours of a node are
+    // those that store an edge to it, except for nodes of the core, which store their edges in
+    // both directions and are not ordered among each other.
+    std::vector<EdgeID> first_lower_neighbour(number_of_nodes + 1, 0);
+    std::vector<NodeID> lower_neighbours;
+    {
+        std::vector<std::pair<NodeID, NodeID>> lower_pairs;
+        for (const auto &edge : edges)
+        {
+            if (edge.source != edge.target && !has_edge(edge.target, edge.source))
+            {
+                lower_pairs.emplace_back(edge.target, edge.source);
+            }
+        }
+        std::sort(lower_pairs.begin(), lower_pairs.end());
+        lower_pairs.erase(std::unique(lower_pairs.begin(), lower_pairs.end()), lower_pairs.end());
+        lower_neighbours.reserve(lower_pairs.size());
+        for (const auto &pair : lower_pairs)
+        {
+            ++first_lower_neighbour[pair.first + 1];
+            lower_neighbours.push_back(pair.second);
+        }
+        std::partial_sum(first_lower_neighbour.begin(),
+                         first_lower_neighbour.end(),
+                         first_lower_neighbour.begin());
+    }
+
+    // The round of a node is one after the rounds of all its lower neighbours. The edges stored
+    // at a node are customized in its round and only read edges stored at lower neighbours.
+    std::vector<std::uint32_t> node_rounds(number_of_nodes, UNKNOWN_ROUND);
+    std::vector<NodeID> stack;
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        stack.push_back(node);
+        while (!stack.empty())
+        {
+            const auto current = stack.back();
+            if (node_rounds[current] != UNKNOWN_ROUND)
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            std::uint32_t round = 0;
+            bool has_unknown_neighbours = false;
+            for (const auto position : util::irange<EdgeID>(first_lower_neighbour[current],
+                                                             first_lower_neighbour[current + 1]))
+            {
+                const auto neighbour = lower_neighbours[position];
+                if (node_rounds[neighbour] == UNKNOWN_ROUND)
+                {
+                    has_unknown_neighbours = true;
+                    stack.push_back(neighbour);
+                }
+                else
+                {
+                    round = std::max(round, node_rounds[neighbour] + 1);
+                }
+            }
+
+            if (!has_unknown_neighbours)
+            {
+                node_rounds[current] = round;
+                stack.pop_back();
+            }
+        }
+    }
+
+    const std::uint32_t number_of_rounds =
+        node_rounds.empty() ? 0
+                            : *std::max_element(node_rounds.begin(), node_rounds.end()) + 1;
+    std::vector<EdgeID> round_begin(number_of_rounds + 1, 0);
+    for (const auto &edge : edges)
+    {
+        ++round_begin[node_rounds[edge.source] + 1];
+    }
+    std::partial_sum(round_begin.begin(), round_begin.end(), round_begin.begin());
+    std::vector<EdgeID> edges_by_round(number_of_edges);
+    {
+        auto round_end = round_begin;
+        for (const auto edge : util::irange<EdgeID>(0, number_of_edges))
+        {
+            edges_by_round[round_end[node_rounds[edges[edge].source]]++] = edge;
+        }
+    }
+
+    // A shortcut is the shortest path over any of its lower triangles, that is over a node that
+    // is a lower neighbour of both of its nodes. The middle node is updated to that of the
+    // shortest path, per direction.
+    std::vector<NodeID> middles(2 * edges.size());
+    for (const auto edge : util::irange<EdgeID>(0, number_of_edges))
+    {
+        middles[getMetricIndex(edge, false)] = edges[edge].data.id;
+        middles[getMetricIndex(edge, true)] = edges[edge].data.id;
+    }
+    const auto customize_shortcut = [&](const EdgeID edge, const bool reversed) {
+        const auto &shortcut = edges[edge];
+        const auto from = reversed ? shortcut.target : shortcut.source;
+        const auto to = reversed ? shortcut.source : shortcut.target;
+
+        std::size_t best_first = INVALID_METRIC_INDEX;
+        std::size_t best_second = INVALID_METRIC_INDEX;
+        NodeID best_middle = shortcut.data.id;
+        const auto relax = [&](const NodeID middle) {
+            const auto first = find_smallest_edge(middle, from, false);
+            const auto second = find_smallest_edge(middle, to, true);
+            if (first == INVALID_METRIC_INDEX || second == INVALID_METRIC_INDEX)
+                return;
+
+            const auto weight = metrics[first].weight + metrics[second].weight;
+            if (best_first == INVALID_METRIC_INDEX ||
+                weight < metrics[best_first].weight + metrics[best_second].weight)
+            {
+                best_first = first;
+                best_second = second;
+                best_middle = middle;
+            }
+        };
+        // the old middle wins ties
+        relax(shortcut.data.id);
+
+        auto from_neighbour = lower_neighbours.begin() + first_lower_neighbour[from];
+        const auto from_end = lower_neighbours.begin() + first_lower_neighbour[from + 1];
+        auto to_neighbour = lower_neighbours.begin() + first_lower_neighbour[to];
+        const auto to_end = lower_neighbours.begin() + first_lower_neighbour[to + 1];
+        while (from_neighbour != from_end && to_neighbour != to_end)
+        {
+            if (*from_neighbour < *to_neighbour)
+            {
+                ++from_neighbour;
+            }
+            else if (*to_neighbour < *from_neighbour)
+            {
+                ++to_neighbour;
+            }
+            else
+            {
+                relax(*from_neighbour);
+                ++from_neighbour;
+                ++to_neighbour;
+            }
+        }
+
+        BOOST_ASSERT(best_first != INVALID_METRIC_INDEX);
+        const auto &first = metrics[best_first];
+        const auto &second = metrics[best_second];
+        metrics[getMetricIndex(edge, reversed)] = EdgeMetric{first.weight + second.weight,
+                                                             first.duration + second.duration,
+                                                             first.distance + second.distance};
+        middles[getMetricIndex(edge, reversed)] = best_middle;
+    };
+
+    // edges of a round only read the metrics of earlier rounds
+    std::atomic<std::size_t> number_of_unmatched_edges{0};
+    for (const auto round : util::irange<std::uint32_t>(0, number_of_rounds))
+    {
+        tbb::parallel_for(
+            tbb::blocked_range<EdgeID>(round_begin[round], round_begin[round + 1]),
+            [&](const tbb::blocked_range<EdgeID> &range) {
+                for (auto position = range.begin(); position != range.end(); ++position)
+                {
+                    const auto edge = edges_by_round[position];
+                    const auto &current_edge = edges[edge];
+                    const auto &data = current_edge.data;
+                    if (!data.shortcut)
+                    {
+                        if (data.forward)
+                        {
+                            const auto forward_metric =
+                                find_traversal(current_edge.source, current_edge.target);
+                            if (forward_metric)
+                                metrics[getMetricIndex(edge, false)] = *forward_metric;
+                            else
+                                ++number_of_unmatched_edges;
+                        }
+                        if (data.backward)
+                        {
+                            const auto backward_metric =
+                                find_traversal(current_edge.target, current_edge.source);
+                            if (backward_metric)
+                                metrics[getMetricIndex(edge, true)] = *backward_metric;
+                            else
+                                ++number_of_unmatched_edges;
+                        }
+                        continue;
+                    }
+
+                    if (data.forward)
+                    {
+                        customize_shortcut(edge, false);
+                    }
+                    if (data.backward)
+                    {
+                        customize_shortcut(edge, true);
+                    }
+                }
+            });
+    }
+
+    if (number_of_unmatched_edges > 0)
+    {
+        util::Log(logWARNING) << number_of_unmatched_edges
+                              << " original edges have no edge based edge and keep their old "
+                                 "metric, the edge expanded graph does not match the hierarchy";
+    }
+
+    util::DeallocatingVector<QueryEdge> customized_edges;
+    std::size_t number_of_split_edges = 0;
+    for (const auto edge : util::irange<EdgeID>(0, number_of_edges))
+    {
+        const auto &forward_metric = metrics[getMetricIndex(edge, false)];
+        const auto &backward_metric = metrics[getMetricIndex(edge, true)];
+        const auto set_metric = [](QueryEdge::EdgeData &data, const EdgeMetric &metric) {
+            data.weight = metric.weight;
+            data.duration = metric.duration;
+            data.distance = metric.distance;
+        };
+
+        const auto forward_middle = middles[getMetricIndex(edge, false)];
+        const auto backward_middle = middles[getMetricIndex(edge, true)];
+
+        auto data = edges[edge].data;
+        if (data.forward && data.backward &&
+            (!(forward_metric == backward_metric) || forward_middle != backward_middle))
+        {
+            data.backward = false;
+            set_metric(data, forward_metric);
+            if (data.shortcut)
+                data.id = forward_middle;
+            customized_edges.emplace_back(edges[edge].source, edges[edge].target, data);
+
+            data.forward = false;
+            data.backward = true;
+            set_metric(data, backward_metric);
+            if (data.shortcut)
+                data.id = backward_middle;
+            customized_edges.emplace_back(edges[edge].source, edges[edge].target, data);
+            ++number_of_split_edges;
+        }
+        else
+        {
+            set_metric(data, data.forward ? forward_metric : backward_metric);
+            if (data.shortcut)
+                data.id = data.forward ? forward_middle : backward_middle;
+            customized_edges.emplace_back(edges[edge].source, edges[edge].target, data);
+        }
+    }
+
+    util::Log() << "Customized " << number_of_edges << " edges in " << number_of_rounds
+                << " rounds, split " << number_of_split_edges << " bidirectional edges";
+
+    return customized_edges;
+}
+}
+}
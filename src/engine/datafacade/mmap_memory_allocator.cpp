@@ -0,0 +1,69 @@
+#include "engine/datafacade/mmap_memory_allocator.hpp"
+#include "storage/container.hpp"
+#include "storage/io.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+
+#include "boost/assert.hpp"
+
+#include <boost/format.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+MMapMemoryAllocator::MMapMemoryAllocator(const boost::filesystem::path &container_path)
+{
+    util::Log(logDEBUG) << "Mapping data from " << container_path.string();
+
+    // The layout is copied, it is small and the facade needs a mutable reference
+    {
+        storage::io::FileReader container_file(container_path,
+                                               storage::io::FileReader::VerifyFingerprint);
+        internal_layout = std::make_unique<storage::DataLayout>();
+        // the blocks are found through the layout, which is checked against the table of contents
+        storage::ContainerTOC toc;
+        storage::readContainerHeader(container_file, *internal_layout, toc);
+
+        if (container_file.GetSize() <
+            storage::CONTAINER_DATA_OFFSET + internal_layout->GetSizeOfLayout())
+        {
+            throw util::exception("Container " + container_path.string() + " is truncated" +
+                                  SOURCE_REF);
+        }
+    }
+
+    try
+    {
+        mapped_container.open(container_path);
+    }
+    catch (const std::exception &exc)
+    {
+        throw util::exception(boost::str(boost::format("Container %1% mapping failed: %2%") %
+                                         container_path % exc.what()) +
+                              SOURCE_REF);
+    }
+    // block alignments are relative to the page aligned start of the memory block
+    BOOST_ASSERT(reinterpret_cast<std::uintptr_t>(mapped_container.data()) %
+                     storage::CONTAINER_ALIGNMENT ==
+                 0);
+}
+
+MMapMemoryAllocator::~MMapMemoryAllocator() {}
+
+storage::DataLayout &MMapMemoryAllocator::GetLayout() { return *internal_layout.get(); }
+
+// The mapping is read-only, the facades never write to the memory block
+storage::DataLayout::GroupMemory MMapMemoryAllocator::GetMemory()
+{
+    return internal_layout->GetGroupMemory(const_cast<char *>(mapped_container.data()) +
+                                           storage::CONTAINER_DATA_OFFSET);
+}
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
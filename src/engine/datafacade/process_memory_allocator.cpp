@@ -1,8 +1,17 @@
 #include "engine/datafacade/process_memory_allocator.hpp"
 #include "storage/storage.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
 
 #include "boost/assert.hpp"
 
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace osrm
 {
 namespace engine
@@ -11,6 +20,7 @@ namespace datafacade
 {
 
 ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config)
+    : use_huge_pages(config.use_huge_pages)
 {
     storage::Storage storage(config);
 
@@ -19,14 +29,56 @@ ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &con
     storage.PopulateLayout(*internal_layout);
 
     // Allocate the memory block, then load data from files into it
-    internal_memory = std::make_unique<char[]>(internal_layout->GetSizeOfLayout());
+    internal_memory = AllocateMemory(internal_layout->GetSizeOfLayout(), use_huge_pages);
     storage.PopulateData(*internal_layout, internal_memory.get());
 }
 
+ProcessMemoryAllocator::ProcessMemoryAllocator(const ProcessMemoryAllocator &other)
+    : use_huge_pages(other.use_huge_pages)
+{
+    internal_layout = std::make_unique<storage::DataLayout>(*other.internal_layout);
+
+    internal_memory = AllocateMemory(internal_layout->GetSizeOfLayout(), use_huge_pages);
+    std::copy_n(other.internal_memory.get(),
+                internal_layout->GetSizeOfLayout(),
+                internal_memory.get());
+}
+
 ProcessMemoryAllocator::~ProcessMemoryAllocator() {}
 
+ProcessMemoryAllocator::MemoryPtr ProcessMemoryAllocator::AllocateMemory(const std::size_t size,
+                                                                         const bool use_huge_pages)
+{
+#ifdef __linux__
+    if (use_huge_pages)
+    {
+        // anonymous mappings are aligned to pages and can be merged into transparent huge pages
+        void *memory =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            throw util::exception("could not allocate " + std::to_string(size) + " bytes" +
+                                  SOURCE_REF);
+        }
+        if (-1 == madvise(memory, size, MADV_HUGEPAGE))
+        {
+            util::Log(logWARNING) << "transparent huge pages are not available, using normal pages";
+        }
+        // Pages are placed on the NUMA node of the thread that touches them first. Touch them
+        // here, because PopulateData fills the memory from threads that can run on any node.
+        std::fill_n(static_cast<char *>(memory), size, 0);
+        return {static_cast<char *>(memory), [size](char *memory) { munmap(memory, size); }};
+    }
+#endif
+    (void)use_huge_pages;
+    return {new char[size](), [](char *memory) { delete[] memory; }};
+}
+
 storage::DataLayout &ProcessMemoryAllocator::GetLayout() { return *internal_layout.get(); }
-char *ProcessMemoryAllocator::GetMemory() { return internal_memory.get(); }
+storage::DataLayout::GroupMemory ProcessMemoryAllocator::GetMemory()
+{
+    return internal_layout->GetGroupMemory(internal_memory.get());
+}
 
 } // namespace datafacade
 } // namespace engine
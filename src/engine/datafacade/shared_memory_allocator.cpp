@@ -16,17 +16,28 @@ SharedMemoryAllocator::SharedMemoryAllocator(storage::SharedDataType data_region
 
     BOOST_ASSERT(storage::SharedMemory::RegionExists(data_region));
     m_large_memory = storage::makeSharedMemory(data_region);
+
+    const auto static_region =
+        reinterpret_cast<storage::SharedRegionHeader *>(m_large_memory->Ptr())->static_region;
+    util::Log(logDEBUG) << "Using static data of region " << regionToString(static_region);
+
+    BOOST_ASSERT(storage::SharedMemory::RegionExists(static_region));
+    m_static_memory = storage::makeSharedMemory(static_region);
 }
 
 SharedMemoryAllocator::~SharedMemoryAllocator() {}
 
 storage::DataLayout &SharedMemoryAllocator::GetLayout()
 {
-    return *reinterpret_cast<storage::DataLayout *>(m_large_memory->Ptr());
+    return reinterpret_cast<storage::SharedRegionHeader *>(m_large_memory->Ptr())->layout;
 }
-char *SharedMemoryAllocator::GetMemory()
+storage::DataLayout::GroupMemory SharedMemoryAllocator::GetMemory()
 {
-    return reinterpret_cast<char *>(m_large_memory->Ptr()) + sizeof(storage::DataLayout);
+    storage::DataLayout::GroupMemory memory;
+    memory[storage::DataLayout::STATIC_GROUP] = reinterpret_cast<char *>(m_static_memory->Ptr());
+    memory[storage::DataLayout::METRIC_GROUP] =
+        reinterpret_cast<char *>(m_large_memory->Ptr()) + sizeof(storage::SharedRegionHeader);
+    return memory;
 }
 
 } // namespace datafacade
@@ -4,42 +4,55 @@
 #include "engine/status.hpp"
 
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "engine/datafacade/mmap_memory_allocator.hpp"
 #include "engine/datafacade/process_memory_allocator.hpp"
 
 #include "util/log.hpp"
+#include "util/numa.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
 namespace
 {
 
-auto GetWatchdogDataFacade()
+// The watchdog is shared by all engines of the process, the first one configures it
+auto GetWatchdogDataFacade(const std::size_t unpacking_cache_size)
 {
-    static osrm::engine::DataWatchdog watchdog;
+    static osrm::engine::DataWatchdog watchdog(unpacking_cache_size);
     return watchdog.GetDataFacade();
 }
 
 // Abstracted away the query locking into a template function
 // Works the same for every plugin.
 template <typename ParameterT, typename PluginT, typename ResultT>
-osrm::engine::Status
-RunQuery(const std::shared_ptr<const osrm::engine::datafacade::BaseDataFacade> &immutable_facade,
-         const ParameterT &parameters,
-         PluginT &plugin,
-         ResultT &result)
+osrm::engine::Status RunQuery(
+    const std::vector<std::shared_ptr<const osrm::engine::datafacade::BaseDataFacade>>
+        &immutable_facades,
+    const std::size_t unpacking_cache_size,
+    const ParameterT &parameters,
+    PluginT &plugin,
+    ResultT &result)
 {
-    if (immutable_facade)
+    if (immutable_facades.size() == 1)
     {
-        return plugin.HandleRequest(immutable_facade, parameters, result);
+        return plugin.HandleRequest(immutable_facades.front(), parameters, result);
+    }
+    if (!immutable_facades.empty())
+    {
+        const auto node = osrm::util::numa::GetCurrentNode() % immutable_facades.size();
+        return plugin.HandleRequest(immutable_facades[node], parameters, result);
     }
 
-    return plugin.HandleRequest(GetWatchdogDataFacade(), parameters, result);
+    return plugin.HandleRequest(GetWatchdogDataFacade(unpacking_cache_size), parameters, result);
 }
 
 } // anon. ns
@@ -50,56 +63,178 @@ namespace engine
 {
 
 Engine::Engine(const EngineConfig &config)
-    : route_plugin(config.max_locations_viaroute),       //
-      table_plugin(config.max_locations_distance_table), //
-      nearest_plugin(config.max_results_nearest),        //
-      trip_plugin(config.max_locations_trip),            //
-      match_plugin(config.max_locations_map_matching),   //
-      tile_plugin()                                      //
+    : route_plugin(config.max_locations_viaroute, config.max_alternatives),          //
+      table_plugin(config.max_locations_distance_table),                             //
+      nearest_plugin(config.max_results_nearest, config.max_locations_nearest),      //
+      trip_plugin(config.max_locations_trip, config.trip_search_time),               //
+      match_plugin(config.max_locations_map_matching, config.max_matching_sessions), //
+      tile_plugin(),                                                                 //
+      isochrone_plugin(config.max_duration_isochrone),                               //
+      optimize_plugin(config.max_locations_optimize, config.optimize_search_time),   //
+      unpacking_cache_size(config.unpacking_cache_size)                              //
 
 {
+    if (config.use_numa && config.use_shared_memory)
+    {
+        util::Log(logWARNING) << "Only data loaded from files is copied to every NUMA node";
+    }
+
     if (!config.use_shared_memory)
     {
-        if (!config.storage_config.IsValid())
+        const auto number_of_nodes = config.use_numa ? util::numa::GetNumberOfNodes() : 1;
+        if (config.use_numa && number_of_nodes == 1)
+        {
+            util::Log(logWARNING) << "Found a single NUMA node, the data is not copied";
+        }
+
+        std::unique_ptr<datafacade::ContiguousBlockAllocator> allocator;
+        if (config.use_mmap)
+        {
+            if (!boost::filesystem::is_regular_file(config.storage_config.container_path))
+            {
+                throw util::exception("Missing container " +
+                                      config.storage_config.container_path.string() + SOURCE_REF);
+            }
+            allocator = std::make_unique<datafacade::MMapMemoryAllocator>(
+                config.storage_config.container_path);
+        }
+        else
         {
-            throw util::exception("Invalid file paths given!" + SOURCE_REF);
+            if (!config.storage_config.IsValid())
+            {
+                throw util::exception("Invalid file paths given!" + SOURCE_REF);
+            }
+            if (number_of_nodes > 1)
+            {
+                LoadNodeReplicas(config.storage_config, number_of_nodes);
+                return;
+            }
+            allocator =
+                std::make_unique<datafacade::ProcessMemoryAllocator>(config.storage_config);
         }
-        auto allocator =
-            std::make_unique<datafacade::ProcessMemoryAllocator>(config.storage_config);
-        immutable_data_facade =
+        if (number_of_nodes > 1)
+        {
+            util::Log(logWARNING) << "Only data loaded from files is copied to every NUMA node";
+        }
+        immutable_data_facades.push_back(
             std::make_shared<const datafacade::ContiguousInternalMemoryDataFacade>(
-                std::move(allocator));
+                std::move(allocator), unpacking_cache_size));
+    }
+}
+
+void Engine::LoadNodeReplicas(const storage::StorageConfig &storage_config,
+                              const unsigned number_of_nodes)
+{
+    util::Log() << "Copying the data to " << number_of_nodes << " NUMA nodes";
+
+    // Memory is allocated on the node of the thread that touches it first, so every copy is
+    // made by a thread that runs on its node. The first online node loads the files.
+    unsigned first_node = 0;
+    while (first_node + 1 < number_of_nodes && !util::numa::IsNodeOnline(first_node))
+    {
+        ++first_node;
+    }
+    immutable_data_facades.resize(number_of_nodes);
+    std::vector<std::exception_ptr> errors(number_of_nodes);
+    const datafacade::ProcessMemoryAllocator *original = nullptr;
+    const auto load_replica = [&](const unsigned node) {
+        try
+        {
+            if (!util::numa::RunOnNode(node))
+            {
+                util::Log(logWARNING) << "Could not run on the CPUs of NUMA node " << node;
+            }
+            auto allocator =
+                original ? std::make_unique<datafacade::ProcessMemoryAllocator>(*original)
+                         : std::make_unique<datafacade::ProcessMemoryAllocator>(storage_config);
+            if (!original)
+            {
+                original = allocator.get();
+            }
+            immutable_data_facades[node] =
+                std::make_shared<const datafacade::ContiguousInternalMemoryDataFacade>(
+                    std::move(allocator), unpacking_cache_size);
+        }
+        catch (...)
+        {
+            errors[node] = std::current_exception();
+        }
+    };
+
+    std::thread(load_replica, first_node).join();
+    std::vector<std::thread> threads;
+    if (!errors[first_node])
+    {
+        for (unsigned node = 0; node < number_of_nodes; ++node)
+        {
+            if (node == first_node)
+            {
+                continue;
+            }
+            if (util::numa::IsNodeOnline(node))
+            {
+                threads.emplace_back(load_replica, node);
+            }
+            else
+            {
+                // no request runs on a node that is not online
+                immutable_data_facades[node] = immutable_data_facades[first_node];
+            }
+        }
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
     }
 }
 
 Status Engine::Route(const api::RouteParameters &params, util::json::Object &result) const
 {
-    return RunQuery(immutable_data_facade, params, route_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, route_plugin, result);
 }
 
 Status Engine::Table(const api::TableParameters &params, util::json::Object &result) const
 {
-    return RunQuery(immutable_data_facade, params, table_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, table_plugin, result);
 }
 
 Status Engine::Nearest(const api::NearestParameters &params, util::json::Object &result) const
 {
-    return RunQuery(immutable_data_facade, params, nearest_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, nearest_plugin, result);
 }
 
 Status Engine::Trip(const api::TripParameters &params, util::json::Object &result) const
 {
-    return RunQuery(immutable_data_facade, params, trip_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, trip_plugin, result);
 }
 
 Status Engine::Match(const api::MatchParameters &params, util::json::Object &result) const
 {
-    return RunQuery(immutable_data_facade, params, match_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, match_plugin, result);
 }
 
 Status Engine::Tile(const api::TileParameters &params, std::string &result) const
 {
-    return RunQuery(immutable_data_facade, params, tile_plugin, result);
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, tile_plugin, result);
+}
+
+Status Engine::Isochrone(const api::IsochroneParameters &params,
+                         util::json::Object &result) const
+{
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, isochrone_plugin, result);
+}
+
+Status Engine::Optimize(const api::OptimizeParameters &params, util::json::Object &result) const
+{
+    return RunQuery(immutable_data_facades, unpacking_cache_size, params, optimize_plugin, result);
 }
 
 } // engine ns
@@ -1,5 +1,7 @@
 #include "engine/engine_config.hpp"
 
+#include <boost/filesystem/operations.hpp>
+
 namespace osrm
 {
 namespace engine
@@ -21,11 +23,22 @@ bool EngineConfig::IsValid() const
 
     const bool limits_valid = unlimited_or_more_than(max_locations_distance_table, 2) &&
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
+                              unlimited_or_more_than(max_matching_sessions, 0) &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
-                              unlimited_or_more_than(max_results_nearest, 0);
+                              unlimited_or_more_than(max_locations_optimize, 2) &&
+                              unlimited_or_more_than(max_results_nearest, 0) &&
+                              unlimited_or_more_than(max_locations_nearest, 0) &&
+                              unlimited_or_more_than(max_duration_isochrone, 0) &&
+                              unlimited_or_more_than(max_alternatives, 0) &&
+                              trip_search_time >= 0 && optimize_search_time >= 0;
+
+    const bool storage_valid =
+        use_mmap ? !use_shared_memory &&
+                       boost::filesystem::is_regular_file(storage_config.container_path)
+                 : (use_shared_memory && all_path_are_empty) || storage_config.IsValid();
 
-    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) && limits_valid;
+    return storage_valid && limits_valid;
 }
 }
 }
@@ -0,0 +1,326 @@
+#include "engine/isochrone_grid.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+// Directions of the boundary edges, counter-clockwise
+enum Direction : std::uint8_t
+{
+    EAST = 0,
+    NORTH,
+    WEST,
+    SOUTH
+};
+
+const constexpr std::int32_t DIRECTION_DX[4] = {1, 0, -1, 0};
+const constexpr std::int32_t DIRECTION_DY[4] = {0, 1, 0, -1};
+const constexpr std::uint32_t INVALID_BOUNDARY_EDGE = std::numeric_limits<std::uint32_t>::max();
+
+struct BoundaryEdge
+{
+    std::uint32_t x;
+    std::uint32_t y;
+    Direction direction;
+};
+
+struct Ring
+{
+    std::vector<std::pair<std::int32_t, std::int32_t>> vertices;
+    double area;
+    // a point strictly inside the cell to the right of the first edge
+    double test_x;
+    double test_y;
+};
+
+double signedArea(const std::vector<std::pair<std::int32_t, std::int32_t>> &vertices)
+{
+    double area = 0;
+    for (const auto index : util::irange<std::size_t>(0UL, vertices.size()))
+    {
+        const auto &current = vertices[index];
+        const auto &next = vertices[(index + 1) % vertices.size()];
+        area += static_cast<double>(current.first) * next.second -
+                static_cast<double>(next.first) * current.second;
+    }
+    return area / 2.;
+}
+
+// Even-odd rule, the test point never lies on a grid line
+bool isInside(const std::vector<std::pair<std::int32_t, std::int32_t>> &vertices,
+              const double x,
+              const double y)
+{
+    bool inside = false;
+    for (std::size_t index = 0, previous = vertices.size() - 1; index < vertices.size();
+         previous = index++)
+    {
+        const auto &current = vertices[index];
+        const auto &last = vertices[previous];
+        if ((current.second > y) != (last.second > y))
+        {
+            const double intersection_x = current.first + (y - current.second) *
+                                                              (last.first - current.first) /
+                                                              (last.second - current.second);
+            if (x < intersection_x)
+            {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+}
+
+const constexpr std::size_t IsochroneGrid::MAX_CELLS;
+
+IsochroneGrid::IsochroneGrid(const util::Coordinate south_west,
+                             const util::Coordinate north_east,
+                             const double cell_size)
+{
+    BOOST_ASSERT(cell_size > 0);
+
+    const auto west = static_cast<double>(util::toFloating(south_west.lon));
+    const auto south = static_cast<double>(util::toFloating(south_west.lat));
+    const auto east = static_cast<double>(util::toFloating(north_east.lon));
+    const auto north = static_cast<double>(util::toFloating(north_east.lat));
+    BOOST_ASSERT(west <= east && south <= north);
+
+    namespace detail = util::coordinate_calculation::detail;
+    const double meters_per_degree = detail::EARTH_RADIUS * detail::DEGREE_TO_RAD;
+    const double lat_scale = std::max(std::cos(detail::degToRad((south + north) / 2.)), 0.01);
+
+    cell_lat = cell_size / meters_per_degree;
+    cell_lon = cell_lat / lat_scale;
+
+    // two cells of padding on every side: one for buffering, one to keep the border empty
+    const auto compute_size = [&] {
+        width = static_cast<std::size_t>(std::ceil((east - west) / cell_lon)) + 4;
+        height = static_cast<std::size_t>(std::ceil((north - south) / cell_lat)) + 4;
+    };
+    compute_size();
+    while (width * height > MAX_CELLS)
+    {
+        const double scale = std::sqrt(static_cast<double>(width * height) / MAX_CELLS) * 1.01;
+        cell_lon *= scale;
+        cell_lat *= scale;
+        compute_size();
+    }
+
+    origin_lon = west - 2 * cell_lon;
+    origin_lat = south - 2 * cell_lat;
+
+    times.resize(width * height, INVALID_EDGE_WEIGHT);
+}
+
+void IsochroneGrid::AddSegment(const util::Coordinate from,
+                               const util::Coordinate to,
+                               const EdgeWeight from_time,
+                               const EdgeWeight to_time)
+{
+    if (from_time < 0 && to_time < 0)
+        return;
+
+    const double from_x =
+        (static_cast<double>(util::toFloating(from.lon)) - origin_lon) / cell_lon;
+    const double from_y =
+        (static_cast<double>(util::toFloating(from.lat)) - origin_lat) / cell_lat;
+    const double to_x = (static_cast<double>(util::toFloating(to.lon)) - origin_lon) / cell_lon;
+    const double to_y = (static_cast<double>(util::toFloating(to.lat)) - origin_lat) / cell_lat;
+
+    // samples are at most half a cell apart
+    const auto length = std::hypot(to_x - from_x, to_y - from_y);
+    const auto number_of_steps = static_cast<std::size_t>(std::ceil(length * 2)) + 1;
+
+    for (const auto step : util::irange<std::size_t>(0UL, number_of_steps + 1))
+    {
+        const double factor = static_cast<double>(step) / number_of_steps;
+        const double time = from_time + factor * (to_time - from_time);
+        if (time < 0)
+            continue;
+
+        const auto x = std::floor(from_x + factor * (to_x - from_x));
+        const auto y = std::floor(from_y + factor * (to_y - from_y));
+        // keep the padding empty, see the constructor
+        if (x < 2 || y < 2 || x >= width - 2 || y >= height - 2)
+            continue;
+
+        auto &cell_time =
+            times[static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)];
+        cell_time = std::min(cell_time, static_cast<EdgeWeight>(std::lround(time)));
+    }
+}
+
+util::Coordinate IsochroneGrid::ToCoordinate(const double x, const double y) const
+{
+    return util::Coordinate{util::FloatLongitude{origin_lon + x * cell_lon},
+                            util::FloatLatitude{origin_lat + y * cell_lat}};
+}
+
+std::vector<IsochronePolygon> IsochroneGrid::Contour(const EdgeWeight max_time) const
+{
+    // reached cells, buffered by one cell
+    std::vector<bool> filled(width * height, false);
+    for (const auto y : util::irange<std::size_t>(1UL, height - 1))
+    {
+        for (const auto x : util::irange<std::size_t>(1UL, width - 1))
+        {
+            if (times[y * width + x] > max_time)
+                continue;
+
+            for (const auto neighbour_y : {y - 1, y, y + 1})
+            {
+                for (const auto neighbour_x : {x - 1, x, x + 1})
+                {
+                    filled[neighbour_y * width + neighbour_x] = true;
+                }
+            }
+        }
+    }
+    const auto is_filled = [&](const std::size_t x, const std::size_t y) {
+        return filled[y * width + x];
+    };
+
+    // Boundary edges between filled and empty cells, oriented such that the filled cell is on
+    // the left. This makes outer rings counter-clockwise and holes clockwise.
+    // The border cells are never filled, so all neighbour checks are in range.
+    std::vector<BoundaryEdge> edges;
+    for (const auto y : util::irange<std::uint32_t>(1, height - 1))
+    {
+        for (const auto x : util::irange<std::uint32_t>(1, width - 1))
+        {
+            if (!is_filled(x, y))
+                continue;
+
+            if (!is_filled(x, y - 1))
+                edges.push_back({x, y, EAST});
+            if (!is_filled(x + 1, y))
+                edges.push_back({x + 1, y, NORTH});
+            if (!is_filled(x, y + 1))
+                edges.push_back({x + 1, y + 1, WEST});
+            if (!is_filled(x - 1, y))
+                edges.push_back({x, y + 1, SOUTH});
+        }
+    }
+
+    // Every grid vertex has at most two outgoing boundary edges
+    const auto vertex_id = [this](const std::uint32_t x, const std::uint32_t y) {
+        return static_cast<std::size_t>(y) * (width + 1) + x;
+    };
+    std::vector<std::uint32_t> outgoing(2 * (width + 1) * (height + 1), INVALID_BOUNDARY_EDGE);
+    for (const auto edge_index : util::irange<std::uint32_t>(0, edges.size()))
+    {
+        const auto &edge = edges[edge_index];
+        const auto vertex = vertex_id(edge.x, edge.y);
+        const auto slot = outgoing[2 * vertex] == INVALID_BOUNDARY_EDGE ? 0 : 1;
+        BOOST_ASSERT(outgoing[2 * vertex + slot] == INVALID_BOUNDARY_EDGE);
+        outgoing[2 * vertex + slot] = edge_index;
+    }
+
+    // At a vertex shared by two diagonal cells we turn left, which keeps both cells in
+    // separate rings and never lets a ring touch itself.
+    const auto next_edge = [&](const std::uint32_t edge_index) {
+        const auto &edge = edges[edge_index];
+        const auto vertex = vertex_id(edge.x + DIRECTION_DX[edge.direction],
+                                      edge.y + DIRECTION_DY[edge.direction]);
+        const auto first = outgoing[2 * vertex];
+        const auto second = outgoing[2 * vertex + 1];
+        BOOST_ASSERT(first != INVALID_BOUNDARY_EDGE);
+        if (second == INVALID_BOUNDARY_EDGE)
+            return first;
+
+        const auto left = static_cast<Direction>((edge.direction + 1) % 4);
+        return edges[first].direction == left ? first : second;
+    };
+
+    std::vector<Ring> outer_rings;
+    std::vector<Ring> holes;
+    std::vector<bool> visited(edges.size(), false);
+    for (const auto start_index : util::irange<std::uint32_t>(0, edges.size()))
+    {
+        if (visited[start_index])
+            continue;
+
+        Ring ring;
+        const auto &start = edges[start_index];
+        const auto dx = DIRECTION_DX[start.direction];
+        const auto dy = DIRECTION_DY[start.direction];
+        ring.test_x = start.x + 0.5 * dx + 0.5 * dy;
+        ring.test_y = start.y + 0.5 * dy - 0.5 * dx;
+
+        auto edge_index = start_index;
+        do
+        {
+            visited[edge_index] = true;
+            const auto &edge = edges[edge_index];
+            const auto next_index = next_edge(edge_index);
+            // only keep the corners of the ring
+            if (edges[next_index].direction != edge.direction)
+            {
+                ring.vertices.emplace_back(edge.x + DIRECTION_DX[edge.direction],
+                                           edge.y + DIRECTION_DY[edge.direction]);
+            }
+            edge_index = next_index;
+        } while (edge_index != start_index);
+
+        ring.area = signedArea(ring.vertices);
+        if (ring.area > 0)
+            outer_rings.push_back(std::move(ring));
+        else
+            holes.push_back(std::move(ring));
+    }
+
+    const auto to_coordinates = [this](const Ring &ring) {
+        std::vector<util::Coordinate> coordinates;
+        coordinates.reserve(ring.vertices.size() + 1);
+        for (const auto &vertex : ring.vertices)
+        {
+            coordinates.push_back(ToCoordinate(vertex.first, vertex.second));
+        }
+        coordinates.push_back(coordinates.front());
+        return coordinates;
+    };
+
+    std::vector<IsochronePolygon> polygons(outer_rings.size());
+    std::transform(outer_rings.begin(),
+                   outer_rings.end(),
+                   polygons.begin(),
+                   [&](const Ring &ring) { return IsochronePolygon{to_coordinates(ring), {}}; });
+
+    // a hole belongs to the smallest outer ring that contains it
+    for (const auto &hole : holes)
+    {
+        std::size_t best_outer = outer_rings.size();
+        for (const auto outer_index : util::irange<std::size_t>(0UL, outer_rings.size()))
+        {
+            const auto &outer = outer_rings[outer_index];
+            if ((best_outer == outer_rings.size() || outer.area < outer_rings[best_outer].area) &&
+                isInside(outer.vertices, hole.test_x, hole.test_y))
+            {
+                best_outer = outer_index;
+            }
+        }
+
+        BOOST_ASSERT(best_outer < outer_rings.size());
+        if (best_outer < outer_rings.size())
+        {
+            polygons[best_outer].holes.push_back(to_coordinates(hole));
+        }
+    }
+
+    return polygons;
+}
+}
+}
@@ -0,0 +1,224 @@
+#include "engine/plugins/isochrone.hpp"
+
+#include "engine/api/isochrone_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/isochrone_grid.hpp"
+#include "engine/routing_algorithms/one_to_all.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+namespace
+{
+// The grid resolution adapts to the reached area, but is never finer than the minimal cell size
+const constexpr double MIN_CELL_SIZE = 25.;
+const constexpr double CELLS_PER_SIDE = 256.;
+
+struct ReachedSegment
+{
+    util::Coordinate from;
+    util::Coordinate to;
+    EdgeWeight from_duration;
+    EdgeWeight to_duration;
+};
+
+// Bounding box of the geometries of all nodes the search reached within its duration bound.
+// The geometry of a node is only known through the turns leaving it, which the search collects
+// with the reached nodes.
+std::pair<util::Coordinate, util::Coordinate>
+getReachedBoundingBox(const datafacade::BaseDataFacade &facade,
+                      const OneToAllLabels &labels,
+                      const util::Coordinate source_location)
+{
+    auto south_west = source_location;
+    auto north_east = source_location;
+
+    auto reached = labels.reached;
+    std::sort(reached.begin(), reached.end());
+    const auto end = std::unique(
+        reached.begin(), reached.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.first == rhs.first;
+        });
+
+    for (auto iter = reached.begin(); iter != end; ++iter)
+    {
+        const auto geometry_index = facade.GetGeometryIndexForEdgeID(iter->second);
+        for (const auto geometry_node : facade.GetUncompressedForwardGeometry(geometry_index.id))
+        {
+            const auto coordinate = facade.GetCoordinateOfNode(geometry_node);
+            south_west.lon = std::min(south_west.lon, coordinate.lon);
+            south_west.lat = std::min(south_west.lat, coordinate.lat);
+            north_east.lon = std::max(north_east.lon, coordinate.lon);
+            north_east.lat = std::max(north_east.lat, coordinate.lat);
+        }
+    }
+
+    return std::make_pair(south_west, north_east);
+}
+}
+
+IsochronePlugin::IsochronePlugin(const int max_duration_isochrone)
+    : one_to_all(heaps), max_duration_isochrone(max_duration_isochrone)
+{
+}
+
+Status
+IsochronePlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                               const api::IsochroneParameters &params,
+                               util::json::Object &result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (!CheckAllCoordinates(params.coordinates))
+    {
+        return Error("InvalidOptions", "Coordinates are invalid", result);
+    }
+
+    const auto max_contour = *std::max_element(params.contours.begin(), params.contours.end());
+    if (max_contour > api::IsochroneParameters::MAX_CONTOUR)
+    {
+        return Error("InvalidOptions",
+                     "Contours need to be at most " +
+                         std::to_string(api::IsochroneParameters::MAX_CONTOUR) + " seconds",
+                     result);
+    }
+
+    if (max_duration_isochrone > 0 &&
+        max_contour > static_cast<unsigned>(max_duration_isochrone))
+    {
+        return Error("TooBig",
+                     "Contour " + std::to_string(max_contour) +
+                         " is higher than current maximum (" +
+                         std::to_string(max_duration_isochrone) + ")",
+                     result);
+    }
+
+    if (!routing_algorithms::OneToAllRouting::IsAvailable(*facade))
+    {
+        return Error("NotImplemented",
+                     "Isochrones need a fully contracted dataset with a level order",
+                     result);
+    }
+
+    const auto phantom_node_pairs = GetPhantomNodes(*facade, params);
+    if (phantom_node_pairs.size() != params.coordinates.size())
+    {
+        return Error("NoSegment", "Could not find a matching segment for coordinate", result);
+    }
+    const auto source = SnapPhantomNodes(phantom_node_pairs).front();
+
+    // durations are stored in deci-seconds, the parameters bound the contours to fit
+    const auto max_duration = static_cast<EdgeWeight>(std::int64_t{max_contour} * 10);
+
+    const auto &labels = one_to_all.Search(facade, source, max_duration);
+    const auto bounding_box = getReachedBoundingBox(*facade, labels, source.location);
+    const auto segments = facade->GetEdgesInBox(bounding_box.first, bounding_box.second);
+
+    std::vector<ReachedSegment> reached_segments;
+    auto south_west = source.location;
+    auto north_east = source.location;
+    const auto add_reached = [&](const util::Coordinate from,
+                                 const util::Coordinate to,
+                                 const EdgeWeight from_duration,
+                                 const EdgeWeight to_duration) {
+        // negative durations are before the source on the source segment
+        if (to_duration < 0 || from_duration > max_duration)
+            return;
+
+        reached_segments.push_back({from, to, from_duration, to_duration});
+        for (const auto coordinate : {from, to})
+        {
+            south_west.lon = std::min(south_west.lon, coordinate.lon);
+            south_west.lat = std::min(south_west.lat, coordinate.lat);
+            north_east.lon = std::max(north_east.lon, coordinate.lon);
+            north_east.lat = std::max(north_east.lat, coordinate.lat);
+        }
+    };
+
+    for (const auto &segment : segments)
+    {
+        const auto forward_id = segment.forward_segment_id;
+        const auto reverse_id = segment.reverse_segment_id;
+        const bool forward_reached =
+            forward_id.enabled && labels.weights[forward_id.id] != INVALID_EDGE_WEIGHT;
+        const bool reverse_reached =
+            reverse_id.enabled && labels.weights[reverse_id.id] != INVALID_EDGE_WEIGHT;
+        if (!forward_reached && !reverse_reached)
+            continue;
+
+        const auto u = facade->GetCoordinateOfNode(segment.u);
+        const auto v = facade->GetCoordinateOfNode(segment.v);
+
+        if (forward_reached)
+        {
+            const auto durations =
+                facade->GetUncompressedForwardDurations(segment.packed_geometry_id);
+            BOOST_ASSERT(segment.fwd_segment_position < durations.size());
+            const auto u_duration =
+                labels.durations[forward_id.id] +
+                std::accumulate(durations.begin(),
+                                durations.begin() + segment.fwd_segment_position,
+                                EdgeWeight{0});
+            add_reached(
+                u, v, u_duration, u_duration + durations[segment.fwd_segment_position]);
+        }
+
+        if (reverse_reached)
+        {
+            // the reverse geometry is stored in the direction of travel
+            const auto durations =
+                facade->GetUncompressedReverseDurations(segment.packed_geometry_id);
+            BOOST_ASSERT(segment.fwd_segment_position < durations.size());
+            const auto reverse_position = durations.size() - segment.fwd_segment_position - 1;
+            const auto v_duration =
+                labels.durations[reverse_id.id] +
+                std::accumulate(
+                    durations.begin(), durations.begin() + reverse_position, EdgeWeight{0});
+            add_reached(v, u, v_duration, v_duration + durations[reverse_position]);
+        }
+    }
+
+    std::vector<std::vector<IsochronePolygon>> contour_polygons(params.contours.size());
+    if (!reached_segments.empty())
+    {
+        const auto width = util::coordinate_calculation::haversineDistance(
+            south_west, util::Coordinate{north_east.lon, south_west.lat});
+        const auto height = util::coordinate_calculation::haversineDistance(
+            south_west, util::Coordinate{south_west.lon, north_east.lat});
+        const auto cell_size = std::max(MIN_CELL_SIZE, std::max(width, height) / CELLS_PER_SIDE);
+
+        IsochroneGrid grid(south_west, north_east, cell_size);
+        for (const auto &segment : reached_segments)
+        {
+            grid.AddSegment(segment.from, segment.to, segment.from_duration, segment.to_duration);
+        }
+
+        for (const auto index : util::irange<std::size_t>(0UL, params.contours.size()))
+        {
+            contour_polygons[index] =
+                grid.Contour(static_cast<EdgeWeight>(std::int64_t{params.contours[index]} * 10));
+        }
+    }
+
+    api::IsochroneAPI isochrone_api{*facade, params};
+    isochrone_api.MakeResponse(source, contour_polygons, result);
+
+    return Status::Ok;
+}
+}
+}
+}
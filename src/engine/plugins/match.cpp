@@ -13,6 +13,7 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -26,6 +27,8 @@ namespace engine
 namespace plugins
 {
 
+const constexpr std::chrono::seconds::rep MatchPlugin::SESSION_TIMEOUT;
+
 // Filters PhantomNodes to obtain a set of viable candiates
 void filterCandidates(const std::vector<util::Coordinate> &coordinates,
                       MatchPlugin::CandidateLists &candidates_lists)
@@ -137,6 +140,124 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDa
             "InvalidValue", "Timestamps need to be monotonically increasing.", json_result);
     }
 
+    if (!parameters.session.empty())
+    {
+        return HandleSessionRequest(facade, parameters, json_result);
+    }
+
+    auto candidates_lists = GetCandidates(*facade, parameters);
+    if (std::all_of(candidates_lists.begin(),
+                    candidates_lists.end(),
+                    [](const std::vector<PhantomNodeWithDistance> &candidates) {
+                        return candidates.empty();
+                    }))
+    {
+        return Error("NoSegment",
+                     std::string("Could not find a matching segment for any coordinate."),
+                     json_result);
+    }
+
+    // call the actual map matching
+    SubMatchingList sub_matchings = map_matching(facade,
+                                                 candidates_lists,
+                                                 parameters.coordinates,
+                                                 parameters.timestamps,
+                                                 parameters.radiuses);
+
+    if (sub_matchings.size() == 0)
+    {
+        return Error("NoMatch", "Could not match the trace.", json_result);
+    }
+
+    const auto sub_routes = GetSubRoutes(facade, sub_matchings);
+
+    api::MatchAPI match_api{*facade, parameters};
+    match_api.MakeResponse(sub_matchings, sub_routes, json_result);
+
+    return Status::Ok;
+}
+
+MatchPlugin::SubMatchingList
+MatchPlugin::MatchTrace(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                        const api::MatchParameters &parameters,
+                        std::vector<InternalRouteResult> &sub_routes) const
+{
+    BOOST_ASSERT(parameters.IsValid() && parameters.session.empty());
+
+    const auto candidates_lists = GetCandidates(*facade, parameters);
+    if (std::all_of(candidates_lists.begin(),
+                    candidates_lists.end(),
+                    [](const std::vector<PhantomNodeWithDistance> &candidates) {
+                        return candidates.empty();
+                    }))
+    {
+        sub_routes.clear();
+        return {};
+    }
+
+    const auto sub_matchings = map_matching(facade,
+                                            candidates_lists,
+                                            parameters.coordinates,
+                                            parameters.timestamps,
+                                            parameters.radiuses);
+    sub_routes = GetSubRoutes(facade, sub_matchings);
+    return sub_matchings;
+}
+
+Status
+MatchPlugin::HandleSessionRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                  const api::MatchParameters &parameters,
+                                  util::json::Object &json_result) const
+{
+    const auto session = sessions.Get(parameters.session, std::chrono::steady_clock::now());
+    if (!session)
+    {
+        return Error("TooBig", "Too many open matching sessions", json_result);
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    auto &state = session->state;
+
+    // candidates of a different dataset can not be matched anymore
+    if (state.checksum != facade->GetCheckSum())
+    {
+        state.Reset(facade->GetCheckSum());
+    }
+
+    if (!parameters.timestamps.empty() && !state.recent_timestamps.empty() &&
+        parameters.timestamps.front() < state.recent_timestamps.back())
+    {
+        return Error("InvalidValue",
+                     "Timestamps need to be monotonically increasing within a session.",
+                     json_result);
+    }
+
+    // the anchor of the session was returned with the previous matchings
+    const unsigned first_unreported_index = state.anchored ? state.window.front().index + 1 : 0;
+
+    const auto candidates_lists = GetCandidates(*facade, parameters);
+    const auto sub_matchings = map_matching.Extend(facade,
+                                                   state,
+                                                   candidates_lists,
+                                                   parameters.coordinates,
+                                                   parameters.timestamps,
+                                                   parameters.radiuses,
+                                                   parameters.finish);
+    if (parameters.finish)
+    {
+        sessions.Remove(parameters.session);
+    }
+
+    const auto sub_routes = GetSubRoutes(facade, sub_matchings);
+
+    api::MatchAPI match_api{*facade, parameters};
+    match_api.MakeSessionResponse(sub_matchings, sub_routes, first_unreported_index, json_result);
+
+    return Status::Ok;
+}
+
+MatchPlugin::CandidateLists MatchPlugin::GetCandidates(const datafacade::BaseDataFacade &facade,
+                                                       const api::MatchParameters &parameters) const
+{
     // assuming radius is the standard deviation of a normal distribution
     // that models GPS noise (in this model), x3 should give us the correct
     // search radius with > 99% confidence
@@ -165,32 +286,17 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDa
                        });
     }
 
-    auto candidates_lists = GetPhantomNodesInRange(*facade, parameters, search_radiuses);
+    auto candidates_lists = GetPhantomNodesInRange(facade, parameters, search_radiuses);
 
     filterCandidates(parameters.coordinates, candidates_lists);
-    if (std::all_of(candidates_lists.begin(),
-                    candidates_lists.end(),
-                    [](const std::vector<PhantomNodeWithDistance> &candidates) {
-                        return candidates.empty();
-                    }))
-    {
-        return Error("NoSegment",
-                     std::string("Could not find a matching segment for any coordinate."),
-                     json_result);
-    }
-
-    // call the actual map matching
-    SubMatchingList sub_matchings = map_matching(facade,
-                                                 candidates_lists,
-                                                 parameters.coordinates,
-                                                 parameters.timestamps,
-                                                 parameters.radiuses);
 
-    if (sub_matchings.size() == 0)
-    {
-        return Error("NoMatch", "Could not match the trace.", json_result);
-    }
+    return candidates_lists;
+}
 
+std::vector<InternalRouteResult>
+MatchPlugin::GetSubRoutes(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                          const SubMatchingList &sub_matchings) const
+{
     std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
     for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
     {
@@ -214,11 +320,7 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDa
             facade, sub_routes[index].segment_end_coordinates, {false}, sub_routes[index]);
         BOOST_ASSERT(sub_routes[index].shortest_path_length != INVALID_EDGE_WEIGHT);
     }
-
-    api::MatchAPI match_api{*facade, parameters};
-    match_api.MakeResponse(sub_matchings, sub_routes, json_result);
-
-    return Status::Ok;
+    return sub_routes;
 }
 }
 }
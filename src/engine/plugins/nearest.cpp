@@ -2,14 +2,21 @@
 #include "engine/api/nearest_api.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/phantom_node.hpp"
+#include "util/hilbert_value.hpp"
 #include "util/integer_range.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
 
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
 namespace osrm
 {
 namespace engine
@@ -17,7 +24,16 @@ namespace engine
 namespace plugins
 {
 
-NearestPlugin::NearestPlugin(const int max_results_) : max_results{max_results_} {}
+namespace
+{
+// number of coordinates that are snapped one after another by the same thread
+const constexpr std::size_t BULK_BATCH_SIZE = 256;
+}
+
+NearestPlugin::NearestPlugin(const int max_results_, const int max_locations_)
+    : max_results{max_results_}, max_locations{max_locations_}
+{
+}
 
 Status NearestPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                                     const api::NearestParameters &params,
@@ -34,12 +50,26 @@ Status NearestPlugin::HandleRequest(const std::shared_ptr<const datafacade::Base
                      json_result);
     }
 
+    if (max_locations > 0 &&
+        (boost::numeric_cast<std::int64_t>(params.coordinates.size()) > max_locations))
+    {
+        return Error("TooBig",
+                     "Number of entries " + std::to_string(params.coordinates.size()) +
+                         " is higher than current maximum (" + std::to_string(max_locations) +
+                         ")",
+                     json_result);
+    }
+
     if (!CheckAllCoordinates(params.coordinates))
         return Error("InvalidOptions", "Coordinates are invalid", json_result);
 
-    if (params.coordinates.size() != 1)
+    api::NearestAPI nearest_api(*facade, params);
+
+    // coordinates without segments nearby have no waypoints in bulk responses
+    if (params.coordinates.size() > 1)
     {
-        return Error("InvalidOptions", "Only one input coordinate is supported", json_result);
+        nearest_api.MakeResponse(GetBulkPhantomNodes(*facade, params), json_result);
+        return Status::Ok;
     }
 
     auto phantom_nodes = GetPhantomNodes(*facade, params, params.number_of_results);
@@ -50,11 +80,38 @@ Status NearestPlugin::HandleRequest(const std::shared_ptr<const datafacade::Base
     }
     BOOST_ASSERT(phantom_nodes.front().size() > 0);
 
-    api::NearestAPI nearest_api(*facade, params);
     nearest_api.MakeResponse(phantom_nodes, json_result);
 
     return Status::Ok;
 }
+
+std::vector<std::vector<PhantomNodeWithDistance>>
+NearestPlugin::GetBulkPhantomNodes(const datafacade::BaseDataFacade &facade,
+                                   const api::NearestParameters &params) const
+{
+    const auto number_of_coordinates = params.coordinates.size();
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> hilbert_order(number_of_coordinates);
+    for (const auto index : util::irange<std::size_t>(0UL, number_of_coordinates))
+    {
+        hilbert_order[index] =
+            std::make_pair(util::GetHilbertCode(params.coordinates[index]), index);
+    }
+    tbb::parallel_sort(hilbert_order.begin(), hilbert_order.end());
+
+    std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(number_of_coordinates);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, number_of_coordinates, BULK_BATCH_SIZE),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto position = range.begin(); position != range.end(); ++position)
+                          {
+                              const auto index = hilbert_order[position].second;
+                              phantom_nodes[index] = GetPhantomNodesOfCoordinate(
+                                  facade, params, index, params.number_of_results);
+                          }
+                      });
+
+    return phantom_nodes;
+}
 }
 }
 }
@@ -0,0 +1,131 @@
+#include "engine/plugins/optimize.hpp"
+
+#include "engine/api/optimize_api.hpp"
+#include "engine/api/optimize_parameters.hpp"
+#include "engine/vehicle_routing.hpp"
+#include "util/dist_table_wrapper.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+OptimizePlugin::OptimizePlugin(const int max_locations_optimize, const int optimize_search_time)
+    : shortest_path(heaps), duration_table(heaps), max_locations_optimize(max_locations_optimize),
+      optimize_search_time(optimize_search_time)
+{
+}
+
+Status OptimizePlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                     const api::OptimizeParameters &parameters,
+                                     util::json::Object &json_result) const
+{
+    BOOST_ASSERT(parameters.IsValid());
+    const auto number_of_locations = parameters.coordinates.size();
+
+    if (max_locations_optimize > 0 &&
+        static_cast<int>(number_of_locations) > max_locations_optimize)
+    {
+        return Error("TooBig", "Too many optimize coordinates", json_result);
+    }
+
+    if (!CheckAllCoordinates(parameters.coordinates))
+    {
+        return Error("InvalidValue", "Invalid coordinate value.", json_result);
+    }
+
+    auto phantom_node_pairs = GetPhantomNodes(*facade, parameters);
+    if (phantom_node_pairs.size() != number_of_locations)
+    {
+        return Error("NoSegment",
+                     std::string("Could not find a matching segment for coordinate ") +
+                         std::to_string(phantom_node_pairs.size()),
+                     json_result);
+    }
+    const auto snapped_phantoms = SnapPhantomNodes(phantom_node_pairs);
+
+    auto durations = util::DistTableWrapper<EdgeWeight>(
+        duration_table(facade, snapped_phantoms, {}, {}), number_of_locations);
+    if (durations.size() == 0)
+    {
+        return Status::Error;
+    }
+
+    auto capacities = parameters.capacities;
+    if (capacities.empty())
+    {
+        capacities.resize(parameters.vehicles, std::numeric_limits<unsigned>::max());
+    }
+    VehicleRoutingProblem problem(std::move(durations), parameters.depot, std::move(capacities));
+    if (!parameters.demands.empty())
+    {
+        problem.demands = parameters.demands;
+        problem.demands[parameters.depot] = 0;
+    }
+    // times are given in seconds, durations are in deciseconds
+    const auto to_deciseconds = [](const unsigned seconds) {
+        return static_cast<EdgeWeight>(std::min<std::int64_t>(
+            std::int64_t{seconds} * 10, std::numeric_limits<EdgeWeight>::max()));
+    };
+    for (const auto location : util::irange<std::size_t>(0UL, parameters.time_windows.size()))
+    {
+        if (const auto &time_window = parameters.time_windows[location])
+        {
+            problem.time_windows[location] = {to_deciseconds(time_window->begin),
+                                              to_deciseconds(time_window->end)};
+        }
+    }
+    for (const auto location : util::irange<std::size_t>(0UL, parameters.service_times.size()))
+    {
+        problem.service_times[location] = to_deciseconds(parameters.service_times[location]);
+    }
+
+    const auto solution = solveVehicleRouting(problem, optimize_search_time);
+
+    std::vector<std::size_t> vehicles;
+    std::vector<InternalRouteResult> vehicle_routes;
+    for (const auto vehicle : util::irange<std::size_t>(0UL, solution.routes.size()))
+    {
+        const auto &stops = solution.routes[vehicle];
+        if (stops.empty())
+        {
+            continue;
+        }
+
+        InternalRouteResult route;
+        auto from = snapped_phantoms[parameters.depot];
+        for (const auto stop : stops)
+        {
+            route.segment_end_coordinates.push_back(PhantomNodes{from, snapped_phantoms[stop]});
+            from = snapped_phantoms[stop];
+        }
+        route.segment_end_coordinates.push_back(
+            PhantomNodes{from, snapped_phantoms[parameters.depot]});
+
+        shortest_path(facade, route.segment_end_coordinates, {false}, route);
+        BOOST_ASSERT_MSG(route.shortest_path_length < INVALID_EDGE_WEIGHT, "unroutable route");
+
+        vehicles.push_back(vehicle);
+        vehicle_routes.push_back(std::move(route));
+    }
+
+    api::OptimizeAPI optimize_api{*facade, parameters};
+    optimize_api.MakeResponse(solution, vehicles, vehicle_routes, snapped_phantoms, json_result);
+
+    return Status::Ok;
+}
+}
+}
+}
@@ -3,6 +3,7 @@
 #include "engine/api/table_api.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/one_to_all.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
 #include "util/string_util.hpp"
@@ -23,8 +24,17 @@ namespace engine
 namespace plugins
 {
 
+namespace
+{
+// A sweep over the whole graph pays off once a row has enough destinations
+// to make a bucket search for each of them more expensive.
+const constexpr std::size_t MIN_ONE_TO_ALL_DESTINATIONS = 100;
+const constexpr std::size_t NODES_PER_ONE_TO_ALL_DESTINATION = 1000;
+}
+
 TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : distance_table(heaps), max_locations_distance_table(max_locations_distance_table)
+    : distance_table(heaps), one_to_all_table(heaps),
+      max_locations_distance_table(max_locations_distance_table)
 {
 }
 
@@ -60,8 +70,17 @@ Status TablePlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDa
     }
 
     auto snapped_phantoms = SnapPhantomNodes(GetPhantomNodes(*facade, params));
+
+    const auto use_one_to_all =
+        routing_algorithms::OneToAllRouting::IsAvailable(*facade) &&
+        num_destinations >= std::max<std::size_t>(MIN_ONE_TO_ALL_DESTINATIONS,
+                                                  facade->GetNumberOfNodes() /
+                                                      NODES_PER_ONE_TO_ALL_DESTINATION);
+
     auto result_table =
-        distance_table(facade, snapped_phantoms, params.sources, params.destinations);
+        use_one_to_all
+            ? one_to_all_table(facade, snapped_phantoms, params.sources, params.destinations)
+            : distance_table(facade, snapped_phantoms, params.sources, params.destinations);
 
     if (result_table.empty())
     {
@@ -2,8 +2,9 @@
 
 #include "engine/api/trip_api.hpp"
 #include "engine/api/trip_parameters.hpp"
-#include "engine/trip/trip_brute_force.hpp"
 #include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
 #include "engine/trip/trip_nearest_neighbour.hpp"
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
@@ -209,7 +210,7 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDat
         return Status::Error;
     }
 
-    const constexpr std::size_t BF_MAX_FEASABLE = 10;
+    const constexpr std::size_t HELD_KARP_MAX_FEASABLE = 17;
     BOOST_ASSERT_MSG(result_table.size() == number_of_locations * number_of_locations,
                      "Distance Table has wrong size");
 
@@ -226,13 +227,13 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<const datafacade::BaseDat
     std::vector<NodeID> trip;
     trip.reserve(number_of_locations);
     // get an optimized order in which the destinations should be visited
-    if (number_of_locations < BF_MAX_FEASABLE)
+    if (number_of_locations < HELD_KARP_MAX_FEASABLE)
     {
-        trip = trip::BruteForceTrip(number_of_locations, result_table);
+        trip = trip::HeldKarpTrip(number_of_locations, result_table);
     }
     else
     {
-        trip = trip::FarthestInsertionTrip(number_of_locations, result_table);
+        trip = trip::LocalSearchTrip(number_of_locations, result_table, trip_search_time);
     }
 
     // rotate result such that roundtrip starts at node with index 0
@@ -21,9 +21,9 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute, int max_alternatives)
     : shortest_path(heaps), alternative_path(heaps), direct_shortest_path(heaps),
-      max_locations_viaroute(max_locations_viaroute)
+      max_locations_viaroute(max_locations_viaroute), max_alternatives(max_alternatives)
 {
 }
 
@@ -43,6 +43,17 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<const datafacade::Bas
                      json_result);
     }
 
+    if (max_alternatives >= 0 &&
+        route_parameters.number_of_alternatives > static_cast<unsigned>(max_alternatives))
+    {
+        return Error("TooBig",
+                     "Number of alternatives " +
+                         std::to_string(route_parameters.number_of_alternatives) +
+                         " is higher than current maximum (" + std::to_string(max_alternatives) +
+                         ")",
+                     json_result);
+    }
+
     if (!CheckAllCoordinates(route_parameters.coordinates))
     {
         return Error("InvalidValue", "Invalid coordinate value.", json_result);
@@ -88,7 +99,10 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<const datafacade::Bas
     {
         if (route_parameters.alternatives && facade->GetCoreSize() == 0)
         {
-            alternative_path(facade, raw_route.segment_end_coordinates.front(), raw_route);
+            alternative_path(facade,
+                             raw_route.segment_end_coordinates.front(),
+                             std::max(1u, route_parameters.number_of_alternatives),
+                             raw_route);
         }
         else
         {
@@ -1,4 +1,12 @@
 #include "engine/routing_algorithms/alternative_path.hpp"
+#include "engine/edge_unpacker.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cstdint>
+#include <thread>
+#include <unordered_set>
 
 namespace osrm
 {
@@ -7,24 +15,66 @@ namespace engine
 namespace routing_algorithms
 {
 
+namespace
+{
+using EdgeSet = std::unordered_set<std::uint64_t>;
+
+std::uint64_t makeEdgeKey(const std::pair<NodeID, NodeID> &edge)
+{
+    return (static_cast<std::uint64_t>(edge.first) << 32) | edge.second;
+}
+
+// Weight of the original edges of a packed path that are part of a selected alternative
+int computeSharingWithAlternatives(const datafacade::BaseDataFacade &facade,
+                                   const std::vector<NodeID> &packed_path,
+                                   const EdgeSet &edges_on_alternatives)
+{
+    int sharing = 0;
+    UnpackCHPath(facade,
+                 packed_path.begin(),
+                 packed_path.end(),
+                 [&](const std::pair<NodeID, NodeID> &edge, const auto &data) {
+                     if (edges_on_alternatives.count(makeEdgeKey(edge)) > 0)
+                         sharing += data.weight;
+                 });
+    return sharing;
+}
+
+void insertUnpackedPath(const datafacade::BaseDataFacade &facade,
+                        const std::vector<NodeID> &packed_path,
+                        std::unordered_set<NodeID> &nodes_on_alternatives,
+                        EdgeSet &edges_on_alternatives)
+{
+    UnpackCHPath(facade,
+                 packed_path.begin(),
+                 packed_path.end(),
+                 [&](const std::pair<NodeID, NodeID> &edge, const auto & /* data */) {
+                     nodes_on_alternatives.insert(edge.first);
+                     nodes_on_alternatives.insert(edge.second);
+                     edges_on_alternatives.insert(makeEdgeKey(edge));
+                 });
+}
+}
+
 void AlternativeRouting::operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
                                     const PhantomNodes &phantom_node_pair,
+                                    const unsigned number_of_alternatives,
                                     InternalRouteResult &raw_route_data)
 {
+    BOOST_ASSERT(number_of_alternatives > 0);
+
     std::vector<NodeID> alternative_path;
     std::vector<NodeID> via_node_candidate_list;
     std::vector<SearchSpaceEdge> forward_search_space;
     std::vector<SearchSpaceEdge> reverse_search_space;
 
-    // Init queues, semi-expensive because access to TSS invokes a sys-call
+    // Init queues, semi-expensive because access to TSS invokes a sys-call.
+    // The second and third heaps are initialized by the candidate tests, which may run on
+    // other threads.
     engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade->GetNumberOfNodes());
-    engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade->GetNumberOfNodes());
-    engine_working_data.InitializeOrClearThirdThreadLocalStorage(facade->GetNumberOfNodes());
 
     QueryHeap &forward_heap1 = *(engine_working_data.forward_heap_1);
     QueryHeap &reverse_heap1 = *(engine_working_data.reverse_heap_1);
-    QueryHeap &forward_heap2 = *(engine_working_data.forward_heap_2);
-    QueryHeap &reverse_heap2 = *(engine_working_data.reverse_heap_2);
 
     EdgeWeight upper_bound_to_shortest_path_weight = INVALID_EDGE_WEIGHT;
     NodeID middle_node = SPECIAL_NODEID;
@@ -219,48 +269,115 @@ void AlternativeRouting::operator()(const std::shared_ptr<const datafacade::Base
         packed_shortest_path.insert(
             packed_shortest_path.end(), packed_reverse_path.begin(), packed_reverse_path.end());
     }
-    std::vector<RankedCandidateNode> ranked_candidates_list;
 
-    // prioritizing via nodes for deep inspection
-    for (const NodeID node : preselected_node_list)
+    // prioritizing via nodes for deep inspection. The candidates only read the search spaces
+    // of the shortest path query, so they are inspected in parallel.
+    std::vector<int> lengths_of_via_paths(preselected_node_list.size(), 0);
+    std::vector<int> sharings_of_via_paths(preselected_node_list.size(), 0);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, preselected_node_list.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              ComputeLengthAndSharingOfViaPath(facade,
+                                                               forward_heap1,
+                                                               reverse_heap1,
+                                                               preselected_node_list[index],
+                                                               &lengths_of_via_paths[index],
+                                                               &sharings_of_via_paths[index],
+                                                               packed_shortest_path,
+                                                               min_edge_offset);
+                          }
+                      });
+
+    std::vector<RankedCandidateNode> ranked_candidates_list;
+    const int maximum_allowed_sharing =
+        static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
+    for (const auto index : util::irange<std::size_t>(0UL, preselected_node_list.size()))
     {
-        int length_of_via_path = 0, sharing_of_via_path = 0;
-        ComputeLengthAndSharingOfViaPath(facade,
-                                         node,
-                                         &length_of_via_path,
-                                         &sharing_of_via_path,
-                                         packed_shortest_path,
-                                         min_edge_offset);
-        const int maximum_allowed_sharing =
-            static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
-        if (sharing_of_via_path <= maximum_allowed_sharing &&
-            length_of_via_path <= upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON))
+        const int length_of_via_path = lengths_of_via_paths[index];
+        const int sharing_of_via_path = sharings_of_via_paths[index];
+        const bool length_passes =
+            length_of_via_path <= upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON);
+        const bool sharing_passes = sharing_of_via_path <= maximum_allowed_sharing;
+        // same stretch criterion as the preselection, with the exact values this time. Every
+        // candidate dropped here saves a T-test.
+        const bool stretch_passes =
+            (length_of_via_path - sharing_of_via_path) <
+            ((1. + VIAPATH_ALPHA) * (upper_bound_to_shortest_path_weight - sharing_of_via_path));
+
+        if (length_passes && sharing_passes && stretch_passes)
         {
-            ranked_candidates_list.emplace_back(node, length_of_via_path, sharing_of_via_path);
+            ranked_candidates_list.emplace_back(
+                preselected_node_list[index], length_of_via_path, sharing_of_via_path);
         }
     }
     std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
 
-    NodeID selected_via_node = SPECIAL_NODEID;
-    int length_of_via_path = INVALID_EDGE_WEIGHT;
-    NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
-    for (const RankedCandidateNode &candidate : ranked_candidates_list)
-    {
-        if (ViaNodeCandidatePassesTTest(facade,
-                                        forward_heap1,
-                                        reverse_heap1,
-                                        forward_heap2,
-                                        reverse_heap2,
-                                        candidate,
-                                        upper_bound_to_shortest_path_weight,
-                                        &length_of_via_path,
-                                        &s_v_middle,
-                                        &v_t_middle,
-                                        min_edge_offset))
+    // We select the alternatives among the best ranked candidates. Their T-tests run in
+    // parallel in batches, then the candidates of a batch are accepted in rank order if they
+    // passed and differ enough from the alternatives accepted so far. The number of T-tests is
+    // bounded by the number of requested alternatives.
+    // Via nodes on an accepted alternative lie on its plateau and would lead to the same route,
+    // so they are skipped without a T-test.
+    const std::size_t batch_size = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t max_number_of_t_tests = number_of_alternatives * VIAPATH_MAX_T_TESTS;
+    std::vector<int> lengths_of_alternatives(ranked_candidates_list.size(), INVALID_EDGE_WEIGHT);
+    // only the candidates that pass their T-test have a packed path
+    std::vector<std::vector<NodeID>> packed_alternate_paths(ranked_candidates_list.size());
+    std::vector<std::size_t> selected_candidates;
+    std::unordered_set<NodeID> nodes_on_alternatives;
+    EdgeSet edges_on_alternatives;
+
+    std::size_t next_candidate = 0;
+    std::size_t number_of_t_tests = 0;
+    while (selected_candidates.size() < number_of_alternatives &&
+           next_candidate < ranked_candidates_list.size() &&
+           number_of_t_tests < max_number_of_t_tests)
+    {
+        std::vector<std::size_t> batch;
+        for (; next_candidate < ranked_candidates_list.size() && batch.size() < batch_size &&
+               number_of_t_tests + batch.size() < max_number_of_t_tests;
+             ++next_candidate)
         {
-            // select first admissable
-            selected_via_node = candidate.node;
-            break;
+            if (nodes_on_alternatives.count(ranked_candidates_list[next_candidate].node) == 0)
+            {
+                batch.push_back(next_candidate);
+            }
+        }
+        number_of_t_tests += batch.size();
+
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, batch.size(), 1),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto position = range.begin(); position != range.end();
+                                   ++position)
+                              {
+                                  const auto index = batch[position];
+                                  ViaNodeCandidatePassesTTest(facade,
+                                                              forward_heap1,
+                                                              reverse_heap1,
+                                                              ranked_candidates_list[index],
+                                                              upper_bound_to_shortest_path_weight,
+                                                              &lengths_of_alternatives[index],
+                                                              packed_alternate_paths[index],
+                                                              min_edge_offset);
+                              }
+                          });
+
+        for (const auto index : batch)
+        {
+            const auto &packed_alternate_path = packed_alternate_paths[index];
+            if (selected_candidates.size() == number_of_alternatives)
+                break;
+            if (packed_alternate_path.empty() ||
+                nodes_on_alternatives.count(ranked_candidates_list[index].node) > 0)
+                continue;
+            if (computeSharingWithAlternatives(
+                    *facade, packed_alternate_path, edges_on_alternatives) > maximum_allowed_sharing)
+                continue;
+
+            selected_candidates.push_back(index);
+            insertUnpackedPath(
+                *facade, packed_alternate_path, nodes_on_alternatives, edges_on_alternatives);
         }
     }
 
@@ -286,17 +403,9 @@ void AlternativeRouting::operator()(const std::shared_ptr<const datafacade::Base
         raw_route_data.shortest_path_length = upper_bound_to_shortest_path_weight;
     }
 
-    if (SPECIAL_NODEID != selected_via_node)
+    for (const auto index : selected_candidates)
     {
-        std::vector<NodeID> packed_alternate_path;
-        // retrieve alternate path
-        RetrievePackedAlternatePath(forward_heap1,
-                                    reverse_heap1,
-                                    forward_heap2,
-                                    reverse_heap2,
-                                    s_v_middle,
-                                    v_t_middle,
-                                    packed_alternate_path);
+        const auto &packed_alternate_path = packed_alternate_paths[index];
 
         raw_route_data.alt_source_traversed_in_reverse.push_back(
             (packed_alternate_path.front() !=
@@ -306,17 +415,14 @@ void AlternativeRouting::operator()(const std::shared_ptr<const datafacade::Base
              phantom_node_pair.target_phantom.forward_segment_id.id));
 
         // unpack the alternate path
+        raw_route_data.unpacked_alternatives.emplace_back();
         super::UnpackPath(facade,
                           packed_alternate_path.begin(),
                           packed_alternate_path.end(),
                           phantom_node_pair,
-                          raw_route_data.unpacked_alternative);
+                          raw_route_data.unpacked_alternatives.back());
 
-        raw_route_data.alternative_path_length = length_of_via_path;
-    }
-    else
-    {
-        BOOST_ASSERT(raw_route_data.alternative_path_length == INVALID_EDGE_WEIGHT);
+        raw_route_data.alternative_path_lengths.push_back(lengths_of_alternatives[index]);
     }
 }
 
@@ -345,16 +451,16 @@ void AlternativeRouting::RetrievePackedAlternatePath(const QueryHeap &forward_he
 // done at this stage
 void AlternativeRouting::ComputeLengthAndSharingOfViaPath(
     const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+    const QueryHeap &existing_forward_heap,
+    const QueryHeap &existing_reverse_heap,
     const NodeID via_node,
     int *real_length_of_via_path,
     int *sharing_of_via_path,
     const std::vector<NodeID> &packed_shortest_path,
-    const EdgeWeight min_edge_offset)
+    const EdgeWeight min_edge_offset) const
 {
     engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade->GetNumberOfNodes());
 
-    QueryHeap &existing_forward_heap = *engine_working_data.forward_heap_1;
-    QueryHeap &existing_reverse_heap = *engine_working_data.reverse_heap_1;
     QueryHeap &new_forward_heap = *engine_working_data.forward_heap_2;
     QueryHeap &new_reverse_heap = *engine_working_data.reverse_heap_2;
 
@@ -515,23 +621,22 @@ void AlternativeRouting::ComputeLengthAndSharingOfViaPath(
 // conduct T-Test
 bool AlternativeRouting::ViaNodeCandidatePassesTTest(
     const std::shared_ptr<const datafacade::BaseDataFacade> facade,
-    QueryHeap &existing_forward_heap,
-    QueryHeap &existing_reverse_heap,
-    QueryHeap &new_forward_heap,
-    QueryHeap &new_reverse_heap,
+    const QueryHeap &existing_forward_heap,
+    const QueryHeap &existing_reverse_heap,
     const RankedCandidateNode &candidate,
     const int length_of_shortest_path,
     int *length_of_via_path,
-    NodeID *s_v_middle,
-    NodeID *v_t_middle,
+    std::vector<NodeID> &packed_alternate_path,
     const EdgeWeight min_edge_offset) const
 {
-    new_forward_heap.Clear();
-    new_reverse_heap.Clear();
+    engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade->GetNumberOfNodes());
+
+    QueryHeap &new_forward_heap = *engine_working_data.forward_heap_2;
+    QueryHeap &new_reverse_heap = *engine_working_data.reverse_heap_2;
     std::vector<NodeID> packed_s_v_path;
     std::vector<NodeID> packed_v_t_path;
 
-    *s_v_middle = SPECIAL_NODEID;
+    NodeID s_v_middle = SPECIAL_NODEID;
     int upper_bound_s_v_path_length = INVALID_EDGE_WEIGHT;
     // compute path <s,..,v> by reusing forward search from s
     new_reverse_heap.Insert(candidate.node, 0, candidate.node);
@@ -542,7 +647,7 @@ bool AlternativeRouting::ViaNodeCandidatePassesTTest(
         super::RoutingStep(facade,
                            new_reverse_heap,
                            existing_forward_heap,
-                           *s_v_middle,
+                           s_v_middle,
                            upper_bound_s_v_path_length,
                            min_edge_offset,
                            false,
@@ -557,7 +662,7 @@ bool AlternativeRouting::ViaNodeCandidatePassesTTest(
     }
 
     // compute path <v,..,t> by reusing backward search from t
-    *v_t_middle = SPECIAL_NODEID;
+    NodeID v_t_middle = SPECIAL_NODEID;
     int upper_bound_of_v_t_path_length = INVALID_EDGE_WEIGHT;
     new_forward_heap.Insert(candidate.node, 0, candidate.node);
     while (new_forward_heap.Size() > 0)
@@ -565,7 +670,7 @@ bool AlternativeRouting::ViaNodeCandidatePassesTTest(
         super::RoutingStep(facade,
                            new_forward_heap,
                            existing_reverse_heap,
-                           *v_t_middle,
+                           v_t_middle,
                            upper_bound_of_v_t_path_length,
                            min_edge_offset,
                            true,
@@ -583,12 +688,12 @@ bool AlternativeRouting::ViaNodeCandidatePassesTTest(
 
     // retrieve packed paths
     super::RetrievePackedPathFromHeap(
-        existing_forward_heap, new_reverse_heap, *s_v_middle, packed_s_v_path);
+        existing_forward_heap, new_reverse_heap, s_v_middle, packed_s_v_path);
 
     super::RetrievePackedPathFromHeap(
-        new_forward_heap, existing_reverse_heap, *v_t_middle, packed_v_t_path);
+        new_forward_heap, existing_reverse_heap, v_t_middle, packed_v_t_path);
 
-    NodeID s_P = *s_v_middle, t_P = *v_t_middle;
+    NodeID s_P = s_v_middle, t_P = v_t_middle;
     if (SPECIAL_NODEID == s_P)
     {
         return false;
@@ -762,9 +867,21 @@ bool AlternativeRouting::ViaNodeCandidatePassesTTest(
                                DO_NOT_FORCE_LOOPS);
         }
     }
-    return (upper_bound <= t_test_path_length);
+    if (upper_bound > t_test_path_length)
+    {
+        return false;
+    }
+
+    RetrievePackedAlternatePath(existing_forward_heap,
+                                existing_reverse_heap,
+                                new_forward_heap,
+                                new_reverse_heap,
+                                s_v_middle,
+                                v_t_middle,
+                                packed_alternate_path);
+    return true;
 }
 
 } // namespace routing_algorithms
 } // namespace engine
-} // namespace osrm}
+} // namespace osrm
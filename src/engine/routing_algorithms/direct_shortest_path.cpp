@@ -101,7 +101,7 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
     if (INVALID_EDGE_WEIGHT == weight)
     {
         raw_route_data.shortest_path_length = INVALID_EDGE_WEIGHT;
-        raw_route_data.alternative_path_length = INVALID_EDGE_WEIGHT;
+        raw_route_data.alternative_path_lengths.clear();
         return;
     }
 
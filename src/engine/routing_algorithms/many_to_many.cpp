@@ -1,5 +1,7 @@
 #include "engine/routing_algorithms/many_to_many.hpp"
 
+#include <algorithm>
+
 namespace osrm
 {
 namespace engine
@@ -30,27 +32,7 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
 
     unsigned column_idx = 0;
     const auto search_target_phantom = [&](const PhantomNode &phantom) {
-        query_heap.Clear();
-        // insert target(s) at weight 0
-
-        if (phantom.forward_segment_id.enabled)
-        {
-            query_heap.Insert(phantom.forward_segment_id.id,
-                              phantom.GetForwardWeightPlusOffset(),
-                              {phantom.forward_segment_id.id, phantom.GetForwardDuration()});
-        }
-        if (phantom.reverse_segment_id.enabled)
-        {
-            query_heap.Insert(phantom.reverse_segment_id.id,
-                              phantom.GetReverseWeightPlusOffset(),
-                              {phantom.reverse_segment_id.id, phantom.GetReverseDuration()});
-        }
-
-        // explore search space
-        while (!query_heap.Empty())
-        {
-            BackwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
-        }
+        SearchTarget(facade, column_idx, phantom, query_heap, search_space_with_buckets);
         ++column_idx;
     };
 
@@ -122,6 +104,144 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
     return durations_table;
 }
 
+void ManyToManyRouting::SearchTarget(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                     const unsigned column_idx,
+                                     const PhantomNode &phantom,
+                                     QueryHeap &query_heap,
+                                     SearchSpaceWithBuckets &search_space_with_buckets) const
+{
+    query_heap.Clear();
+    // insert target(s) at weight 0
+
+    if (phantom.forward_segment_id.enabled)
+    {
+        query_heap.Insert(phantom.forward_segment_id.id,
+                          phantom.GetForwardWeightPlusOffset(),
+                          {phantom.forward_segment_id.id, phantom.GetForwardDuration()});
+    }
+    if (phantom.reverse_segment_id.enabled)
+    {
+        query_heap.Insert(phantom.reverse_segment_id.id,
+                          phantom.GetReverseWeightPlusOffset(),
+                          {phantom.reverse_segment_id.id, phantom.GetReverseDuration()});
+    }
+
+    // explore search space
+    while (!query_heap.Empty())
+    {
+        BackwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
+    }
+}
+
+void ManyToManyRouting::SearchSourceWithMiddleNodes(
+    const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+    const PhantomNode &phantom,
+    QueryHeap &query_heap,
+    const SearchSpaceWithBuckets &search_space_with_buckets,
+    std::vector<EdgeWeight> &weights,
+    std::vector<NodeID> &middle_nodes) const
+{
+    std::fill(weights.begin(), weights.end(), INVALID_EDGE_WEIGHT);
+    std::fill(middle_nodes.begin(), middle_nodes.end(), SPECIAL_NODEID);
+
+    query_heap.Clear();
+    if (phantom.forward_segment_id.enabled)
+    {
+        query_heap.Insert(phantom.forward_segment_id.id,
+                          -phantom.GetForwardWeightPlusOffset(),
+                          {phantom.forward_segment_id.id, -phantom.GetForwardDuration()});
+    }
+    if (phantom.reverse_segment_id.enabled)
+    {
+        query_heap.Insert(phantom.reverse_segment_id.id,
+                          -phantom.GetReverseWeightPlusOffset(),
+                          {phantom.reverse_segment_id.id, -phantom.GetReverseDuration()});
+    }
+
+    while (!query_heap.Empty())
+    {
+        const NodeID node = query_heap.DeleteMin();
+        const EdgeWeight source_weight = query_heap.GetKey(node);
+        const EdgeWeight source_duration = query_heap.GetData(node).duration;
+
+        const auto bucket_iterator = search_space_with_buckets.find(node);
+        if (bucket_iterator != search_space_with_buckets.end())
+        {
+            for (const NodeBucket &current_bucket : bucket_iterator->second)
+            {
+                const unsigned column_idx = current_bucket.target_id;
+                EdgeWeight new_weight = source_weight + current_bucket.weight;
+                if (new_weight < 0)
+                {
+                    // source and target are on the same segment, the path needs a loop
+                    const EdgeWeight loop_weight = super::GetLoopWeight<false>(facade, node);
+                    if (loop_weight == INVALID_EDGE_WEIGHT)
+                    {
+                        continue;
+                    }
+                    new_weight += loop_weight;
+                }
+
+                if (new_weight >= 0 && new_weight < weights[column_idx])
+                {
+                    weights[column_idx] = new_weight;
+                    middle_nodes[column_idx] = node;
+                }
+            }
+        }
+
+        if (StallAtNode<true>(facade, node, source_weight, query_heap))
+        {
+            continue;
+        }
+        RelaxOutgoingEdges<true>(facade, node, source_weight, source_duration, query_heap);
+    }
+}
+
+void ManyToManyRouting::RetrievePackedPath(const QueryHeap &query_heap,
+                                           const SearchSpaceWithBuckets &search_space_with_buckets,
+                                           const unsigned column_idx,
+                                           const EdgeWeight weight,
+                                           const NodeID middle_node,
+                                           std::vector<NodeID> &packed_path) const
+{
+    const auto get_bucket = [&](const NodeID node) -> const NodeBucket & {
+        const auto &bucket_list = search_space_with_buckets.at(node);
+        const auto bucket = std::find_if(
+            bucket_list.begin(), bucket_list.end(), [column_idx](const NodeBucket &bucket) {
+                return bucket.target_id == column_idx;
+            });
+        BOOST_ASSERT(bucket != bucket_list.end());
+        return *bucket;
+    };
+
+    // self loop makes up the full path
+    if (weight != query_heap.GetKey(middle_node) + get_bucket(middle_node).weight)
+    {
+        packed_path.push_back(middle_node);
+        packed_path.push_back(middle_node);
+        return;
+    }
+
+    // [source, middle_node] from the heap, the roots of a search are their own parents
+    NodeID current_node = middle_node;
+    packed_path.push_back(current_node);
+    while (current_node != query_heap.GetData(current_node).parent)
+    {
+        current_node = query_heap.GetData(current_node).parent;
+        packed_path.push_back(current_node);
+    }
+    std::reverse(packed_path.begin(), packed_path.end());
+
+    // (middle_node, target] from the buckets
+    current_node = middle_node;
+    while (current_node != get_bucket(current_node).parent_node)
+    {
+        current_node = get_bucket(current_node).parent_node;
+        packed_path.push_back(current_node);
+    }
+}
+
 void ManyToManyRouting::ForwardRoutingStep(
     const std::shared_ptr<const datafacade::BaseDataFacade> facade,
     const unsigned row_idx,
@@ -190,7 +310,8 @@ void ManyToManyRouting::BackwardRoutingStep(
     const EdgeWeight target_duration = query_heap.GetData(node).duration;
 
     // store settled nodes in search space bucket
-    search_space_with_buckets[node].emplace_back(column_idx, target_weight, target_duration);
+    search_space_with_buckets[node].emplace_back(
+        column_idx, target_weight, target_duration, query_heap.GetData(node).parent);
 
     if (StallAtNode<false>(facade, node, target_weight, query_heap))
     {
@@ -22,6 +22,136 @@ unsigned MapMatching::GetMedianSampleTime(const std::vector<unsigned> &timestamp
     return *median;
 }
 
+bool MapMatching::UpdateTransitions(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                    const CandidateList &prev_candidates,
+                                    const map_matching::Column<const double> prev_viterbi,
+                                    const map_matching::Column<const std::uint8_t> prev_pruned,
+                                    const util::Coordinate prev_coordinate,
+                                    const CandidateList &current_candidates,
+                                    const map_matching::Column<const double> current_emissions,
+                                    const util::Coordinate current_coordinate,
+                                    const double max_distance_delta,
+                                    const map_matching::Column<double> current_viterbi,
+                                    const map_matching::Column<unsigned> current_parents,
+                                    const map_matching::Column<float> current_lengths,
+                                    const map_matching::Column<std::uint8_t> current_pruned) const
+{
+    const auto haversine_distance =
+        util::coordinate_calculation::haversineDistance(prev_coordinate, current_coordinate);
+    // assumes minumum of 0.1 m/s
+    const int duration_upper_bound = ((haversine_distance + max_distance_delta) * 0.25) * 10;
+
+    bool reachable = false;
+
+    // network distances are computed lazily, only for the transitions that can still
+    // improve the viterbi value of their target
+    const auto update_transition = [&](const std::size_t s,
+                                       const std::size_t s_prime,
+                                       const auto &get_network_distance) {
+        const double emission_pr = current_emissions[s_prime];
+        double new_value = prev_viterbi[s] + emission_pr;
+        if (current_viterbi[s_prime] > new_value)
+        {
+            return;
+        }
+
+        const double network_distance = get_network_distance();
+
+        // get distance diff between loc1/2 and locs/s_prime
+        const auto d_t = std::abs(network_distance - haversine_distance);
+
+        // very low probability transition -> prune
+        if (d_t >= max_distance_delta)
+        {
+            return;
+        }
+
+        const double transition_pr = transition_log_probability(d_t);
+        new_value += transition_pr;
+
+        if (new_value > current_viterbi[s_prime])
+        {
+            current_viterbi[s_prime] = new_value;
+            current_parents[s_prime] = s;
+            current_lengths[s_prime] = network_distance;
+            current_pruned[s_prime] = false;
+            reachable = true;
+        }
+    };
+
+    // compute d_t for this timestamp and the next one
+    if (facade->GetCoreSize() > 0)
+    {
+        engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade->GetNumberOfNodes());
+        engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade->GetNumberOfNodes());
+
+        QueryHeap &forward_heap = *(engine_working_data.forward_heap_1);
+        QueryHeap &reverse_heap = *(engine_working_data.reverse_heap_1);
+        QueryHeap &forward_core_heap = *(engine_working_data.forward_heap_2);
+        QueryHeap &reverse_core_heap = *(engine_working_data.reverse_heap_2);
+
+        for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+        {
+            if (prev_pruned[s])
+            {
+                continue;
+            }
+
+            for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
+            {
+                update_transition(s, s_prime, [&] {
+                    forward_heap.Clear();
+                    reverse_heap.Clear();
+                    forward_core_heap.Clear();
+                    reverse_core_heap.Clear();
+                    return super::GetNetworkDistanceWithCore(
+                        facade,
+                        forward_heap,
+                        reverse_heap,
+                        forward_core_heap,
+                        reverse_core_heap,
+                        prev_candidates[s].phantom_node,
+                        current_candidates[s_prime].phantom_node,
+                        duration_upper_bound);
+                });
+            }
+        }
+    }
+    else
+    {
+        // all transitions of this step share the searches from their candidates
+        std::vector<std::size_t> prev_states;
+        std::vector<PhantomNode> prev_phantoms;
+        for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+        {
+            if (!prev_pruned[s])
+            {
+                prev_states.push_back(s);
+                prev_phantoms.push_back(prev_candidates[s].phantom_node);
+            }
+        }
+
+        std::vector<PhantomNode> current_phantoms;
+        current_phantoms.reserve(current_candidates.size());
+        for (const auto &candidate : current_candidates)
+        {
+            current_phantoms.push_back(candidate.phantom_node);
+        }
+
+        many_to_many.ForEachNetworkDistance(
+            facade,
+            prev_phantoms,
+            current_phantoms,
+            [&](const std::size_t prev_state_index,
+                const std::size_t s_prime,
+                const auto &get_network_distance) {
+                update_transition(prev_states[prev_state_index], s_prime, get_network_distance);
+            });
+    }
+
+    return reachable;
+}
+
 SubMatchingList MapMatching::
 operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
            const CandidateLists &candidates_list,
@@ -58,50 +188,16 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
         }
     }();
 
-    std::vector<std::vector<double>> emission_log_probabilities(trace_coordinates.size());
-    if (trace_gps_precision.empty())
+    engine_working_data.InitializeHiddenMarkovModelThreadLocalStorage();
+    HMM &model = *engine_working_data.hidden_markov_model;
+    model.Load(candidates_list);
+    for (auto t = 0UL; t < candidates_list.size(); ++t)
     {
-        for (auto t = 0UL; t < candidates_list.size(); ++t)
-        {
-            emission_log_probabilities[t].resize(candidates_list[t].size());
-            std::transform(candidates_list[t].begin(),
-                           candidates_list[t].end(),
-                           emission_log_probabilities[t].begin(),
-                           [this](const PhantomNodeWithDistance &candidate) {
-                               return default_emission_log_probability(candidate.distance);
-                           });
-        }
+        GetEmissionLogProbabilities(candidates_list[t],
+                                    trace_gps_precision.empty() ? boost::none
+                                                                : trace_gps_precision[t],
+                                    model.EmissionLogProbabilities(t).begin());
     }
-    else
-    {
-        for (auto t = 0UL; t < candidates_list.size(); ++t)
-        {
-            emission_log_probabilities[t].resize(candidates_list[t].size());
-            if (trace_gps_precision[t])
-            {
-                map_matching::EmissionLogProbability emission_log_probability(
-                    *trace_gps_precision[t]);
-                std::transform(
-                    candidates_list[t].begin(),
-                    candidates_list[t].end(),
-                    emission_log_probabilities[t].begin(),
-                    [&emission_log_probability](const PhantomNodeWithDistance &candidate) {
-                        return emission_log_probability(candidate.distance);
-                    });
-            }
-            else
-            {
-                std::transform(candidates_list[t].begin(),
-                               candidates_list[t].end(),
-                               emission_log_probabilities[t].begin(),
-                               [this](const PhantomNodeWithDistance &candidate) {
-                                   return default_emission_log_probability(candidate.distance);
-                               });
-            }
-        }
-    }
-
-    HMM model(candidates_list, emission_log_probabilities);
 
     std::size_t initial_timestamp = model.initialize(0);
     if (initial_timestamp == map_matching::INVALID_STATE)
@@ -109,14 +205,6 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
         return sub_matchings;
     }
 
-    engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade->GetNumberOfNodes());
-    engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade->GetNumberOfNodes());
-
-    QueryHeap &forward_heap = *(engine_working_data.forward_heap_1);
-    QueryHeap &reverse_heap = *(engine_working_data.reverse_heap_1);
-    QueryHeap &forward_core_heap = *(engine_working_data.forward_heap_2);
-    QueryHeap &reverse_core_heap = *(engine_working_data.reverse_heap_2);
-
     std::size_t breakage_begin = map_matching::INVALID_STATE;
     std::vector<std::size_t> split_points;
     std::vector<std::size_t> prev_unbroken_timestamps;
@@ -143,90 +231,22 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
             BOOST_ASSERT(!prev_unbroken_timestamps.empty());
             const std::size_t prev_unbroken_timestamp = prev_unbroken_timestamps.back();
 
-            const auto &prev_viterbi = model.viterbi[prev_unbroken_timestamp];
-            const auto &prev_pruned = model.pruned[prev_unbroken_timestamp];
-            const auto &prev_unbroken_timestamps_list = candidates_list[prev_unbroken_timestamp];
-            const auto &prev_coordinate = trace_coordinates[prev_unbroken_timestamp];
-
-            auto &current_viterbi = model.viterbi[t];
-            auto &current_pruned = model.pruned[t];
-            auto &current_parents = model.parents[t];
-            auto &current_lengths = model.path_distances[t];
-            const auto &current_timestamps_list = candidates_list[t];
-            const auto &current_coordinate = trace_coordinates[t];
-
-            const auto haversine_distance = util::coordinate_calculation::haversineDistance(
-                prev_coordinate, current_coordinate);
-            // assumes minumum of 0.1 m/s
-            const int duration_upper_bound =
-                ((haversine_distance + max_distance_delta) * 0.25) * 10;
-
-            // compute d_t for this timestamp and the next one
-            for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+            if (UpdateTransitions(facade,
+                                  candidates_list[prev_unbroken_timestamp],
+                                  model.Viterbi(prev_unbroken_timestamp),
+                                  model.Pruned(prev_unbroken_timestamp),
+                                  trace_coordinates[prev_unbroken_timestamp],
+                                  candidates_list[t],
+                                  model.EmissionLogProbabilities(t),
+                                  trace_coordinates[t],
+                                  max_distance_delta,
+                                  model.Viterbi(t),
+                                  model.Parents(t),
+                                  model.PathDistances(t),
+                                  model.Pruned(t)))
             {
-                if (prev_pruned[s])
-                {
-                    continue;
-                }
-
-                for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
-                {
-                    const double emission_pr = emission_log_probabilities[t][s_prime];
-                    double new_value = prev_viterbi[s] + emission_pr;
-                    if (current_viterbi[s_prime] > new_value)
-                    {
-                        continue;
-                    }
-
-                    forward_heap.Clear();
-                    reverse_heap.Clear();
-
-                    double network_distance;
-                    if (facade->GetCoreSize() > 0)
-                    {
-                        forward_core_heap.Clear();
-                        reverse_core_heap.Clear();
-                        network_distance = super::GetNetworkDistanceWithCore(
-                            facade,
-                            forward_heap,
-                            reverse_heap,
-                            forward_core_heap,
-                            reverse_core_heap,
-                            prev_unbroken_timestamps_list[s].phantom_node,
-                            current_timestamps_list[s_prime].phantom_node,
-                            duration_upper_bound);
-                    }
-                    else
-                    {
-                        network_distance = super::GetNetworkDistance(
-                            facade,
-                            forward_heap,
-                            reverse_heap,
-                            prev_unbroken_timestamps_list[s].phantom_node,
-                            current_timestamps_list[s_prime].phantom_node);
-                    }
-
-                    // get distance diff between loc1/2 and locs/s_prime
-                    const auto d_t = std::abs(network_distance - haversine_distance);
-
-                    // very low probability transition -> prune
-                    if (d_t >= max_distance_delta)
-                    {
-                        continue;
-                    }
-
-                    const double transition_pr = transition_log_probability(d_t);
-                    new_value += transition_pr;
-
-                    if (new_value > current_viterbi[s_prime])
-                    {
-                        current_viterbi[s_prime] = new_value;
-                        current_parents[s_prime] = std::make_pair(prev_unbroken_timestamp, s);
-                        current_lengths[s_prime] = network_distance;
-                        current_pruned[s_prime] = false;
-                        model.breakage[t] = false;
-                    }
-                }
+                model.breakage[t] = false;
+                model.parent_timestamps[t] = prev_unbroken_timestamp;
             }
 
             if (model.breakage[t])
@@ -309,12 +329,10 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
         }
 
         // loop through the columns, and only compare the last entry
-        const auto max_element_iter =
-            std::max_element(model.viterbi[parent_timestamp_index].begin(),
-                             model.viterbi[parent_timestamp_index].end());
+        const auto last_viterbi = model.Viterbi(parent_timestamp_index);
+        const auto max_element_iter = std::max_element(last_viterbi.begin(), last_viterbi.end());
 
-        std::size_t parent_candidate_index =
-            std::distance(model.viterbi[parent_timestamp_index].begin(), max_element_iter);
+        std::size_t parent_candidate_index = std::distance(last_viterbi.begin(), max_element_iter);
 
         std::deque<std::pair<std::size_t, std::size_t>> reconstructed_indices;
         while (parent_timestamp_index > sub_matching_begin)
@@ -325,14 +343,14 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
             }
 
             reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
-            const auto &next = model.parents[parent_timestamp_index][parent_candidate_index];
+            const auto next_timestamp_index = model.parent_timestamps[parent_timestamp_index];
             // make sure we can never get stuck in this loop
-            if (parent_timestamp_index == next.first)
+            if (parent_timestamp_index == next_timestamp_index)
             {
                 break;
             }
-            parent_timestamp_index = next.first;
-            parent_candidate_index = next.second;
+            parent_candidate_index = model.Parents(parent_timestamp_index)[parent_candidate_index];
+            parent_timestamp_index = next_timestamp_index;
         }
         reconstructed_indices.emplace_front(parent_timestamp_index, parent_candidate_index);
         if (reconstructed_indices.size() < 2)
@@ -352,7 +370,7 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
 
             matching.indices.push_back(timestamp_index);
             matching.nodes.push_back(candidates_list[timestamp_index][location_index].phantom_node);
-            matching_distance += model.path_distances[timestamp_index][location_index];
+            matching_distance += model.PathDistances(timestamp_index)[location_index];
         }
         util::for_each_pair(
             reconstructed_indices,
@@ -371,6 +389,279 @@ operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
     return sub_matchings;
 }
 
+void MapMatching::ConfirmSessionPoints(map_matching::MatchingSession &session,
+                                       const std::size_t last_index,
+                                       const std::size_t last_candidate,
+                                       SubMatchingList &sub_matchings) const
+{
+    auto &window = session.window;
+    BOOST_ASSERT(last_index < window.size());
+
+    // matchings that only consist of one candidate are invalid
+    if (last_index == 0)
+    {
+        return;
+    }
+
+    std::vector<std::size_t> path(last_index + 1);
+    path[last_index] = last_candidate;
+    for (auto index = last_index; index > 0; --index)
+    {
+        path[index - 1] = window[index].parents[path[index]];
+    }
+
+    map_matching::SubMatching matching;
+    matching.nodes.reserve(path.size());
+    matching.indices.reserve(path.size());
+    auto matching_distance = 0.0;
+    auto trace_distance = 0.0;
+    for (const auto index : util::irange<std::size_t>(0UL, path.size()))
+    {
+        const auto &point = window[index];
+        matching.indices.push_back(point.index);
+        matching.nodes.push_back(point.candidates[path[index]].phantom_node);
+        if (index > 0)
+        {
+            matching_distance += point.path_distances[path[index]];
+            trace_distance += util::coordinate_calculation::haversineDistance(
+                window[index - 1].coordinate, point.coordinate);
+        }
+    }
+    matching.confidence = confidence(trace_distance, matching_distance);
+    sub_matchings.push_back(std::move(matching));
+
+    // paths that do not pass the confirmed candidate can not be extended anymore
+    auto &latest = window.back();
+    for (const auto s : util::irange<std::size_t>(0UL, latest.viterbi.size()))
+    {
+        if (latest.pruned[s])
+        {
+            continue;
+        }
+
+        auto candidate = s;
+        for (auto index = window.size() - 1; index > last_index; --index)
+        {
+            candidate = window[index].parents[candidate];
+        }
+        if (candidate != last_candidate)
+        {
+            latest.viterbi[s] = map_matching::IMPOSSIBLE_LOG_PROB;
+            latest.pruned[s] = true;
+        }
+    }
+
+    // the confirmed trace point anchors the matching of the next trace points
+    window.erase(window.begin(), window.begin() + last_index);
+    auto &anchor = window.front();
+    for (const auto s : util::irange<std::size_t>(0UL, anchor.viterbi.size()))
+    {
+        anchor.pruned[s] = s != last_candidate;
+    }
+    session.anchored = true;
+}
+
+SubMatchingList MapMatching::Extend(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                                    map_matching::MatchingSession &session,
+                                    const CandidateLists &candidates_list,
+                                    const std::vector<util::Coordinate> &trace_coordinates,
+                                    const std::vector<unsigned> &trace_timestamps,
+                                    const std::vector<boost::optional<double>> &trace_gps_precision,
+                                    const bool finish) const
+{
+    BOOST_ASSERT(candidates_list.size() == trace_coordinates.size());
+    BOOST_ASSERT(trace_timestamps.empty() || trace_timestamps.size() == trace_coordinates.size());
+
+    SubMatchingList sub_matchings;
+    auto &window = session.window;
+
+    // confirms the remaining trace points along the most likely path
+    const auto confirm_best_path = [&] {
+        if (!window.empty())
+        {
+            const auto &latest = window.back();
+            const auto best_candidate =
+                std::distance(latest.viterbi.begin(),
+                              std::max_element(latest.viterbi.begin(), latest.viterbi.end()));
+            ConfirmSessionPoints(session, window.size() - 1, best_candidate, sub_matchings);
+        }
+        window.clear();
+        session.anchored = false;
+        session.broken_points = 0;
+    };
+
+    for (const auto t : util::irange<std::size_t>(0UL, candidates_list.size()))
+    {
+        map_matching::MatchingSession::TracePoint point;
+        point.index = session.number_of_points++;
+        point.coordinate = trace_coordinates[t];
+        if (!trace_timestamps.empty())
+        {
+            point.timestamp = trace_timestamps[t];
+            session.recent_timestamps.push_back(trace_timestamps[t]);
+            if (session.recent_timestamps.size() > MAX_BROKEN_STATES + 1)
+            {
+                session.recent_timestamps.pop_front();
+            }
+        }
+        point.candidates = candidates_list[t];
+
+        const auto number_of_candidates = point.candidates.size();
+        std::vector<double> emission_log_probabilities(number_of_candidates);
+        GetEmissionLogProbabilities(point.candidates,
+                                    trace_gps_precision.empty() ? boost::none
+                                                                : trace_gps_precision[t],
+                                    emission_log_probabilities.begin());
+        point.viterbi.resize(number_of_candidates, map_matching::IMPOSSIBLE_LOG_PROB);
+        point.parents.resize(number_of_candidates, 0);
+        point.path_distances.resize(number_of_candidates, 0);
+        point.pruned.resize(number_of_candidates, true);
+
+        // the sample time is estimated from the latest trace points only
+        const bool use_timestamps = point.timestamp && session.recent_timestamps.size() > 1;
+        const auto median_sample_time = [&] {
+            if (use_timestamps)
+            {
+                return std::max(1u,
+                                GetMedianSampleTime(std::vector<unsigned>(
+                                    session.recent_timestamps.begin(),
+                                    session.recent_timestamps.end())));
+            }
+            else
+            {
+                return 1u;
+            }
+        }();
+        const auto max_distance_delta = [&] {
+            if (use_timestamps)
+            {
+                return median_sample_time * facade->GetMapMatchingMaxSpeed();
+            }
+            else
+            {
+                return MAX_DISTANCE_DELTA;
+            }
+        }();
+
+        if (!window.empty())
+        {
+            const auto &prev = window.back();
+            const bool gap_in_trace = [&] {
+                if (use_timestamps && prev.timestamp)
+                {
+                    return *point.timestamp - *prev.timestamp >
+                           median_sample_time * MAX_BROKEN_STATES;
+                }
+                else
+                {
+                    return session.broken_points >= MAX_BROKEN_STATES;
+                }
+            }();
+
+            if (!gap_in_trace)
+            {
+                if (UpdateTransitions(facade,
+                                      prev.candidates,
+                                      map_matching::makeColumn(prev.viterbi),
+                                      map_matching::makeColumn(prev.pruned),
+                                      prev.coordinate,
+                                      point.candidates,
+                                      map_matching::makeColumn(emission_log_probabilities),
+                                      point.coordinate,
+                                      max_distance_delta,
+                                      map_matching::makeColumn(point.viterbi),
+                                      map_matching::makeColumn(point.parents),
+                                      map_matching::makeColumn(point.path_distances),
+                                      map_matching::makeColumn(point.pruned)))
+                {
+                    window.push_back(std::move(point));
+                    session.broken_points = 0;
+                }
+                else
+                {
+                    // outlier, the next trace point is matched to the previous one
+                    ++session.broken_points;
+                }
+                continue;
+            }
+
+            confirm_best_path();
+        }
+
+        // start a new matching at this trace point
+        for (const auto s : util::irange<std::size_t>(0UL, number_of_candidates))
+        {
+            point.viterbi[s] = emission_log_probabilities[s];
+            point.parents[s] = s;
+            point.pruned[s] = point.viterbi[s] < map_matching::MINIMAL_LOG_PROB;
+        }
+        if (std::all_of(point.pruned.begin(), point.pruned.end(), [](const std::uint8_t pruned) {
+                return pruned != 0;
+            }))
+        {
+            continue;
+        }
+        window.push_back(std::move(point));
+        session.broken_points = 0;
+    }
+
+    if (finish)
+    {
+        confirm_best_path();
+        return sub_matchings;
+    }
+
+    if (window.empty())
+    {
+        return sub_matchings;
+    }
+
+    // Find the latest trace point on which all paths that can still be extended agree
+    std::vector<std::size_t> alive;
+    for (const auto s : util::irange<std::size_t>(0UL, window.back().viterbi.size()))
+    {
+        if (!window.back().pruned[s])
+        {
+            alive.push_back(s);
+        }
+    }
+    BOOST_ASSERT(!alive.empty());
+
+    auto index = window.size() - 1;
+    while (alive.size() > 1 && index > 0)
+    {
+        for (auto &candidate : alive)
+        {
+            candidate = window[index].parents[candidate];
+        }
+        std::sort(alive.begin(), alive.end());
+        alive.erase(std::unique(alive.begin(), alive.end()), alive.end());
+        --index;
+    }
+
+    if (alive.size() == 1)
+    {
+        ConfirmSessionPoints(session, index, alive.front(), sub_matchings);
+    }
+    else if (window.size() > MAX_UNCONFIRMED_POINTS)
+    {
+        // the paths did not converge, confirm the older half of the window along the most
+        // likely path to bound the state of the session
+        const auto &latest = window.back();
+        std::size_t candidate =
+            std::distance(latest.viterbi.begin(),
+                          std::max_element(latest.viterbi.begin(), latest.viterbi.end()));
+        const auto last_index = window.size() - MAX_UNCONFIRMED_POINTS / 2;
+        for (auto position = window.size() - 1; position > last_index; --position)
+        {
+            candidate = window[position].parents[candidate];
+        }
+        ConfirmSessionPoints(session, last_index, candidate, sub_matchings);
+    }
+
+    return sub_matchings;
+}
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -0,0 +1,237 @@
+#include "engine/routing_algorithms/one_to_all.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+bool OneToAllRouting::IsAvailable(const datafacade::BaseDataFacade &facade)
+{
+    return facade.GetCoreSize() == 0 &&
+           facade.GetLevelOrder().size() == facade.GetNumberOfNodes();
+}
+
+std::vector<EdgeWeight> OneToAllRouting::
+operator()(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+           const std::vector<PhantomNode> &phantom_nodes,
+           const std::vector<std::size_t> &source_indices,
+           const std::vector<std::size_t> &target_indices) const
+{
+    BOOST_ASSERT(IsAvailable(*facade));
+
+    const auto number_of_sources =
+        source_indices.empty() ? phantom_nodes.size() : source_indices.size();
+    const auto number_of_targets =
+        target_indices.empty() ? phantom_nodes.size() : target_indices.size();
+    const auto number_of_entries = number_of_sources * number_of_targets;
+
+    std::vector<EdgeWeight> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+
+    // targets that lie on the source segment before the source need a loop, which the sweep
+    // can't find as the source label is always smaller. These are rare, so we just do a
+    // bucket based search for them.
+    std::vector<std::size_t> loop_target_indices;
+    std::vector<std::size_t> loop_target_columns;
+
+    for (const auto row_idx : util::irange<std::size_t>(0UL, number_of_sources))
+    {
+        const auto source_index = source_indices.empty() ? row_idx : source_indices[row_idx];
+        const auto &labels = Search(facade, phantom_nodes[source_index]);
+
+        loop_target_indices.clear();
+        loop_target_columns.clear();
+
+        for (const auto column_idx : util::irange<std::size_t>(0UL, number_of_targets))
+        {
+            const auto target_index =
+                target_indices.empty() ? column_idx : target_indices[column_idx];
+            const auto &target = phantom_nodes[target_index];
+
+            EdgeWeight weight = INVALID_EDGE_WEIGHT;
+            EdgeWeight duration = MAXIMAL_EDGE_DURATION;
+            bool needs_loop = false;
+            const auto update = [&](const NodeID node,
+                                    const EdgeWeight weight_offset,
+                                    const EdgeWeight duration_offset) {
+                if (labels.weights[node] == INVALID_EDGE_WEIGHT)
+                    return;
+
+                const EdgeWeight new_weight = labels.weights[node] + weight_offset;
+                if (new_weight < 0)
+                {
+                    needs_loop = true;
+                }
+                else if (new_weight < weight)
+                {
+                    weight = new_weight;
+                    duration = labels.durations[node] + duration_offset;
+                }
+            };
+
+            if (target.forward_segment_id.enabled)
+            {
+                update(target.forward_segment_id.id,
+                       target.GetForwardWeightPlusOffset(),
+                       target.GetForwardDuration());
+            }
+            if (target.reverse_segment_id.enabled)
+            {
+                update(target.reverse_segment_id.id,
+                       target.GetReverseWeightPlusOffset(),
+                       target.GetReverseDuration());
+            }
+
+            if (needs_loop)
+            {
+                loop_target_indices.push_back(target_index);
+                loop_target_columns.push_back(column_idx);
+            }
+            else
+            {
+                durations_table[row_idx * number_of_targets + column_idx] = duration;
+            }
+        }
+
+        if (!loop_target_indices.empty())
+        {
+            ManyToManyRouting many_to_many(engine_working_data);
+            const auto loop_durations =
+                many_to_many(facade, phantom_nodes, {source_index}, loop_target_indices);
+            for (const auto index : util::irange<std::size_t>(0UL, loop_target_columns.size()))
+            {
+                durations_table[row_idx * number_of_targets + loop_target_columns[index]] =
+                    loop_durations[index];
+            }
+        }
+    }
+
+    return durations_table;
+}
+
+const OneToAllLabels &
+OneToAllRouting::Search(const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+                        const PhantomNode &source,
+                        const EdgeWeight max_reached_duration) const
+{
+    BOOST_ASSERT(IsAvailable(*facade));
+
+    engine_working_data.InitializeOrClearOneToAllThreadLocalStorage(facade->GetNumberOfNodes());
+
+    QueryHeap &query_heap = *(engine_working_data.many_to_many_heap);
+    OneToAllLabels &labels = *(engine_working_data.one_to_all_labels);
+
+    if (source.forward_segment_id.enabled)
+    {
+        query_heap.Insert(source.forward_segment_id.id,
+                          -source.GetForwardWeightPlusOffset(),
+                          {source.forward_segment_id.id, -source.GetForwardDuration()});
+    }
+    if (source.reverse_segment_id.enabled)
+    {
+        query_heap.Insert(source.reverse_segment_id.id,
+                          -source.GetReverseWeightPlusOffset(),
+                          {source.reverse_segment_id.id, -source.GetReverseDuration()});
+    }
+
+    // Upward search. We can't stall here, the sweep relies on all upward labels being set.
+    while (!query_heap.Empty())
+    {
+        const NodeID node = query_heap.DeleteMin();
+        const EdgeWeight weight = query_heap.GetKey(node);
+        const EdgeWeight duration = query_heap.GetData(node).duration;
+
+        labels.weights[node] = weight;
+        labels.durations[node] = duration;
+
+        RelaxOutgoingEdges(facade, node, weight, duration, query_heap);
+    }
+
+    const bool collect_reached = max_reached_duration != INVALID_EDGE_WEIGHT;
+    const auto is_reached = [&labels, max_reached_duration](const NodeID node) {
+        return labels.weights[node] != INVALID_EDGE_WEIGHT &&
+               labels.durations[node] <= max_reached_duration;
+    };
+
+    // Downward sweep: every node pulls its label over the edges coming from higher levels,
+    // which are all final when the node is visited.
+    // Every turn is stored at one of its nodes, forward at the node it leaves or backward at
+    // the node it enters. The sweep visits all of them, so it collects the reached nodes with
+    // their turns on the way.
+    for (const NodeID node : facade->GetLevelOrder())
+    {
+        EdgeWeight &node_weight = labels.weights[node];
+        EdgeWeight &node_duration = labels.durations[node];
+        EdgeID leaving_turn = SPECIAL_EDGEID;
+
+        for (const auto edge : facade->GetAdjacentEdgeRange(node))
+        {
+            const auto &data = facade->GetEdgeData(edge);
+            if (collect_reached && !data.shortcut && data.forward)
+                leaving_turn = data.id;
+
+            if (!data.backward)
+                continue;
+
+            const NodeID from = facade->GetTarget(edge);
+            const EdgeWeight from_weight = labels.weights[from];
+            if (from_weight == INVALID_EDGE_WEIGHT)
+                continue;
+
+            if (collect_reached && !data.shortcut && is_reached(from))
+                labels.reached.emplace_back(from, data.id);
+
+            const EdgeWeight to_weight = from_weight + data.weight;
+            if (to_weight < node_weight)
+            {
+                node_weight = to_weight;
+                node_duration = labels.durations[from] + data.duration;
+            }
+        }
+
+        if (leaving_turn != SPECIAL_EDGEID && is_reached(node))
+            labels.reached.emplace_back(node, leaving_turn);
+    }
+
+    return labels;
+}
+
+void OneToAllRouting::RelaxOutgoingEdges(
+    const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+    const NodeID node,
+    const EdgeWeight weight,
+    const EdgeWeight duration,
+    QueryHeap &query_heap) const
+{
+    for (const auto edge : facade->GetAdjacentEdgeRange(node))
+    {
+        const auto &data = facade->GetEdgeData(edge);
+        if (data.forward)
+        {
+            const NodeID to = facade->GetTarget(edge);
+            BOOST_ASSERT_MSG(data.weight > 0, "edge_weight invalid");
+            const EdgeWeight to_weight = weight + data.weight;
+            const EdgeWeight to_duration = duration + data.duration;
+
+            if (!query_heap.WasInserted(to))
+            {
+                query_heap.Insert(to, to_weight, {node, to_duration});
+            }
+            else if (to_weight < query_heap.GetKey(to))
+            {
+                query_heap.GetData(to) = {node, to_duration};
+                query_heap.DecreaseKey(to, to_weight);
+            }
+        }
+    }
+}
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
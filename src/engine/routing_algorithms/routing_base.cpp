@@ -10,7 +10,7 @@ namespace routing_algorithms
 void BasicRoutingInterface::RoutingStep(
     const std::shared_ptr<const datafacade::BaseDataFacade> facade,
     SearchEngineData::QueryHeap &forward_heap,
-    SearchEngineData::QueryHeap &reverse_heap,
+    const SearchEngineData::QueryHeap &reverse_heap,
     NodeID &middle_node_id,
     EdgeWeight &upper_bound,
     EdgeWeight min_edge_offset,
@@ -485,55 +485,62 @@ double BasicRoutingInterface::GetPathDistance(
     const PhantomNode &source_phantom,
     const PhantomNode &target_phantom) const
 {
-    std::vector<PathData> unpacked_path;
-    PhantomNodes nodes;
-    nodes.source_phantom = source_phantom;
-    nodes.target_phantom = target_phantom;
-    UnpackPath(facade, packed_path.begin(), packed_path.end(), nodes, unpacked_path);
-
-    using util::coordinate_calculation::detail::DEGREE_TO_RAD;
-    using util::coordinate_calculation::detail::EARTH_RADIUS;
+    BOOST_ASSERT(!packed_path.empty());
 
+    // Every CH edge carries the length of the edge based node it leaves, so the packed edges
+    // cover the path up to the start of the last node.
     double distance = 0;
-    double prev_lat = static_cast<double>(toFloating(source_phantom.location.lat)) * DEGREE_TO_RAD;
-    double prev_lon = static_cast<double>(toFloating(source_phantom.location.lon)) * DEGREE_TO_RAD;
-    double prev_cos = std::cos(prev_lat);
-    for (const auto &p : unpacked_path)
+    for (auto current = packed_path.begin(); std::next(current) != packed_path.end(); ++current)
     {
-        const auto current_coordinate = facade->GetCoordinateOfNode(p.turn_via_node);
-
-        const double current_lat =
-            static_cast<double>(toFloating(current_coordinate.lat)) * DEGREE_TO_RAD;
-        const double current_lon =
-            static_cast<double>(toFloating(current_coordinate.lon)) * DEGREE_TO_RAD;
-        const double current_cos = std::cos(current_lat);
-
-        const double sin_dlon = std::sin((prev_lon - current_lon) / 2.0);
-        const double sin_dlat = std::sin((prev_lat - current_lat) / 2.0);
-
-        const double aharv = sin_dlat * sin_dlat + prev_cos * current_cos * sin_dlon * sin_dlon;
-        const double charv = 2. * std::atan2(std::sqrt(aharv), std::sqrt(1.0 - aharv));
-        distance += EARTH_RADIUS * charv;
-
-        prev_lat = current_lat;
-        prev_lon = current_lon;
-        prev_cos = current_cos;
+        bool reversed;
+        const auto edge = detail::FindCHEdge(*facade, *current, *std::next(current), reversed);
+        distance += facade->GetEdgeData(edge).distance;
     }
 
-    const double current_lat =
-        static_cast<double>(toFloating(target_phantom.location.lat)) * DEGREE_TO_RAD;
-    const double current_lon =
-        static_cast<double>(toFloating(target_phantom.location.lon)) * DEGREE_TO_RAD;
-    const double current_cos = std::cos(current_lat);
+    distance -= GetPhantomNodeOffset(facade, source_phantom, packed_path.front());
+    distance += GetPhantomNodeOffset(facade, target_phantom, packed_path.back());
 
-    const double sin_dlon = std::sin((prev_lon - current_lon) / 2.0);
-    const double sin_dlat = std::sin((prev_lat - current_lat) / 2.0);
+    return distance;
+}
 
-    const double aharv = sin_dlat * sin_dlat + prev_cos * current_cos * sin_dlon * sin_dlon;
-    const double charv = 2. * std::atan2(std::sqrt(aharv), std::sqrt(1.0 - aharv));
-    distance += EARTH_RADIUS * charv;
+// Distance from the start of the edge based node to the location of the phantom node
+double BasicRoutingInterface::GetPhantomNodeOffset(
+    const std::shared_ptr<const datafacade::BaseDataFacade> facade,
+    const PhantomNode &phantom,
+    const NodeID node) const
+{
+    //                          u       *      v
+    //                          0 -- 1 -- 2 -- 3
+    // fwd_segment_position:  1
+    // forward offset:          0 -> 1 -> *
+    // reverse offset:                    * <- 2 <- 3
+    const auto geometry = facade->GetUncompressedForwardGeometry(phantom.packed_geometry_id);
+    const std::size_t position = phantom.fwd_segment_position;
+    BOOST_ASSERT(position + 1 < geometry.size());
+
+    const auto segment_length = [&](const std::size_t index) {
+        return util::coordinate_calculation::haversineDistance(
+            facade->GetCoordinateOfNode(geometry[index]),
+            facade->GetCoordinateOfNode(geometry[index + 1]));
+    };
 
-    return distance;
+    double offset = 0;
+    if (node == phantom.forward_segment_id.id)
+    {
+        for (std::size_t index = 0; index < position; ++index)
+            offset += segment_length(index);
+        offset += util::coordinate_calculation::haversineDistance(
+            facade->GetCoordinateOfNode(geometry[position]), phantom.location);
+    }
+    else
+    {
+        BOOST_ASSERT(node == phantom.reverse_segment_id.id);
+        for (std::size_t index = position + 1; index + 1 < geometry.size(); ++index)
+            offset += segment_length(index);
+        offset += util::coordinate_calculation::haversineDistance(
+            phantom.location, facade->GetCoordinateOfNode(geometry[position + 1]));
+    }
+    return offset;
 }
 
 // Requires the heaps for be empty
@@ -368,7 +368,7 @@ void ShortestPathRouting::operator()(const std::shared_ptr<const datafacade::Bas
             (INVALID_EDGE_WEIGHT == new_total_weight_to_reverse))
         {
             raw_route_data.shortest_path_length = INVALID_EDGE_WEIGHT;
-            raw_route_data.alternative_path_length = INVALID_EDGE_WEIGHT;
+            raw_route_data.alternative_path_lengths.clear();
             return;
         }
 
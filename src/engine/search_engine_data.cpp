@@ -14,6 +14,8 @@ SearchEngineData::SearchEngineHeapPtr SearchEngineData::reverse_heap_2;
 SearchEngineData::SearchEngineHeapPtr SearchEngineData::forward_heap_3;
 SearchEngineData::SearchEngineHeapPtr SearchEngineData::reverse_heap_3;
 SearchEngineData::ManyToManyHeapPtr SearchEngineData::many_to_many_heap;
+SearchEngineData::OneToAllLabelsPtr SearchEngineData::one_to_all_labels;
+SearchEngineData::HiddenMarkovModelPtr SearchEngineData::hidden_markov_model;
 
 void SearchEngineData::InitializeOrClearFirstThreadLocalStorage(const unsigned number_of_nodes)
 {
@@ -89,5 +91,28 @@ void SearchEngineData::InitializeOrClearManyToManyThreadLocalStorage(const unsig
         many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes));
     }
 }
+
+void SearchEngineData::InitializeOrClearOneToAllThreadLocalStorage(const unsigned number_of_nodes)
+{
+    InitializeOrClearManyToManyThreadLocalStorage(number_of_nodes);
+
+    if (!one_to_all_labels.get())
+    {
+        one_to_all_labels.reset(new OneToAllLabels());
+    }
+
+    // durations are only read for nodes with a valid weight, no need to reset them
+    one_to_all_labels->weights.assign(number_of_nodes, INVALID_EDGE_WEIGHT);
+    one_to_all_labels->durations.resize(number_of_nodes);
+    one_to_all_labels->reached.clear();
+}
+
+void SearchEngineData::InitializeHiddenMarkovModelThreadLocalStorage()
+{
+    if (!hidden_markov_model.get())
+    {
+        hidden_markov_model.reset(new map_matching::HiddenMarkovModel());
+    }
+}
 }
 }
@@ -0,0 +1,62 @@
+#include "engine/unpacking_cache.hpp"
+
+#include <boost/assert.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+
+const constexpr std::size_t UnpackingCache::NUM_SHARDS;
+
+UnpackingCache::UnpackingCache(const std::size_t capacity)
+    : shard_capacity((capacity + NUM_SHARDS - 1) / NUM_SHARDS)
+{
+}
+
+UnpackingCache::UnpackedEdgesPtr UnpackingCache::Find(const EdgeID shortcut, const bool reversed)
+{
+    const auto key = MakeKey(shortcut, reversed);
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto entry = shard.index.find(key);
+    if (entry == shard.index.end())
+        return nullptr;
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, entry->second);
+    return entry->second->second;
+}
+
+void UnpackingCache::Insert(const EdgeID shortcut,
+                            const bool reversed,
+                            UnpackedEdgesPtr unpacked_edges)
+{
+    BOOST_ASSERT(unpacked_edges);
+    const auto number_of_edges = unpacked_edges->size();
+    // would evict the whole shard and still not fit
+    if (number_of_edges > shard_capacity)
+        return;
+
+    const auto key = MakeKey(shortcut, reversed);
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // another request unpacked the same shortcut concurrently
+    if (shard.index.count(key) > 0)
+        return;
+
+    shard.entries.emplace_front(key, std::move(unpacked_edges));
+    shard.index.emplace(key, shard.entries.begin());
+    shard.size += number_of_edges;
+
+    while (shard.size > shard_capacity)
+    {
+        const auto &least_recent = shard.entries.back();
+        shard.size -= least_recent.second->size();
+        shard.index.erase(least_recent.first);
+        shard.entries.pop_back();
+    }
+}
+}
+}
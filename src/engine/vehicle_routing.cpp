@@ -0,0 +1,393 @@
+#include "engine/vehicle_routing.hpp"
+
+#include "engine/parallel_restarts.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+using Cost = std::int64_t;
+
+// any solution that serves more locations is better, regardless of its duration
+const constexpr Cost UNASSIGNED_PENALTY = Cost{1} << 48;
+const constexpr Cost INFEASIBLE = -1;
+// a ruin removes at most this many locations plus a tenth of all locations
+const constexpr std::size_t MIN_RUIN_SIZE = 10;
+// a search stops after this many ruins per stop did not find a better solution
+const constexpr std::size_t FAILED_MOVES_PER_STOP = 10;
+
+struct RoutingState
+{
+    std::vector<std::vector<NodeID>> routes;
+    std::vector<Cost> durations;
+    std::vector<unsigned> loads;
+    std::vector<NodeID> unassigned;
+
+    Cost GetCost() const
+    {
+        return std::accumulate(durations.begin(), durations.end(), Cost{0}) +
+               static_cast<Cost>(unassigned.size()) * UNASSIGNED_PENALTY;
+    }
+};
+
+// Duration of the route from the depot through all stops back to the depot, or INFEASIBLE if a
+// time window is violated
+Cost getRouteDuration(const VehicleRoutingProblem &problem, const std::vector<NodeID> &route)
+{
+    const auto depot = static_cast<NodeID>(problem.depot);
+    const Cost departure = problem.time_windows[depot].begin;
+
+    Cost time = departure;
+    NodeID current = depot;
+    const auto visit = [&](const NodeID next) {
+        const auto duration = problem.durations(current, next);
+        if (duration == INVALID_EDGE_WEIGHT)
+        {
+            return false;
+        }
+        const auto &time_window = problem.time_windows[next];
+        time = std::max<Cost>(time + duration, time_window.begin);
+        if (time > time_window.end)
+        {
+            return false;
+        }
+        if (next != depot)
+        {
+            time += problem.service_times[next];
+        }
+        current = next;
+        return true;
+    };
+
+    for (const auto stop : route)
+    {
+        if (!visit(stop))
+        {
+            return INFEASIBLE;
+        }
+    }
+    if (!visit(depot))
+    {
+        return INFEASIBLE;
+    }
+
+    return time - departure;
+}
+
+// The times of a feasible route at each of its stops and at the return to the depot, which is
+// the last entry. Delaying the start of the service at a stop by some time delays the return by
+// that time minus the waiting at all later stops, as long as the start stays before its latest
+// start.
+struct RouteSchedule
+{
+    std::vector<Cost> starts;
+    std::vector<Cost> latest_starts;
+    std::vector<Cost> later_waiting;
+};
+
+RouteSchedule getRouteSchedule(const VehicleRoutingProblem &problem,
+                               const std::vector<NodeID> &route)
+{
+    const auto depot = static_cast<NodeID>(problem.depot);
+    const auto get_stop = [&](const std::size_t index) {
+        return index < route.size() ? route[index] : depot;
+    };
+
+    RouteSchedule schedule;
+    schedule.starts.resize(route.size() + 1);
+    schedule.latest_starts.resize(route.size() + 1);
+    schedule.later_waiting.resize(route.size() + 1);
+
+    std::vector<Cost> waiting(route.size() + 1);
+    Cost time = problem.time_windows[depot].begin;
+    NodeID current = depot;
+    for (const auto index : util::irange<std::size_t>(0UL, route.size() + 1))
+    {
+        const auto stop = get_stop(index);
+        BOOST_ASSERT(problem.durations(current, stop) != INVALID_EDGE_WEIGHT);
+        const auto arrival = time + problem.durations(current, stop);
+        schedule.starts[index] = std::max<Cost>(arrival, problem.time_windows[stop].begin);
+        waiting[index] = schedule.starts[index] - arrival;
+        time = schedule.starts[index] + (stop != depot ? problem.service_times[stop] : 0);
+        current = stop;
+    }
+
+    schedule.latest_starts.back() = problem.time_windows[depot].end;
+    for (auto index = route.size(); index > 0; --index)
+    {
+        const auto stop = route[index - 1];
+        const Cost latest_departure =
+            schedule.latest_starts[index] - problem.durations(stop, get_stop(index));
+        schedule.latest_starts[index - 1] = std::min<Cost>(
+            problem.time_windows[stop].end, latest_departure - problem.service_times[stop]);
+        schedule.later_waiting[index - 1] = schedule.later_waiting[index] + waiting[index];
+    }
+
+    return schedule;
+}
+
+// Inserts the stops in the given order, each at the position that adds the least duration.
+// After the deadline a stop is inserted at the first feasible position instead.
+void insertStops(const VehicleRoutingProblem &problem,
+                 const std::vector<NodeID> &stops,
+                 RoutingState &state,
+                 const std::chrono::steady_clock::time_point deadline =
+                     std::chrono::steady_clock::time_point::max())
+{
+    const auto depot = static_cast<NodeID>(problem.depot);
+    const Cost departure = problem.time_windows[depot].begin;
+
+    std::vector<RouteSchedule> schedules;
+    schedules.reserve(state.routes.size());
+    for (const auto &route : state.routes)
+    {
+        schedules.push_back(getRouteSchedule(problem, route));
+    }
+
+    for (const auto stop : stops)
+    {
+        const bool first_feasible = std::chrono::steady_clock::now() >= deadline;
+        Cost best_increase = INFEASIBLE;
+        std::size_t best_vehicle = 0;
+        std::size_t best_position = 0;
+
+        for (const auto vehicle : util::irange<std::size_t>(0UL, state.routes.size()))
+        {
+            if (std::uint64_t{state.loads[vehicle]} + problem.demands[stop] >
+                problem.capacities[vehicle])
+            {
+                continue;
+            }
+
+            const auto &route = state.routes[vehicle];
+            const auto &schedule = schedules[vehicle];
+            for (const auto position : util::irange<std::size_t>(0UL, route.size() + 1))
+            {
+                const auto previous = position > 0 ? route[position - 1] : depot;
+                const auto next = position < route.size() ? route[position] : depot;
+                const auto to_stop = problem.durations(previous, stop);
+                const auto from_stop = problem.durations(stop, next);
+                if (to_stop == INVALID_EDGE_WEIGHT || from_stop == INVALID_EDGE_WEIGHT)
+                {
+                    continue;
+                }
+
+                const Cost previous_departure =
+                    position > 0 ? schedule.starts[position - 1] + problem.service_times[previous]
+                                 : departure;
+                const auto start =
+                    std::max<Cost>(previous_departure + to_stop, problem.time_windows[stop].begin);
+                if (start > problem.time_windows[stop].end)
+                {
+                    continue;
+                }
+                const auto next_start =
+                    std::max<Cost>(start + problem.service_times[stop] + from_stop,
+                                   problem.time_windows[next].begin);
+                if (next_start > schedule.latest_starts[position])
+                {
+                    continue;
+                }
+
+                const auto increase =
+                    std::max<Cost>(0,
+                                   next_start - schedule.starts[position] -
+                                       schedule.later_waiting[position]);
+                if (best_increase == INFEASIBLE || increase < best_increase)
+                {
+                    best_increase = increase;
+                    best_vehicle = vehicle;
+                    best_position = position;
+                }
+                if (first_feasible)
+                {
+                    break;
+                }
+            }
+            if (first_feasible && best_increase != INFEASIBLE)
+            {
+                break;
+            }
+        }
+
+        if (best_increase == INFEASIBLE)
+        {
+            state.unassigned.push_back(stop);
+            continue;
+        }
+
+        auto &route = state.routes[best_vehicle];
+        route.insert(route.begin() + best_position, stop);
+        state.durations[best_vehicle] += best_increase;
+        state.loads[best_vehicle] += problem.demands[stop];
+        BOOST_ASSERT(getRouteDuration(problem, route) == state.durations[best_vehicle]);
+        schedules[best_vehicle] = getRouteSchedule(problem, route);
+    }
+}
+
+// Removes a random stop together with the stops closest to it and inserts them again, along
+// with all stops that are unassigned so far.
+template <typename RandomGenerator>
+void ruinAndRecreate(const VehicleRoutingProblem &problem,
+                     const std::vector<std::vector<NodeID>> &neighbours,
+                     const std::vector<NodeID> &stops,
+                     RandomGenerator &generator,
+                     RoutingState &state)
+{
+    const auto max_ruin_size = std::min(stops.size(), MIN_RUIN_SIZE + stops.size() / 10);
+    std::uniform_int_distribution<std::size_t> stop_distribution(0, stops.size() - 1);
+    std::uniform_int_distribution<std::size_t> size_distribution(1, max_ruin_size);
+
+    const auto &closest = neighbours[stops[stop_distribution(generator)]];
+    std::vector<NodeID> removed(closest.begin(), closest.begin() + size_distribution(generator));
+    std::sort(removed.begin(), removed.end());
+
+    const auto is_removed = [&removed](const NodeID stop) {
+        return std::binary_search(removed.begin(), removed.end(), stop);
+    };
+    std::vector<NodeID> reinserted;
+    for (const auto vehicle : util::irange<std::size_t>(0UL, state.routes.size()))
+    {
+        auto &route = state.routes[vehicle];
+        const auto new_end = std::remove_if(route.begin(), route.end(), is_removed);
+        if (new_end == route.end())
+        {
+            continue;
+        }
+        route.erase(new_end, route.end());
+        state.loads[vehicle] = 0;
+        for (const auto stop : route)
+        {
+            state.loads[vehicle] += problem.demands[stop];
+        }
+        state.durations[vehicle] = getRouteDuration(problem, route);
+
+        // durations between snapped locations do not strictly obey the triangle inequality, so
+        // skipping a stop can miss a time window
+        if (state.durations[vehicle] == INFEASIBLE)
+        {
+            reinserted.insert(reinserted.end(), route.begin(), route.end());
+            route.clear();
+            state.loads[vehicle] = 0;
+            state.durations[vehicle] = 0;
+        }
+    }
+
+    reinserted.insert(reinserted.end(), removed.begin(), removed.end());
+    for (const auto stop : state.unassigned)
+    {
+        if (!is_removed(stop))
+        {
+            reinserted.push_back(stop);
+        }
+    }
+    state.unassigned.clear();
+
+    std::shuffle(reinserted.begin(), reinserted.end(), generator);
+    insertStops(problem, reinserted, state);
+}
+
+VehicleRoutingSolution makeSolution(const VehicleRoutingProblem &problem,
+                                    const RoutingState &state)
+{
+    VehicleRoutingSolution solution;
+    solution.routes = state.routes;
+    solution.unassigned = state.unassigned;
+    std::sort(solution.unassigned.begin(), solution.unassigned.end());
+    solution.duration = std::accumulate(state.durations.begin(), state.durations.end(), Cost{0});
+
+    const auto depot = static_cast<NodeID>(problem.depot);
+    const Cost departure = problem.time_windows[depot].begin;
+    solution.arrivals.resize(problem.GetNumberOfLocations(), INVALID_EDGE_WEIGHT);
+    solution.arrivals[depot] = static_cast<EdgeWeight>(departure);
+    for (const auto &route : state.routes)
+    {
+        Cost time = departure;
+        NodeID current = depot;
+        for (const auto stop : route)
+        {
+            time = std::max<Cost>(time + problem.durations(current, stop),
+                                  problem.time_windows[stop].begin);
+            solution.arrivals[stop] = static_cast<EdgeWeight>(time);
+            time += problem.service_times[stop];
+            current = stop;
+        }
+    }
+
+    return solution;
+}
+}
+
+VehicleRoutingSolution solveVehicleRouting(const VehicleRoutingProblem &problem,
+                                           const std::chrono::milliseconds search_time)
+{
+    BOOST_ASSERT(problem.depot < problem.GetNumberOfLocations());
+    BOOST_ASSERT(problem.demands.size() == problem.GetNumberOfLocations());
+    BOOST_ASSERT(problem.time_windows.size() == problem.GetNumberOfLocations());
+    BOOST_ASSERT(problem.service_times.size() == problem.GetNumberOfLocations());
+
+    const auto deadline = std::chrono::steady_clock::now() + search_time;
+    const auto number_of_vehicles = problem.GetNumberOfVehicles();
+
+    std::vector<NodeID> stops;
+    stops.reserve(problem.GetNumberOfLocations());
+    for (const auto location : util::irange<NodeID>(0u, problem.GetNumberOfLocations()))
+    {
+        if (location != problem.depot)
+        {
+            stops.push_back(location);
+        }
+    }
+
+    RoutingState best_state;
+    best_state.routes.resize(number_of_vehicles);
+    best_state.durations.resize(number_of_vehicles, 0);
+    best_state.loads.resize(number_of_vehicles, 0);
+    insertStops(problem, stops, best_state, deadline);
+
+    if (search_time.count() <= 0 || stops.size() < 2 || number_of_vehicles == 0)
+    {
+        return makeSolution(problem, best_state);
+    }
+
+    // stops sorted by the duration to and from each stop, starting with the stop itself
+    std::vector<std::vector<NodeID>> neighbours(problem.GetNumberOfLocations());
+    for (const auto stop : stops)
+    {
+        const auto round_trip = [&](const NodeID other) {
+            return Cost{problem.durations(stop, other)} + problem.durations(other, stop);
+        };
+        neighbours[stop] = stops;
+        std::sort(neighbours[stop].begin(),
+                  neighbours[stop].end(),
+                  [&](const NodeID lhs, const NodeID rhs) {
+                      return std::make_pair(lhs != stop, round_trip(lhs)) <
+                             std::make_pair(rhs != stop, round_trip(rhs));
+                  });
+    }
+
+    runParallelRestarts(
+        best_state,
+        deadline,
+        FAILED_MOVES_PER_STOP * stops.size(),
+        [](const std::size_t, RoutingState &, std::mt19937 &) {},
+        [&](RoutingState &state, std::mt19937 &generator) {
+            ruinAndRecreate(problem, neighbours, stops, generator, state);
+        },
+        [](const RoutingState &state) { return state.GetCost(); });
+
+    return makeSolution(problem, best_state);
+}
+}
+}
@@ -420,6 +420,24 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
                 ++node_based_edge_counter;
 
+                // length of the geometry of the source edge based node, all turns out of it share
+                // it as their distance
+                const auto distance = [&] {
+                    double length = 0.;
+                    NodeID previous = node_along_road_entering;
+                    for (const auto &target_node :
+                         m_compressed_edge_container.GetBucketReference(incoming_edge))
+                    {
+                        length += util::coordinate_calculation::haversineDistance(
+                            util::Coordinate(m_node_info_list[previous].lon,
+                                             m_node_info_list[previous].lat),
+                            util::Coordinate(m_node_info_list[target_node.node_id].lon,
+                                             m_node_info_list[target_node.node_id].lat));
+                        previous = target_node.node_id;
+                    }
+                    return static_cast<EdgeDistance>(length);
+                }();
+
                 auto intersection_with_flags_and_angles =
                     turn_analysis.GetIntersectionGenerator().TransformIntersectionShapeIntoView(
                         node_along_road_entering,
@@ -553,6 +571,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                                         turn_id,
                                                         weight,
                                                         duration,
+                                                        distance,
                                                         true,
                                                         false);
                     BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
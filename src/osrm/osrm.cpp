@@ -1,6 +1,8 @@
 #include "osrm/osrm.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/optimize_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
@@ -54,4 +56,16 @@ engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string
     return engine_->Tile(params, result);
 }
 
+engine::Status OSRM::Isochrone(const engine::api::IsochroneParameters &params,
+                               json::Object &result) const
+{
+    return engine_->Isochrone(params, result);
+}
+
+engine::Status OSRM::Optimize(const engine::api::OptimizeParameters &params,
+                              json::Object &result) const
+{
+    return engine_->Optimize(params, result);
+}
+
 } // ns osrm
@@ -1,7 +1,9 @@
 #include "server/api/parameters_parser.hpp"
 
+#include "server/api/isochrone_parameter_grammar.hpp"
 #include "server/api/match_parameter_grammar.hpp"
 #include "server/api/nearest_parameter_grammar.hpp"
+#include "server/api/optimize_parameter_grammar.hpp"
 #include "server/api/route_parameters_grammar.hpp"
 #include "server/api/table_parameter_grammar.hpp"
 #include "server/api/tile_parameter_grammar.hpp"
@@ -26,7 +28,9 @@ using is_grammar_t =
                                std::is_same<NearestParametersGrammar<>, T>::value ||
                                std::is_same<TripParametersGrammar<>, T>::value ||
                                std::is_same<MatchParametersGrammar<>, T>::value ||
-                               std::is_same<TileParametersGrammar<>, T>::value>;
+                               std::is_same<TileParametersGrammar<>, T>::value ||
+                               std::is_same<IsochroneParametersGrammar<>, T>::value ||
+                               std::is_same<OptimizeParametersGrammar<>, T>::value>;
 
 template <typename ParameterT,
           typename GrammarT,
@@ -111,6 +115,22 @@ boost::optional<engine::api::TileParameters> parseParameters(std::string::iterat
     return detail::parseParameters<engine::api::TileParameters, TileParametersGrammar<>>(iter, end);
 }
 
+template <>
+boost::optional<engine::api::IsochroneParameters> parseParameters(std::string::iterator &iter,
+                                                                  const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::IsochroneParameters,
+                                   IsochroneParametersGrammar<>>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::OptimizeParameters> parseParameters(std::string::iterator &iter,
+                                                                 const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::OptimizeParameters, OptimizeParametersGrammar<>>(
+        iter, end);
+}
+
 } // ns api
 } // ns server
 } // ns osrm
@@ -54,7 +54,20 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
     {
         TIMER_START(request_duration);
         std::string request_string;
-        util::URIDecode(current_request.uri, request_string);
+        if (current_request.body.empty())
+        {
+            util::URIDecode(current_request.uri, request_string);
+        }
+        else
+        {
+            // the body of a POST request holds the coordinates and options that follow the profile
+            auto uri = current_request.uri;
+            if (uri.empty() || uri.back() != '/')
+            {
+                uri.push_back('/');
+            }
+            util::URIDecode(uri + current_request.body, request_string);
+        }
 
         util::Log(logDEBUG) << "[req][" << tid << "] " << request_string;
 
@@ -99,7 +112,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         }
 
         current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
         current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                            "X-Requested-With, Content-Type");
         if (result.is<util::json::Object>())
@@ -156,7 +169,11 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
                         << current_request.agent
                         << (0 == current_request.agent.length() ? "- " : " ")
                         << current_reply.status << " " //
-                        << request_string;
+                        // bodies of POST requests can hold millions of coordinates
+                        << (current_request.body.empty()
+                                ? request_string
+                                : current_request.uri + " [" +
+                                      std::to_string(current_request.body.size()) + " bytes]");
         }
     }
     catch (const std::exception &e)
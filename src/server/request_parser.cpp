@@ -13,9 +13,15 @@ namespace osrm
 namespace server
 {
 
+namespace
+{
+// bodies of POST requests replace the coordinates of the URL, this allows a few million of them
+const constexpr std::size_t MAX_CONTENT_LENGTH = 64 * 1024 * 1024;
+}
+
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), content_length(0)
 {
 }
 
@@ -46,6 +52,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::invalid;
         }
         state = internal_state::method;
+        method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::method:
         if (input == ' ')
@@ -57,6 +64,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         {
             return RequestStatus::invalid;
         }
+        method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::uri_start:
         if (is_CTL(input))
@@ -180,6 +188,27 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.agent = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Content-Length"))
+        {
+            if (current_header.value.empty() || current_header.value.size() > 9)
+            {
+                return RequestStatus::invalid;
+            }
+            content_length = 0;
+            for (const auto digit : current_header.value)
+            {
+                if (!is_digit(digit))
+                {
+                    return RequestStatus::invalid;
+                }
+                content_length = 10 * content_length + (digit - '0');
+            }
+            if (content_length > MAX_CONTENT_LENGTH)
+            {
+                return RequestStatus::invalid;
+            }
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -247,8 +276,27 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
-    default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+    case internal_state::expecting_newline_3:
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length == 0)
+        {
+            return RequestStatus::valid;
+        }
+        // only POST requests carry a body
+        if (method != "POST")
+        {
+            return RequestStatus::invalid;
+        }
+        current_request.body.reserve(content_length);
+        state = internal_state::body;
+        return RequestStatus::indeterminate;
+    default: // body
+        current_request.body.push_back(input);
+        return current_request.body.size() < content_length ? RequestStatus::indeterminate
+                                                            : RequestStatus::valid;
     }
 }
 
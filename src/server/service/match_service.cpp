@@ -32,7 +32,12 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
         constrainParamSize(
             PARAMETER_SIZE_MISMATCH_MSG, "timestamps", parameters.timestamps, coord_size, help);
 
-    if (!param_size_mismatch && parameters.coordinates.size() < 2)
+    if (!param_size_mismatch && parameters.finish && parameters.session.empty())
+    {
+        help = "Parameter finish requires a session.";
+    }
+    else if (!param_size_mismatch && parameters.session.empty() &&
+             parameters.coordinates.size() < 2)
     {
         help = "Number of coordinates needs to be at least two.";
     }
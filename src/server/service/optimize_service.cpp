@@ -0,0 +1,126 @@
+#include "server/service/optimize_service.hpp"
+#include "server/service/utils.hpp"
+
+#include "server/api/parameters_parser.hpp"
+#include "engine/api/optimize_parameters.hpp"
+
+#include "util/json_container.hpp"
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace osrm
+{
+namespace server
+{
+namespace service
+{
+namespace
+{
+std::string getWrongOptionHelp(const engine::api::OptimizeParameters &parameters)
+{
+    std::string help;
+
+    const auto coord_size = parameters.coordinates.size();
+
+    const bool param_size_mismatch =
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "hints", parameters.hints, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "bearings", parameters.bearings, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "radiuses", parameters.radiuses, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "demands", parameters.demands, coord_size, help) ||
+        constrainParamSize(PARAMETER_SIZE_MISMATCH_MSG,
+                           "time_windows",
+                           parameters.time_windows,
+                           coord_size,
+                           help) ||
+        constrainParamSize(PARAMETER_SIZE_MISMATCH_MSG,
+                           "service_times",
+                           parameters.service_times,
+                           coord_size,
+                           help);
+
+    if (param_size_mismatch)
+    {
+        return help;
+    }
+
+    if (parameters.coordinates.size() < 2)
+    {
+        help = "Number of coordinates needs to be at least two.";
+    }
+    else if (parameters.depot >= coord_size)
+    {
+        help = "Depot needs to be the index of a coordinate.";
+    }
+    else if (parameters.vehicles == 0)
+    {
+        help = "Number of vehicles needs to be at least one.";
+    }
+    else if (parameters.vehicles >= coord_size)
+    {
+        help = "Number of vehicles (" + std::to_string(parameters.vehicles) +
+               ") needs to be less than the number of coordinates (" +
+               std::to_string(coord_size) + ")";
+    }
+    else if (!parameters.capacities.empty() &&
+             parameters.capacities.size() != parameters.vehicles)
+    {
+        help = "Number of capacities (" + std::to_string(parameters.capacities.size()) +
+               ") does not match number of vehicles (" + std::to_string(parameters.vehicles) +
+               ")";
+    }
+    else if (std::any_of(parameters.time_windows.begin(),
+                         parameters.time_windows.end(),
+                         [](const auto &time_window) {
+                             return time_window && time_window->begin > time_window->end;
+                         }))
+    {
+        help = "Time windows need to end after they begin.";
+    }
+    else
+    {
+        help = "Options are invalid.";
+    }
+
+    return help;
+}
+} // anon. ns
+
+engine::Status
+OptimizeService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = result.get<util::json::Object>();
+
+    auto query_iterator = query.begin();
+    auto parameters =
+        api::parseParameters<engine::api::OptimizeParameters>(query_iterator, query.end());
+    if (!parameters || query_iterator != query.end())
+    {
+        const auto position = std::distance(query.begin(), query_iterator);
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] =
+            "Query string malformed close to position " + std::to_string(prefix_length + position);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters);
+
+    if (!parameters->IsValid())
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = getWrongOptionHelp(*parameters);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters->IsValid());
+
+    return BaseService::routing_machine.Optimize(*parameters, json_result);
+}
+}
+}
+}
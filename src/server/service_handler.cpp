@@ -1,7 +1,9 @@
 #include "server/service_handler.hpp"
 
+#include "server/service/isochrone_service.hpp"
 #include "server/service/match_service.hpp"
 #include "server/service/nearest_service.hpp"
+#include "server/service/optimize_service.hpp"
 #include "server/service/route_service.hpp"
 #include "server/service/table_service.hpp"
 #include "server/service/tile_service.hpp"
@@ -24,6 +26,8 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
     service_map["trip"] = std::make_unique<service::TripService>(routing_machine);
     service_map["match"] = std::make_unique<service::MatchService>(routing_machine);
     service_map["tile"] = std::make_unique<service::TileService>(routing_machine);
+    service_map["isochrone"] = std::make_unique<service::IsochroneService>(routing_machine);
+    service_map["optimize"] = std::make_unique<service::OptimizeService>(routing_machine);
 }
 
 engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
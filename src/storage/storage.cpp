@@ -1,11 +1,13 @@
 #include "storage/storage.hpp"
 #include "contractor/query_edge.hpp"
+#include "contractor/shortcut_children.hpp"
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/original_edge_data.hpp"
 #include "extractor/profile_properties.hpp"
 #include "extractor/query_node.hpp"
 #include "extractor/travel_mode.hpp"
+#include "storage/container.hpp"
 #include "storage/io.hpp"
 #include "storage/serialization.hpp"
 #include "storage/shared_barrier.hpp"
@@ -16,8 +18,10 @@
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
+#include "util/integer_range.hpp"
 #include "util/io.hpp"
 #include "util/log.hpp"
+#include "util/numa.hpp"
 #include "util/packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/shared_memory_vector_wrapper.hpp"
@@ -29,19 +33,28 @@
 #include <sys/mman.h>
 #endif
 
+#include <boost/crc.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
 #include <cstdint>
 
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <new>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -49,13 +62,14 @@ namespace storage
 {
 
 using RTreeLeaf = engine::datafacade::BaseDataFacade::RTreeLeaf;
-using RTreeNode =
-    util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>::TreeNode;
+using RTree = util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
+using RTreeNode = RTree::TreeNode;
+using RTreeLeafNode = RTree::LeafNode;
 using QueryGraph = util::StaticGraph<contractor::QueryEdge::EdgeData>;
 
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
 
-int Storage::Run(int max_wait)
+int Storage::Run(int max_wait, bool only_metric)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -113,15 +127,81 @@ int Storage::Run(int max_wait)
     DataLayout layout;
     PopulateLayout(layout);
 
+    // The static blocks are kept in a region of their own, which is reused if only the metric
+    // changed. Otherwise they are loaded into the static region that is not in use.
+    const auto static_checksum = GetStaticChecksum();
+    auto in_use_static_region = REGION_NONE;
+    bool reuse_static_region = false;
+    if (in_use_region != REGION_NONE && storage::SharedMemory::RegionExists(in_use_region))
+    {
+        auto in_use_shared_memory = makeSharedMemory(in_use_region);
+        const auto &in_use_header =
+            *static_cast<const SharedRegionHeader *>(in_use_shared_memory->Ptr());
+        if (in_use_header.static_region == STATIC_REGION_1 ||
+            in_use_header.static_region == STATIC_REGION_2)
+        {
+            in_use_static_region = in_use_header.static_region;
+            reuse_static_region =
+                only_metric && storage::SharedMemory::RegionExists(in_use_static_region) &&
+                in_use_header.layout.HasSameBlocks(layout, DataLayout::STATIC_GROUP) &&
+                in_use_header.static_checksum == static_checksum;
+        }
+    }
+    if (only_metric && !reuse_static_region)
+    {
+        util::Log(logWARNING) << "The static data does not match the data in use, loading all data";
+    }
+
+    // the memory policy has to be set before the pages are touched
+    const auto interleave_numa_nodes = [this](SharedMemory &memory, const std::size_t size) {
+        if (config.interleave_numa_nodes && !util::numa::InterleaveMemory(memory.Ptr(), size))
+        {
+            util::Log(logWARNING) << "Could not interleave the shared memory over NUMA nodes";
+        }
+    };
+
+    auto static_region = in_use_static_region;
+    std::unique_ptr<SharedMemory> static_memory;
+    if (!reuse_static_region)
+    {
+        static_region = in_use_static_region == STATIC_REGION_1 ? STATIC_REGION_2 : STATIC_REGION_1;
+        if (storage::SharedMemory::RegionExists(static_region))
+        {
+            util::Log(logWARNING) << "Old shared memory region " << regionToString(static_region)
+                                  << " still exists.";
+            util::UnbufferedLog() << "Retrying removal... ";
+            storage::SharedMemory::Remove(static_region);
+            util::UnbufferedLog() << "ok.";
+        }
+
+        const auto static_size = layout.GetSizeOfLayout(DataLayout::STATIC_GROUP);
+        util::Log() << "Allocating shared memory of " << static_size << " bytes for "
+                    << regionToString(static_region);
+        static_memory = makeSharedMemory(static_region, static_size, config.use_huge_pages);
+        interleave_numa_nodes(*static_memory, static_size);
+    }
+    else
+    {
+        util::Log() << "Reusing static data of " << regionToString(static_region);
+    }
+
     // Allocate shared memory block
-    auto regions_size = sizeof(layout) + layout.GetSizeOfLayout();
+    auto regions_size =
+        sizeof(SharedRegionHeader) + layout.GetSizeOfLayout(DataLayout::METRIC_GROUP);
     util::Log() << "Allocating shared memory of " << regions_size << " bytes";
-    auto data_memory = makeSharedMemory(next_region, regions_size);
+    auto data_memory = makeSharedMemory(next_region, regions_size, config.use_huge_pages);
+    interleave_numa_nodes(*data_memory, regions_size);
 
     // Copy memory layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(data_memory->Ptr());
-    memcpy(shared_memory_ptr, &layout, sizeof(layout));
-    PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    const SharedRegionHeader header{layout, static_region, static_checksum};
+    memcpy(shared_memory_ptr, &header, sizeof(header));
+
+    DataLayout::GroupMemory memory;
+    memory[DataLayout::STATIC_GROUP] =
+        static_memory ? static_cast<char *>(static_memory->Ptr()) : nullptr;
+    memory[DataLayout::METRIC_GROUP] = shared_memory_ptr + sizeof(header);
+    PopulateData(layout, memory);
 
     { // Lock for write access shared region mutex
         boost::interprocess::scoped_lock<SharedBarrier::mutex_type> lock(
@@ -174,11 +254,128 @@ int Storage::Run(int max_wait)
         util::UnbufferedLog() << " ok.";
     }
 
+    // clients detach the static region together with the data region
+    if (!reuse_static_region && in_use_region != REGION_NONE &&
+        in_use_static_region != REGION_NONE &&
+        storage::SharedMemory::RegionExists(in_use_static_region))
+    {
+        util::UnbufferedLog() << "Marking old shared memory region "
+                              << regionToString(in_use_static_region) << " for removal... ";
+        auto in_use_static_memory = makeSharedMemory(in_use_static_region);
+        storage::SharedMemory::Remove(in_use_static_region);
+        util::UnbufferedLog() << "ok.";
+
+        util::UnbufferedLog() << "Waiting for clients to detach... ";
+        in_use_static_memory->WaitForDetach();
+        util::UnbufferedLog() << " ok.";
+    }
+
     util::Log() << "All clients switched.";
 
     return EXIT_SUCCESS;
 }
 
+int Storage::Export()
+{
+    BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
+
+    util::LogPolicy::GetInstance().Unmute();
+
+    DataLayout layout;
+    PopulateLayout(layout);
+    // blocks are aligned relative to the page aligned memory block
+    for (auto &alignment : layout.entry_align)
+    {
+        alignment = std::max(alignment, CONTAINER_ALIGNMENT);
+    }
+
+    const auto data_size = layout.GetSizeOfLayout();
+    util::Log() << "Allocating " << data_size << " bytes";
+    auto memory = std::make_unique<char[]>(data_size + CONTAINER_ALIGNMENT);
+    void *aligned_ptr = memory.get();
+    std::size_t space = data_size + CONTAINER_ALIGNMENT;
+    aligned_ptr = std::align(CONTAINER_ALIGNMENT, data_size, aligned_ptr, space);
+    BOOST_ASSERT(aligned_ptr != nullptr);
+    const auto data_ptr = static_cast<char *>(aligned_ptr);
+    PopulateData(layout, data_ptr);
+
+    ContainerTOC toc;
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, DataLayout::NUM_BLOCKS, 1),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto block = range.begin(); block != range.end(); ++block)
+                          {
+                              const auto bid = static_cast<DataLayout::BlockID>(block);
+                              const auto block_ptr =
+                                  static_cast<char *>(layout.GetAlignedBlockPtr(data_ptr, bid));
+                              auto &entry = toc[block];
+                              entry.offset = CONTAINER_DATA_OFFSET + (block_ptr - data_ptr);
+                              BOOST_ASSERT(entry.offset == getContainerBlockOffset(layout, bid));
+                              entry.size = layout.GetBlockSize(bid);
+                              entry.checksum = getBlockChecksum(block_ptr, entry.size);
+                              entry.unused = 0;
+                          }
+                      });
+
+    // Processes that still map the old container keep it until they unmap it
+    const auto temporary_path = config.container_path.string() + ".tmp";
+    {
+        util::Log() << "Writing " << config.container_path.string();
+        io::FileWriter container_file(temporary_path, io::FileWriter::GenerateFingerprint);
+        writeContainerHeader(container_file, layout, toc);
+        container_file.WriteFrom(data_ptr, data_size);
+    }
+    boost::filesystem::rename(temporary_path, config.container_path);
+
+    util::Log() << "All data exported.";
+
+    return EXIT_SUCCESS;
+}
+
+std::uint32_t Storage::GetStaticChecksum() const
+{
+    boost::crc_32_type crc;
+    if (config.use_container)
+    {
+        io::FileReader container_file(config.container_path, io::FileReader::VerifyFingerprint);
+        DataLayout layout;
+        ContainerTOC toc;
+        readContainerHeader(container_file, layout, toc);
+        for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+        {
+            if (DataLayout::GetBlockGroup(static_cast<DataLayout::BlockID>(block)) ==
+                DataLayout::STATIC_GROUP)
+            {
+                crc.process_bytes(&toc[block].checksum, sizeof(toc[block].checksum));
+            }
+        }
+        return crc.checksum();
+    }
+
+    // osrm-contract rewrites the .geometry file with new weights, its node list is static but
+    // only changes together with these files
+    for (const auto &path : {config.ram_index_path,
+                             config.file_index_path,
+                             config.nodes_data_path,
+                             config.edges_data_path,
+                             config.names_data_path,
+                             config.properties_path,
+                             config.intersection_class_path,
+                             config.turn_lane_data_path,
+                             config.turn_lane_description_path})
+    {
+        const auto absolute_path = boost::filesystem::absolute(path).string();
+        crc.process_bytes(absolute_path.data(), absolute_path.size());
+        if (boost::filesystem::exists(path))
+        {
+            const std::uint64_t size = boost::filesystem::file_size(path);
+            const std::int64_t modified = boost::filesystem::last_write_time(path);
+            crc.process_bytes(&size, sizeof(size));
+            crc.process_bytes(&modified, sizeof(modified));
+        }
+    }
+    return crc.checksum();
+}
+
 /**
  * This function examines all our data files and figures out how much
  * memory needs to be allocated, and the position of each data structure
@@ -186,6 +383,14 @@ int Storage::Run(int max_wait)
  */
 void Storage::PopulateLayout(DataLayout &layout)
 {
+    if (config.use_container)
+    {
+        io::FileReader container_file(config.container_path, io::FileReader::VerifyFingerprint);
+        ContainerTOC toc;
+        readContainerHeader(container_file, layout, toc);
+        return;
+    }
+
     {
         auto absolute_file_index_path = boost::filesystem::absolute(config.file_index_path);
 
@@ -232,10 +437,12 @@ void Storage::PopulateLayout(DataLayout &layout)
         layout.SetBlockSize<EntryClassID>(DataLayout::ENTRY_CLASSID, number_of_original_edges);
     }
 
+    unsigned hsgr_checksum;
     {
         io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::VerifyFingerprint);
 
         const auto hsgr_header = serialization::readHSGRHeader(hsgr_file);
+        hsgr_checksum = hsgr_header.checksum;
         layout.SetBlockSize<unsigned>(DataLayout::HSGR_CHECKSUM, 1);
         layout.SetBlockSize<QueryGraph::NodeArrayEntry>(DataLayout::GRAPH_NODE_LIST,
                                                         hsgr_header.number_of_nodes);
@@ -245,12 +452,32 @@ void Storage::PopulateLayout(DataLayout &layout)
 
     // load rsearch tree size
     {
-        io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
+        io::FileReader tree_node_file(config.ram_index_path, io::FileReader::VerifyFingerprint);
 
         const auto tree_size = tree_node_file.ReadElementCount64();
         layout.SetBlockSize<RTreeNode>(DataLayout::R_SEARCH_TREE, tree_size);
     }
 
+    // load rsearch tree leaves size. Without them the leaves are mapped from the file index by
+    // each process and paged in by the first queries.
+    if (config.load_rtree_leaves)
+    {
+        io::FileReader leaf_node_file(config.file_index_path, io::FileReader::VerifyFingerprint);
+        const auto leaves_size = leaf_node_file.Size();
+        if (leaves_size < RTree::LEAF_FILE_HEADER_SIZE)
+        {
+            throw util::exception("Error reading from " + config.file_index_path.string() +
+                                  ": Unexpected end of file " + SOURCE_REF);
+        }
+        const auto number_of_leaves =
+            (leaves_size - RTree::LEAF_FILE_HEADER_SIZE) / sizeof(RTreeLeafNode);
+        layout.SetBlockSize<RTreeLeafNode>(DataLayout::R_SEARCH_TREE_LEAVES, number_of_leaves);
+    }
+    else
+    {
+        layout.SetBlockSize<RTreeLeafNode>(DataLayout::R_SEARCH_TREE_LEAVES, 0);
+    }
+
     {
         // allocate space in shared memory for profile properties
         const auto properties_size = serialization::readPropertiesCount();
@@ -271,6 +498,46 @@ void Storage::PopulateLayout(DataLayout &layout)
         layout.SetBlockSize<unsigned>(DataLayout::CORE_MARKER, number_of_core_markers);
     }
 
+    // load level order size. This file is optional, older datasets don't have it and
+    // without it one-to-many queries fall back to the bucket based search.
+    if (boost::filesystem::exists(config.level_order_path))
+    {
+        io::FileReader level_order_file(config.level_order_path,
+                                        io::FileReader::VerifyFingerprint);
+        const auto number_of_nodes = level_order_file.ReadElementCount64();
+        layout.SetBlockSize<NodeID>(DataLayout::NODE_LEVEL_ORDER, number_of_nodes);
+    }
+    else
+    {
+        layout.SetBlockSize<NodeID>(DataLayout::NODE_LEVEL_ORDER, 0);
+    }
+
+    // load shortcut children sizes. This file is optional as well, without it shortcuts are
+    // unpacked by searching the adjacency lists of the graph.
+    layout.SetBlockSize<contractor::ShortcutChildrenBlock>(DataLayout::SHORTCUT_CHILDREN_BLOCKS,
+                                                           0);
+    layout.SetBlockSize<contractor::ShortcutChildren>(DataLayout::SHORTCUT_CHILDREN, 0);
+    if (boost::filesystem::exists(config.shortcut_children_path))
+    {
+        io::FileReader shortcut_children_file(config.shortcut_children_path,
+                                              io::FileReader::VerifyFingerprint);
+        if (shortcut_children_file.ReadOne<unsigned>() == hsgr_checksum)
+        {
+            const auto number_of_blocks = shortcut_children_file.ReadElementCount64();
+            shortcut_children_file.Skip<contractor::ShortcutChildrenBlock>(number_of_blocks);
+            const auto number_of_shortcuts = shortcut_children_file.ReadElementCount64();
+            layout.SetBlockSize<contractor::ShortcutChildrenBlock>(
+                DataLayout::SHORTCUT_CHILDREN_BLOCKS, number_of_blocks);
+            layout.SetBlockSize<contractor::ShortcutChildren>(DataLayout::SHORTCUT_CHILDREN,
+                                                              number_of_shortcuts);
+        }
+        else
+        {
+            util::Log(logWARNING) << config.shortcut_children_path.string()
+                                  << " does not match the graph and is ignored";
+        }
+    }
+
     // load turn weight penalties
     {
         io::FileReader turn_weight_penalties_file(config.turn_weight_penalties_path,
@@ -395,11 +662,36 @@ void Storage::PopulateLayout(DataLayout &layout)
 void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
+    PopulateData(layout, layout.GetGroupMemory(memory_ptr));
+}
+
+void Storage::PopulateData(const DataLayout &layout, const DataLayout::GroupMemory &memory_ptr)
+{
+    BOOST_ASSERT(memory_ptr[DataLayout::METRIC_GROUP] != nullptr);
+
+    if (config.use_container)
+    {
+        PopulateDataFromContainer(layout, memory_ptr);
+        return;
+    }
 
     // read actual data into shared memory object //
 
+    // Every block is written by exactly one loader, so the files are read concurrently. Large
+    // blocks are additionally read in parallel chunks.
+    tbb::task_group loaders;
+
+    // Without memory for the static group its blocks are shared with the data in use
+    const bool load_static_blocks = memory_ptr[DataLayout::STATIC_GROUP] != nullptr;
+    const auto run_static_loader = [&](const auto &loader) {
+        if (load_static_blocks)
+        {
+            loaders.run(loader);
+        }
+    };
+
     // Load the HSGR file
-    {
+    loaders.run([&] {
         io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::VerifyFingerprint);
         auto hsgr_header = serialization::readHSGRHeader(hsgr_file);
         unsigned *checksum_ptr =
@@ -421,10 +713,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                 hsgr_header.number_of_nodes,
                                 graph_edge_list_ptr,
                                 hsgr_header.number_of_edges);
-    }
+    });
 
     // store the filename of the on-disk portion of the RTree
-    {
+    run_static_loader([&] {
         const auto file_index_path_ptr =
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::FILE_INDEX_PATH);
         // make sure we have 0 ending
@@ -437,10 +729,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                      absolute_file_index_path.size());
         std::copy(
             absolute_file_index_path.begin(), absolute_file_index_path.end(), file_index_path_ptr);
-    }
+    });
 
     // Name data
-    {
+    run_static_loader([&] {
         io::FileReader name_file(config.names_data_path, io::FileReader::HasNoFingerprint);
         std::size_t name_file_size = name_file.GetSize();
 
@@ -448,11 +740,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         const auto name_char_ptr =
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::NAME_CHAR_DATA);
 
-        name_file.ReadInto<char>(name_char_ptr, name_file_size);
-    }
+        name_file.ReadIntoParallel(name_char_ptr, name_file_size);
+    });
 
     // Turn lane data
-    {
+    run_static_loader([&] {
         io::FileReader lane_data_file(config.turn_lane_data_path, io::FileReader::HasNoFingerprint);
 
         const auto lane_tuple_count = lane_data_file.ReadElementCount64();
@@ -464,10 +756,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(lane_tuple_count * sizeof(util::guidance::LaneTupleIdPair) ==
                      layout.GetBlockSize(DataLayout::TURN_LANE_DATA));
         lane_data_file.ReadInto(turn_lane_data_ptr, lane_tuple_count);
-    }
+    });
 
     // Turn lane descriptions
-    {
+    run_static_loader([&] {
         std::vector<std::uint32_t> lane_description_offsets;
         std::vector<extractor::guidance::TurnLaneType::Mask> lane_description_masks;
         util::deserializeAdjacencyArray(config.turn_lane_description_path.string(),
@@ -500,10 +792,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             std::copy(
                 lane_description_masks.begin(), lane_description_masks.end(), turn_lane_mask_ptr);
         }
-    }
+    });
 
     // Load original edge data
-    {
+    run_static_loader([&] {
         io::FileReader edges_input_file(config.edges_data_path, io::FileReader::HasNoFingerprint);
 
         const auto number_of_original_edges = edges_input_file.ReadElementCount64();
@@ -541,52 +833,71 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                  pre_turn_bearing_ptr,
                                  post_turn_bearing_ptr,
                                  number_of_original_edges);
-    }
+    });
 
     // load compressed geometry
-    {
+    loaders.run([&] {
         io::FileReader geometry_input_file(config.geometries_path,
                                            io::FileReader::HasNoFingerprint);
 
         const auto geometry_index_count = geometry_input_file.ReadElementCount32();
-        const auto geometries_index_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::GEOMETRIES_INDEX);
         BOOST_ASSERT(geometry_index_count == layout.num_entries[DataLayout::GEOMETRIES_INDEX]);
-        geometry_input_file.ReadInto(geometries_index_ptr, geometry_index_count);
+        if (load_static_blocks)
+        {
+            const auto geometries_index_ptr =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::GEOMETRIES_INDEX);
+            geometry_input_file.ReadIntoParallel(geometries_index_ptr, geometry_index_count);
+        }
+        else
+        {
+            geometry_input_file.Skip<unsigned>(geometry_index_count);
+        }
 
-        const auto geometries_node_id_list_ptr =
-            layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
         const auto geometry_node_lists_count = geometry_input_file.ReadElementCount32();
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST]);
-        geometry_input_file.ReadInto(geometries_node_id_list_ptr, geometry_node_lists_count);
+        if (load_static_blocks)
+        {
+            const auto geometries_node_id_list_ptr =
+                layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
+            geometry_input_file.ReadIntoParallel(geometries_node_id_list_ptr,
+                                                 geometry_node_lists_count);
+        }
+        else
+        {
+            geometry_input_file.Skip<NodeID>(geometry_node_lists_count);
+        }
 
         const auto geometries_fwd_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]);
-        geometry_input_file.ReadInto(geometries_fwd_weight_list_ptr, geometry_node_lists_count);
+        geometry_input_file.ReadIntoParallel(geometries_fwd_weight_list_ptr,
+                                             geometry_node_lists_count);
 
         const auto geometries_rev_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
-        geometry_input_file.ReadInto(geometries_rev_weight_list_ptr, geometry_node_lists_count);
+        geometry_input_file.ReadIntoParallel(geometries_rev_weight_list_ptr,
+                                             geometry_node_lists_count);
 
         const auto geometries_fwd_duration_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_FWD_DURATION_LIST);
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_FWD_DURATION_LIST]);
-        geometry_input_file.ReadInto(geometries_fwd_duration_list_ptr, geometry_node_lists_count);
+        geometry_input_file.ReadIntoParallel(geometries_fwd_duration_list_ptr,
+                                             geometry_node_lists_count);
 
         const auto geometries_rev_duration_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_REV_DURATION_LIST);
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_REV_DURATION_LIST]);
-        geometry_input_file.ReadInto(geometries_rev_duration_list_ptr, geometry_node_lists_count);
-    }
+        geometry_input_file.ReadIntoParallel(geometries_rev_duration_list_ptr,
+                                             geometry_node_lists_count);
+    });
 
-    {
+    loaders.run([&] {
         io::FileReader geometry_datasource_file(config.datasource_indexes_path,
                                                 io::FileReader::HasNoFingerprint);
         const auto number_of_compressed_datasources = geometry_datasource_file.ReadElementCount64();
@@ -599,9 +910,9 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             serialization::readDatasourceIndexes(
                 geometry_datasource_file, datasources_list_ptr, number_of_compressed_datasources);
         }
-    }
+    });
 
-    {
+    loaders.run([&] {
         /* Load names */
         io::FileReader datasource_names_file(config.datasource_names_path,
                                              io::FileReader::HasNoFingerprint);
@@ -648,10 +959,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                       datasource_names_data.lengths.end(),
                       datasource_name_lengths_ptr);
         }
-    }
+    });
 
     // Loading list of coordinates
-    {
+    run_static_loader([&] {
         io::FileReader nodes_file(config.nodes_data_path, io::FileReader::HasNoFingerprint);
         nodes_file.Skip<std::uint64_t>(1); // node_count
         const auto coordinates_ptr =
@@ -666,30 +977,32 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                  coordinates_ptr,
                                  osmnodeid_list,
                                  layout.num_entries[DataLayout::COORDINATE_LIST]);
-    }
+    });
 
     // load turn weight penalties
-    {
+    loaders.run([&] {
         io::FileReader turn_weight_penalties_file(config.turn_weight_penalties_path,
                                                   io::FileReader::HasNoFingerprint);
         const auto number_of_penalties = turn_weight_penalties_file.ReadElementCount64();
         const auto turn_weight_penalties_ptr =
             layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_WEIGHT_PENALTIES);
-        turn_weight_penalties_file.ReadInto(turn_weight_penalties_ptr, number_of_penalties);
-    }
+        turn_weight_penalties_file.ReadIntoParallel(turn_weight_penalties_ptr,
+                                                    number_of_penalties);
+    });
 
     // load turn duration penalties
-    {
+    loaders.run([&] {
         io::FileReader turn_duration_penalties_file(config.turn_duration_penalties_path,
                                                     io::FileReader::HasNoFingerprint);
         const auto number_of_penalties = turn_duration_penalties_file.ReadElementCount64();
         const auto turn_duration_penalties_ptr =
             layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_DURATION_PENALTIES);
-        turn_duration_penalties_file.ReadInto(turn_duration_penalties_ptr, number_of_penalties);
-    }
+        turn_duration_penalties_file.ReadIntoParallel(turn_duration_penalties_ptr,
+                                                      number_of_penalties);
+    });
 
     // store timestamp
-    {
+    loaders.run([&] {
         io::FileReader timestamp_file(config.timestamp_path, io::FileReader::HasNoFingerprint);
         const auto timestamp_size = timestamp_file.Size();
 
@@ -697,21 +1010,35 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::TIMESTAMP);
         BOOST_ASSERT(timestamp_size == layout.num_entries[DataLayout::TIMESTAMP]);
         timestamp_file.ReadInto(timestamp_ptr, timestamp_size);
-    }
+    });
 
     // store search tree portion of rtree
-    {
-        io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
+    run_static_loader([&] {
+        io::FileReader tree_node_file(config.ram_index_path, io::FileReader::VerifyFingerprint);
         // perform this read so that we're at the right stream position for the next
         // read.
         tree_node_file.Skip<std::uint64_t>(1);
         const auto rtree_ptr =
             layout.GetBlockPtr<RTreeNode, true>(memory_ptr, DataLayout::R_SEARCH_TREE);
 
-        tree_node_file.ReadInto(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
-    }
+        tree_node_file.ReadIntoParallel(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
+    });
 
+    // store leaves of rtree
+    if (layout.num_entries[DataLayout::R_SEARCH_TREE_LEAVES] > 0)
     {
+        run_static_loader([&] {
+            io::FileReader leaf_node_file(config.file_index_path,
+                                          io::FileReader::VerifyFingerprint);
+            leaf_node_file.Skip<char>(RTree::LEAF_FILE_HEADER_SIZE - sizeof(util::FingerPrint));
+            const auto leaves_ptr = layout.GetBlockPtr<RTreeLeafNode, true>(
+                memory_ptr, DataLayout::R_SEARCH_TREE_LEAVES);
+            leaf_node_file.ReadIntoParallel(leaves_ptr,
+                                            layout.num_entries[DataLayout::R_SEARCH_TREE_LEAVES]);
+        });
+    }
+
+    loaders.run([&] {
         io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
         const auto number_of_core_markers = core_marker_file.ReadElementCount32();
 
@@ -742,20 +1069,58 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                 core_marker_ptr[bucket] = (value | (1u << offset));
             }
         }
+    });
+
+    // load level order
+    if (layout.num_entries[DataLayout::NODE_LEVEL_ORDER] > 0)
+    {
+        loaders.run([&] {
+            io::FileReader level_order_file(config.level_order_path,
+                                            io::FileReader::VerifyFingerprint);
+            const auto number_of_nodes = level_order_file.ReadElementCount64();
+            BOOST_ASSERT(number_of_nodes == layout.num_entries[DataLayout::NODE_LEVEL_ORDER]);
+
+            const auto level_order_ptr =
+                layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::NODE_LEVEL_ORDER);
+            level_order_file.ReadIntoParallel(level_order_ptr, number_of_nodes);
+        });
     }
 
-    // load profile properties
+    // load shortcut children
+    if (layout.num_entries[DataLayout::SHORTCUT_CHILDREN_BLOCKS] > 0)
     {
+        loaders.run([&] {
+            io::FileReader shortcut_children_file(config.shortcut_children_path,
+                                                  io::FileReader::VerifyFingerprint);
+            shortcut_children_file.Skip<unsigned>(1);
+
+            const auto number_of_blocks = shortcut_children_file.ReadElementCount64();
+            BOOST_ASSERT(number_of_blocks ==
+                         layout.num_entries[DataLayout::SHORTCUT_CHILDREN_BLOCKS]);
+            const auto blocks_ptr = layout.GetBlockPtr<contractor::ShortcutChildrenBlock, true>(
+                memory_ptr, DataLayout::SHORTCUT_CHILDREN_BLOCKS);
+            shortcut_children_file.ReadIntoParallel(blocks_ptr, number_of_blocks);
+
+            const auto number_of_shortcuts = shortcut_children_file.ReadElementCount64();
+            BOOST_ASSERT(number_of_shortcuts == layout.num_entries[DataLayout::SHORTCUT_CHILDREN]);
+            const auto children_ptr = layout.GetBlockPtr<contractor::ShortcutChildren, true>(
+                memory_ptr, DataLayout::SHORTCUT_CHILDREN);
+            shortcut_children_file.ReadIntoParallel(children_ptr, number_of_shortcuts);
+        });
+    }
+
+    // load profile properties
+    run_static_loader([&] {
         io::FileReader profile_properties_file(config.properties_path,
                                                io::FileReader::HasNoFingerprint);
         const auto profile_properties_ptr = layout.GetBlockPtr<extractor::ProfileProperties, true>(
             memory_ptr, DataLayout::PROPERTIES);
         profile_properties_file.ReadInto(profile_properties_ptr,
                                          layout.num_entries[DataLayout::PROPERTIES]);
-    }
+    });
 
     // Load intersection data
-    {
+    run_static_loader([&] {
         io::FileReader intersection_file(config.intersection_class_path,
                                          io::FileReader::VerifyFingerprint);
 
@@ -836,7 +1201,55 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                              sizeof(decltype(entry_class_table)::value_type));
             std::copy(entry_class_table.begin(), entry_class_table.end(), entry_class_ptr);
         }
-    }
+    });
+
+    loaders.wait();
+}
+
+// Every block is read straight from its offset in the container and checked against its
+// checksum
+void Storage::PopulateDataFromContainer(const DataLayout &layout,
+                                        const DataLayout::GroupMemory &memory_ptr)
+{
+    io::FileReader container_file(config.container_path, io::FileReader::VerifyFingerprint);
+    DataLayout container_layout;
+    ContainerTOC toc;
+    readContainerHeader(container_file, container_layout, toc);
+
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, DataLayout::NUM_BLOCKS, 1),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            for (auto block = range.begin(); block != range.end(); ++block)
+            {
+                const auto bid = static_cast<DataLayout::BlockID>(block);
+                if (memory_ptr[DataLayout::GetBlockGroup(bid)] == nullptr)
+                {
+                    continue;
+                }
+
+                // readContainerHeader checked the entry against the layout of the container
+                const auto &entry = toc[block];
+                if (entry.size != layout.GetBlockSize(bid))
+                {
+                    throw util::exception("Size of block " + std::string(block_id_to_name[bid]) +
+                                          " does not match the layout in " +
+                                          config.container_path.string() + SOURCE_REF);
+                }
+
+                const auto block_ptr = layout.GetBlockPtr<char, true>(memory_ptr, bid);
+                io::FileReader block_file(config.container_path,
+                                          io::FileReader::HasNoFingerprint);
+                block_file.Skip<char>(entry.offset);
+                block_file.ReadIntoParallel(block_ptr, entry.size);
+
+                if (getBlockChecksum(block_ptr, entry.size) != entry.checksum)
+                {
+                    throw util::exception("Checksum mismatch of block " +
+                                          std::string(block_id_to_name[bid]) + " in " +
+                                          config.container_path.string() + SOURCE_REF);
+                }
+            }
+        });
 }
 }
 }
@@ -12,6 +12,8 @@ StorageConfig::StorageConfig(const boost::filesystem::path &base)
     : ram_index_path{base.string() + ".ramIndex"}, file_index_path{base.string() + ".fileIndex"},
       hsgr_data_path{base.string() + ".hsgr"}, nodes_data_path{base.string() + ".nodes"},
       edges_data_path{base.string() + ".edges"}, core_data_path{base.string() + ".core"},
+      level_order_path{base.string() + ".level_order"},
+      shortcut_children_path{base.string() + ".shortcuts"},
       geometries_path{base.string() + ".geometry"}, timestamp_path{base.string() + ".timestamp"},
       turn_weight_penalties_path{base.string() + ".turn_weight_penalties"},
       turn_duration_penalties_path{base.string() + ".turn_duration_penalties"},
@@ -19,12 +21,23 @@ StorageConfig::StorageConfig(const boost::filesystem::path &base)
       datasource_indexes_path{base.string() + ".datasource_indexes"},
       names_data_path{base.string() + ".names"}, properties_path{base.string() + ".properties"},
       intersection_class_path{base.string() + ".icd"}, turn_lane_data_path{base.string() + ".tld"},
-      turn_lane_description_path{base.string() + ".tls"}
+      turn_lane_description_path{base.string() + ".tls"},
+      container_path{base.string() + ".container"}
 {
 }
 
 bool StorageConfig::IsValid() const
 {
+    if (use_container)
+    {
+        if (!boost::filesystem::is_regular_file(container_path))
+        {
+            util::Log(logWARNING) << "Missing/Broken File: " << container_path.string();
+            return false;
+        }
+        return true;
+    }
+
     const constexpr auto num_files = 15;
     const boost::filesystem::path paths[num_files] = {ram_index_path,
                                                       file_index_path,
@@ -57,6 +57,13 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         boost::program_options::value<bool>(&contractor_config.use_cached_priority)
             ->default_value(false),
         "Use .level file to retain the contaction level for each node from the last run.")(
+        "customize",
+        boost::program_options::value<bool>(&contractor_config.customize)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Keep the shortcuts of the existing .hsgr file and only recompute their weights. Takes "
+        "seconds to minutes instead of hours, but routes can be suboptimal after large weight "
+        "changes until the graph is contracted again.")(
         "edge-weight-updates-over-factor",
         boost::program_options::value<double>(&contractor_config.log_edge_updates_factor)
             ->default_value(0.0),
@@ -0,0 +1,416 @@
+#include "engine/api/match_parameters.hpp"
+#include "engine/data_watchdog.hpp"
+#include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "engine/guidance/assemble_geometry.hpp"
+#include "engine/plugins/match.hpp"
+#include "storage/storage_config.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+#include "util/version.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Matches archived GPS traces in parallel, without the overhead of HTTP requests.
+//
+// The input is a CSV file with one trace point per line and the points of a trace on
+// consecutive lines:
+//
+//   trace_id,longitude,latitude[,timestamp[,radius]]
+//
+// Empty lines and lines starting with `#` are skipped. For every matching of a trace one line is
+// written, with the OSM node ids of the matched route separated by spaces:
+//
+//   trace_id,matching_index,confidence,node_id node_id ...
+//
+// Traces that can not be matched are skipped.
+
+using namespace osrm;
+
+namespace
+{
+
+struct Trace
+{
+    std::string id;
+    engine::api::MatchParameters parameters;
+};
+
+class TraceReader
+{
+  public:
+    TraceReader(std::istream &input) : input(input), line_number(0) {}
+
+    // Reads up to `max_traces` traces, returns no traces once the input is exhausted
+    std::vector<Trace> Read(const std::size_t max_traces)
+    {
+        std::vector<Trace> traces;
+        std::string line;
+        while (traces.size() < max_traces && std::getline(input, line))
+        {
+            ++line_number;
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            std::istringstream line_stream(line);
+            std::string field;
+            while (std::getline(line_stream, field, ','))
+            {
+                fields.push_back(field);
+            }
+            if (fields.size() < 3 || fields.size() > 5)
+            {
+                throw util::exception("Invalid trace point in line " +
+                                      std::to_string(line_number) + SOURCE_REF);
+            }
+
+            if (current && current->id != fields[0])
+            {
+                traces.push_back(std::move(*current));
+                current = boost::none;
+            }
+            if (!current)
+            {
+                current = Trace{fields[0], {}};
+            }
+
+            try
+            {
+                auto &parameters = current->parameters;
+                parameters.coordinates.emplace_back(util::FloatLongitude{std::stod(fields[1])},
+                                                    util::FloatLatitude{std::stod(fields[2])});
+                if (fields.size() > 3 && !fields[3].empty())
+                {
+                    parameters.timestamps.push_back(std::stoul(fields[3]));
+                }
+                if (fields.size() > 4 && !fields[4].empty())
+                {
+                    parameters.radiuses.push_back(std::stod(fields[4]));
+                }
+                else
+                {
+                    parameters.radiuses.push_back(boost::none);
+                }
+            }
+            catch (const std::logic_error &)
+            {
+                throw util::exception("Invalid trace point in line " +
+                                      std::to_string(line_number) + SOURCE_REF);
+            }
+        }
+
+        // the last trace ends with the input
+        if (traces.size() < max_traces && current)
+        {
+            traces.push_back(std::move(*current));
+            current = boost::none;
+        }
+
+        return traces;
+    }
+
+  private:
+    std::istream &input;
+    std::size_t line_number;
+    boost::optional<Trace> current;
+};
+
+// Returns one line per matching, empty if the trace could not be matched
+std::string matchTrace(const std::shared_ptr<const engine::datafacade::BaseDataFacade> &facade,
+                       const engine::plugins::MatchPlugin &match_plugin,
+                       const Trace &trace)
+{
+    const auto &parameters = trace.parameters;
+    const auto time_increases_monotonically = std::is_sorted(
+        parameters.timestamps.rbegin(), parameters.timestamps.rend(), std::greater<>{});
+    if (!parameters.IsValid() || !time_increases_monotonically ||
+        !std::all_of(parameters.coordinates.begin(),
+                     parameters.coordinates.end(),
+                     [](const util::Coordinate coordinate) { return coordinate.IsValid(); }))
+    {
+        return {};
+    }
+
+    std::vector<engine::InternalRouteResult> sub_routes;
+    const auto sub_matchings = match_plugin.MatchTrace(facade, parameters, sub_routes);
+
+    std::ostringstream output;
+    for (const auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+    {
+        const auto &sub_route = sub_routes[index];
+        output << trace.id << ',' << index << ',' << sub_matchings[index].confidence << ',';
+
+        OSMNodeID last_node = SPECIAL_OSM_NODEID;
+        const auto number_of_legs = sub_route.segment_end_coordinates.size();
+        for (const auto leg : util::irange<std::size_t>(0UL, number_of_legs))
+        {
+            const auto &phantoms = sub_route.segment_end_coordinates[leg];
+            const auto geometry =
+                engine::guidance::assembleGeometry(*facade,
+                                                   sub_route.unpacked_path_segments[leg],
+                                                   phantoms.source_phantom,
+                                                   phantoms.target_phantom,
+                                                   sub_route.source_traversed_in_reverse[leg],
+                                                   sub_route.target_traversed_in_reverse[leg]);
+            for (const auto node : geometry.osm_node_ids)
+            {
+                // consecutive legs share the node at the trace point
+                if (node == last_node)
+                {
+                    continue;
+                }
+                if (last_node != SPECIAL_OSM_NODEID)
+                {
+                    output << ' ';
+                }
+                output << static_cast<std::uint64_t>(node);
+                last_node = node;
+            }
+        }
+        output << '\n';
+    }
+
+    return output.str();
+}
+
+enum class InitResult
+{
+    Run,
+    Exit,
+    Fail
+};
+
+InitResult generateMatchBatchOptions(const int argc,
+                                     const char *argv[],
+                                     boost::filesystem::path &base_path,
+                                     boost::filesystem::path &input_path,
+                                     boost::filesystem::path &output_path,
+                                     bool &use_shared_memory,
+                                     unsigned &requested_num_threads,
+                                     std::size_t &batch_size)
+{
+    using boost::program_options::value;
+
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options() //
+        ("input,i",
+         value<boost::filesystem::path>(&input_path)->required(),
+         "CSV file with the trace points") //
+        ("output,o",
+         value<boost::filesystem::path>(&output_path)->required(),
+         "File to write the matchings to") //
+        ("shared-memory,s",
+         value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
+         "Load data from shared memory") //
+        ("threads,t",
+         value<unsigned>(&requested_num_threads)
+             ->default_value(tbb::task_scheduler_init::default_num_threads()),
+         "Number of threads to use") //
+        ("batch-size",
+         value<std::size_t>(&batch_size)->default_value(4096),
+         "Number of traces that are read and matched at once");
+
+    // hidden options, will be allowed on command line, but will not be shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "base,b", value<boost::filesystem::path>(&base_path), "base path to .osrm file");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("base", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        boost::filesystem::path(executable).filename().string() + " <base.osrm> [<options>]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+
+        if (option_variables.count("version"))
+        {
+            std::cout << OSRM_VERSION << std::endl;
+            return InitResult::Exit;
+        }
+
+        if (option_variables.count("help"))
+        {
+            std::cout << visible_options;
+            return InitResult::Exit;
+        }
+
+        boost::program_options::notify(option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return InitResult::Fail;
+    }
+
+    if (use_shared_memory == static_cast<bool>(option_variables.count("base")))
+    {
+        util::Log(logERROR) << "Either a base path or shared memory needs to be given.";
+        std::cout << visible_options;
+        return InitResult::Fail;
+    }
+
+    if (requested_num_threads < 1 || batch_size < 1)
+    {
+        util::Log(logERROR) << "Number of threads and batch size must be 1 or larger";
+        return InitResult::Fail;
+    }
+
+    return InitResult::Run;
+}
+}
+
+int main(const int argc, const char *argv[]) try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    boost::filesystem::path base_path;
+    boost::filesystem::path input_path;
+    boost::filesystem::path output_path;
+    bool use_shared_memory = false;
+    unsigned requested_num_threads;
+    std::size_t batch_size;
+    const auto init_result = generateMatchBatchOptions(argc,
+                                                       argv,
+                                                       base_path,
+                                                       input_path,
+                                                       output_path,
+                                                       use_shared_memory,
+                                                       requested_num_threads,
+                                                       batch_size);
+    if (init_result == InitResult::Exit)
+    {
+        return EXIT_SUCCESS;
+    }
+    if (init_result == InitResult::Fail)
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input(input_path.string());
+    if (!input)
+    {
+        util::Log(logERROR) << "Could not open " << input_path.string();
+        return EXIT_FAILURE;
+    }
+    std::ofstream output(output_path.string());
+    if (!output)
+    {
+        util::Log(logERROR) << "Could not open " << output_path.string();
+        return EXIT_FAILURE;
+    }
+
+    // The dataset is loaded once and used for all traces, an update of shared memory does not
+    // affect the running matching.
+    std::unique_ptr<engine::DataWatchdog> watchdog;
+    std::shared_ptr<const engine::datafacade::BaseDataFacade> facade;
+    if (use_shared_memory)
+    {
+        util::Log() << "Loading from shared memory";
+        watchdog = std::make_unique<engine::DataWatchdog>(0);
+        facade = watchdog->GetDataFacade();
+    }
+    else
+    {
+        storage::StorageConfig storage_config(base_path);
+        if (!storage_config.IsValid())
+        {
+            util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
+            return EXIT_FAILURE;
+        }
+        facade = std::make_shared<const engine::datafacade::ContiguousInternalMemoryDataFacade>(
+            std::make_unique<engine::datafacade::ProcessMemoryAllocator>(storage_config), 0);
+    }
+
+    tbb::task_scheduler_init init(requested_num_threads);
+    util::Log() << "Threads: " << requested_num_threads;
+
+    // the search heaps of the plugin are thread local, traces are matched without sessions
+    const engine::plugins::MatchPlugin match_plugin(0, 0);
+
+    TIMER_START(matching);
+    std::size_t number_of_traces = 0;
+    std::size_t number_of_unmatched_traces = 0;
+
+    TraceReader reader(input);
+    for (auto traces = reader.Read(batch_size); !traces.empty(); traces = reader.Read(batch_size))
+    {
+        std::vector<std::string> matchings(traces.size());
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, traces.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  matchings[index] =
+                                      matchTrace(facade, match_plugin, traces[index]);
+                              }
+                          });
+
+        // write the matchings in the order of the input
+        for (const auto &matching : matchings)
+        {
+            number_of_unmatched_traces += matching.empty();
+            output << matching;
+        }
+        number_of_traces += traces.size();
+    }
+    TIMER_STOP(matching);
+
+    util::Log() << "Matched " << (number_of_traces - number_of_unmatched_traces) << " of "
+                << number_of_traces << " traces in " << TIMER_SEC(matching) << "s";
+
+    return EXIT_SUCCESS;
+}
+catch (const std::bad_alloc &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    util::Log(logERROR) << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
@@ -56,12 +56,23 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              int &ip_port,
                                              int &requested_num_threads,
                                              bool &use_shared_memory,
+                                             bool &use_mmap,
+                                             bool &use_huge_pages,
+                                             bool &use_numa,
                                              bool &trial,
                                              int &max_locations_trip,
                                              int &max_locations_viaroute,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
-                                             int &max_results_nearest)
+                                             int &max_matching_sessions,
+                                             int &max_results_nearest,
+                                             int &max_duration_isochrone,
+                                             int &max_alternatives,
+                                             int &trip_search_time,
+                                             int &max_locations_optimize,
+                                             int &optimize_search_time,
+                                             int &max_locations_nearest,
+                                             std::size_t &unpacking_cache_size)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -87,21 +98,55 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("mmap",
+         value<bool>(&use_mmap)->implicit_value(true)->default_value(false),
+         "Map the .container file written by osrm-datastore --export instead of loading the "
+         "files") //
+        ("huge-pages",
+         value<bool>(&use_huge_pages)->implicit_value(true)->default_value(false),
+         "Back the memory the files are loaded into with transparent huge pages") //
+        ("numa",
+         value<bool>(&use_numa)->implicit_value(true)->default_value(false),
+         "Pin the threads to NUMA nodes and copy the data loaded from files to every node") //
         ("max-viaroute-size",
          value<int>(&max_locations_viaroute)->default_value(500),
          "Max. locations supported in viaroute query") //
         ("max-trip-size",
          value<int>(&max_locations_trip)->default_value(100),
          "Max. locations supported in trip query") //
+        ("trip-search-time",
+         value<int>(&trip_search_time)->default_value(100),
+         "Time in milliseconds to improve trips with many locations, 0 disables restarts") //
+        ("max-optimize-size",
+         value<int>(&max_locations_optimize)->default_value(100),
+         "Max. locations supported in optimize query") //
+        ("optimize-search-time",
+         value<int>(&optimize_search_time)->default_value(1000),
+         "Time in milliseconds to improve vehicle routes, 0 disables the search") //
         ("max-table-size",
          value<int>(&max_locations_distance_table)->default_value(100),
          "Max. locations supported in distance table query") //
         ("max-matching-size",
          value<int>(&max_locations_map_matching)->default_value(100),
          "Max. locations supported in map matching query") //
+        ("max-matching-sessions",
+         value<int>(&max_matching_sessions)->default_value(1000),
+         "Max. number of open map matching sessions") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
-         "Max. results supported in nearest query");
+         "Max. results supported in nearest query") //
+        ("max-nearest-locations",
+         value<int>(&max_locations_nearest)->default_value(100000),
+         "Max. locations supported in one nearest query") //
+        ("max-isochrone-duration",
+         value<int>(&max_duration_isochrone)->default_value(3600),
+         "Max. travel time in seconds supported in isochrone query") //
+        ("max-alternatives",
+         value<int>(&max_alternatives)->default_value(3),
+         "Max. number of alternatives supported in route query") //
+        ("unpacking-cache-size",
+         value<std::size_t>(&unpacking_cache_size)->default_value(0),
+         "Number of unpacked shortcut edges to cache, 0 disables the cache");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -151,7 +196,11 @@ inline unsigned generateServerProgramOptions(const int argc,
 
     boost::program_options::notify(option_variables);
 
-    if (!use_shared_memory && option_variables.count("base"))
+    if (use_shared_memory && use_mmap)
+    {
+        util::Log(logWARNING) << "Shared memory settings conflict with mmap settings.";
+    }
+    else if (!use_shared_memory && option_variables.count("base"))
     {
         return INIT_OK_START_ENGINE;
     }
@@ -164,6 +213,7 @@ inline unsigned generateServerProgramOptions(const int argc,
         util::Log(logWARNING) << "Shared memory settings conflict with path settings.";
     }
 
+
     std::cout << visible_options;
     return INIT_OK_DO_NOT_START_ENGINE;
 }
@@ -178,6 +228,7 @@ int main(int argc, const char *argv[]) try
 
     EngineConfig config;
     boost::filesystem::path base_path;
+    bool use_huge_pages = false;
     const unsigned init_result = generateServerProgramOptions(argc,
                                                               argv,
                                                               base_path,
@@ -185,12 +236,23 @@ int main(int argc, const char *argv[]) try
                                                               ip_port,
                                                               requested_thread_num,
                                                               config.use_shared_memory,
+                                                              config.use_mmap,
+                                                              use_huge_pages,
+                                                              config.use_numa,
                                                               trial_run,
                                                               config.max_locations_trip,
                                                               config.max_locations_viaroute,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
-                                                              config.max_results_nearest);
+                                                              config.max_matching_sessions,
+                                                              config.max_results_nearest,
+                                                              config.max_duration_isochrone,
+                                                              config.max_alternatives,
+                                                              config.trip_search_time,
+                                                              config.max_locations_optimize,
+                                                              config.optimize_search_time,
+                                                              config.max_locations_nearest,
+                                                              config.unpacking_cache_size);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -203,12 +265,26 @@ int main(int argc, const char *argv[]) try
     {
         config.storage_config = storage::StorageConfig(base_path);
     }
+    config.storage_config.use_huge_pages = use_huge_pages;
+    if (use_huge_pages && config.use_shared_memory)
+    {
+        util::Log(logWARNING) << "--huge-pages has no effect with shared memory, pass it to "
+                                 "osrm-datastore instead";
+    }
+    else if (use_huge_pages && config.use_mmap)
+    {
+        util::Log(logWARNING) << "--huge-pages has no effect with --mmap";
+    }
     if (!config.IsValid())
     {
         if (base_path.empty() != config.use_shared_memory)
         {
             util::Log(logWARNING) << "Path settings and shared memory conflicts.";
         }
+        else if (config.use_mmap)
+        {
+            util::Log(logWARNING) << config.storage_config.container_path << " is not found";
+        }
         else
         {
             if (!boost::filesystem::is_regular_file(config.storage_config.ram_index_path))
@@ -284,7 +360,8 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto routing_server = server::Server::CreateServer(
+        ip_address, ip_port, requested_thread_num, config.use_numa);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
@@ -44,6 +44,8 @@ void springClean()
     {
         deleteRegion(storage::REGION_1);
         deleteRegion(storage::REGION_2);
+        deleteRegion(storage::STATIC_REGION_1);
+        deleteRegion(storage::STATIC_REGION_2);
         removeLocks();
     }
 }
@@ -52,7 +54,13 @@ void springClean()
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              bool &load_rtree_leaves,
+                              bool &export_container,
+                              bool &use_container,
+                              bool &only_metric,
+                              bool &use_huge_pages,
+                              bool &interleave_numa_nodes)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -66,7 +74,42 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()("max-wait",
                                  boost::program_options::value<int>(&max_wait)->default_value(-1),
                                  "Maximum number of seconds to wait on a running data update "
-                                 "before aquiring the lock by force.");
+                                 "before aquiring the lock by force.")(
+        "load-rtree-leaves",
+        boost::program_options::value<bool>(&load_rtree_leaves)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Load the leaves of the r-tree into shared memory instead of mapping the .fileIndex "
+        "file in every process")(
+        "export",
+        boost::program_options::value<bool>(&export_container)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Write the data with the r-tree leaves to a .container file that osrm-routed --mmap "
+        "maps, instead of loading it into shared memory")(
+        "container",
+        boost::program_options::value<bool>(&use_container)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Load the data from the .container file written by --export instead of the other "
+        "files")(
+        "only-metric",
+        boost::program_options::value<bool>(&only_metric)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Only load the graph and weights and share all other data with the data in use. Falls "
+        "back to loading all data if the other data has changed")(
+        "huge-pages",
+        boost::program_options::value<bool>(&use_huge_pages)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Back the shared memory with huge pages. Falls back to normal pages if no huge pages are "
+        "reserved or the user is not allowed to use them")(
+        "numa-interleave",
+        boost::program_options::value<bool>(&interleave_numa_nodes)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Spread the shared memory over all NUMA nodes, so all nodes access it equally fast");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -158,11 +201,31 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    bool load_rtree_leaves = false;
+    bool export_container = false;
+    bool use_container = false;
+    bool only_metric = false;
+    bool use_huge_pages = false;
+    bool interleave_numa_nodes = false;
+    if (!generateDataStoreOptions(argc,
+                                  argv,
+                                  base_path,
+                                  max_wait,
+                                  load_rtree_leaves,
+                                  export_container,
+                                  use_container,
+                                  only_metric,
+                                  use_huge_pages,
+                                  interleave_numa_nodes))
     {
         return EXIT_SUCCESS;
     }
     storage::StorageConfig config(base_path);
+    // a container is used without the .fileIndex file
+    config.load_rtree_leaves = load_rtree_leaves || export_container;
+    config.use_container = use_container;
+    config.use_huge_pages = use_huge_pages;
+    config.interleave_numa_nodes = interleave_numa_nodes;
     if (!config.IsValid())
     {
         util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
@@ -170,7 +233,11 @@ int main(const int argc, const char *argv[]) try
     }
     storage::Storage storage(std::move(config));
 
-    return storage.Run(max_wait);
+    if (export_container)
+    {
+        return storage.Export();
+    }
+    return storage.Run(max_wait, only_metric);
 }
 catch (const std::bad_alloc &e)
 {
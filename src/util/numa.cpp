@@ -0,0 +1,201 @@
+#include "util/numa.hpp"
+#include "util/log.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace numa
+{
+
+namespace
+{
+boost::filesystem::path GetNodePath(const boost::filesystem::path &nodes_path,
+                                    const unsigned node)
+{
+    return nodes_path / ("node" + std::to_string(node));
+}
+
+// Reads a list file of sysfs, empty if it can not be read
+std::vector<unsigned> ReadList(const boost::filesystem::path &path)
+{
+    boost::filesystem::ifstream stream(path);
+    std::string list;
+    if (!std::getline(stream, list))
+    {
+        util::Log(logDEBUG) << "could not read " << path.string();
+        return {};
+    }
+    try
+    {
+        return ParseList(list);
+    }
+    catch (const std::exception &)
+    {
+        util::Log(logDEBUG) << "invalid list " << list << " in " << path.string();
+        return {};
+    }
+}
+}
+
+std::vector<unsigned> ParseList(const std::string &list)
+{
+    std::vector<unsigned> values;
+    std::size_t position = 0;
+    while (position < list.size())
+    {
+        std::size_t end = 0;
+        const auto first = std::stoul(list.substr(position), &end);
+        position += end;
+        auto last = first;
+        if (position < list.size() && list[position] == '-')
+        {
+            last = std::stoul(list.substr(position + 1), &end);
+            position += end + 1;
+        }
+        for (auto value = first; value <= last; ++value)
+        {
+            values.push_back(value);
+        }
+        if (position < list.size() && list[position] != ',')
+        {
+            break;
+        }
+        ++position;
+    }
+    return values;
+}
+
+Topology ReadTopology(const std::string &nodes_path)
+{
+    Topology topology;
+    topology.nodes = ReadList(boost::filesystem::path(nodes_path) / "online");
+    for (const auto node : topology.nodes)
+    {
+        for (const auto cpu : ReadList(GetNodePath(nodes_path, node) / "cpulist"))
+        {
+            if (cpu >= topology.node_of_cpu.size())
+            {
+                topology.node_of_cpu.resize(cpu + 1, 0);
+            }
+            topology.node_of_cpu[cpu] = node;
+        }
+    }
+    return topology;
+}
+
+#ifdef __linux__
+namespace
+{
+const constexpr char *NODES_PATH = "/sys/devices/system/node";
+
+// The topology is read once, so looking up the node of the current CPU does not touch sysfs
+const Topology &GetTopology()
+{
+    static const Topology topology = ReadTopology(NODES_PATH);
+    return topology;
+}
+}
+
+unsigned GetNumberOfNodes()
+{
+    const auto &nodes = GetTopology().nodes;
+    return nodes.empty() ? 1 : *std::max_element(nodes.begin(), nodes.end()) + 1;
+}
+
+bool IsNodeOnline(const unsigned node)
+{
+    const auto &nodes = GetTopology().nodes;
+    return nodes.empty() ? node == 0 : std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+}
+
+unsigned GetCurrentNode()
+{
+    const auto cpu = sched_getcpu();
+    const auto &node_of_cpu = GetTopology().node_of_cpu;
+    if (cpu < 0 || static_cast<std::size_t>(cpu) >= node_of_cpu.size())
+    {
+        return 0;
+    }
+    return node_of_cpu[cpu];
+}
+
+bool RunOnNode(const unsigned node)
+{
+    const auto cpu_list = ReadList(GetNodePath(NODES_PATH, node) / "cpulist");
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const auto cpu : cpu_list)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+    if (CPU_COUNT(&cpus) == 0)
+    {
+        util::Log(logDEBUG) << "NUMA node " << node << " has no CPUs";
+        return false;
+    }
+
+    return 0 == pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+bool InterleaveMemory(void *memory, const std::size_t size)
+{
+    const auto &nodes = GetTopology().nodes;
+    if (nodes.size() < 2)
+    {
+        return false;
+    }
+
+    const constexpr auto bits_per_mask = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> node_mask(
+        (GetNumberOfNodes() + bits_per_mask - 1) / bits_per_mask, 0);
+    for (const auto node : nodes)
+    {
+        node_mask[node / bits_per_mask] |= 1UL << (node % bits_per_mask);
+    }
+
+    // the kernel reads one bit less than the maximal node given
+    const unsigned long max_node = node_mask.size() * bits_per_mask + 1;
+    if (-1 == syscall(SYS_mbind, memory, size, MPOL_INTERLEAVE, node_mask.data(), max_node, 0))
+    {
+        const auto error_code = errno;
+        util::Log(logDEBUG) << "mbind failed with error " << error_code;
+        return false;
+    }
+    return true;
+}
+#else
+unsigned GetNumberOfNodes() { return 1; }
+
+bool IsNodeOnline(const unsigned node) { return node == 0; }
+
+unsigned GetCurrentNode() { return 0; }
+
+bool RunOnNode(const unsigned) { return false; }
+
+bool InterleaveMemory(void *, const std::size_t) { return false; }
+#endif
+}
+}
+}
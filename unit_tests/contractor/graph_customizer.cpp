@@ -0,0 +1,241 @@
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/graph_customizer.hpp"
+#include "contractor/query_edge.hpp"
+#include "extractor/edge_based_edge.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(graph_customizer)
+
+using namespace osrm;
+using namespace osrm::contractor;
+using extractor::EdgeBasedEdge;
+
+namespace
+{
+const constexpr NodeID NUMBER_OF_NODES = 8;
+
+// A tree, so every pair of nodes has a single path and the hierarchy of the old weights stays
+// exact. Pairs of nodes are connected by a bidirectional edge based edge, by an edge based edge
+// per direction or by parallel edge based edges, so the contractor merges some of them.
+std::vector<EdgeBasedEdge> makeEdges(const EdgeWeight forward_factor,
+                                     const EdgeWeight backward_factor)
+{
+    std::vector<EdgeBasedEdge> edges;
+    const auto add_edge = [&](const NodeID source, const NodeID target, const EdgeWeight weight) {
+        const auto id = static_cast<NodeID>(edges.size());
+        const auto forward_weight = weight * forward_factor;
+        const auto backward_weight = weight * backward_factor;
+        if (forward_weight == backward_weight)
+        {
+            edges.emplace_back(
+                source, target, id, forward_weight, forward_weight, weight, true, true);
+        }
+        else
+        {
+            edges.emplace_back(
+                source, target, id, forward_weight, forward_weight, weight, true, false);
+            edges.emplace_back(
+                source, target, id + 1, backward_weight, backward_weight, weight, false, true);
+        }
+    };
+    const auto add_directed_edges = [&](const NodeID source,
+                                        const NodeID target,
+                                        const EdgeWeight weight) {
+        const auto id = static_cast<NodeID>(edges.size());
+        edges.emplace_back(
+            source, target, id, weight * forward_factor, weight, weight, true, false);
+        edges.emplace_back(
+            target, source, id + 1, weight * backward_factor, weight, weight, true, false);
+    };
+
+    add_edge(0, 1, 4);
+    add_directed_edges(1, 2, 3);
+    add_edge(2, 3, 5);
+    add_directed_edges(1, 4, 2);
+    // a parallel edge that is never the smallest
+    add_directed_edges(4, 1, 7);
+    add_edge(4, 5, 6);
+    add_directed_edges(5, 6, 1);
+    add_edge(6, 7, 2);
+    return edges;
+}
+
+std::vector<QueryEdge> contract(std::vector<EdgeBasedEdge> edge_based_edges)
+{
+    GraphContractor graph_contractor(NUMBER_OF_NODES,
+                                     adaptToContractorInput(std::move(edge_based_edges)),
+                                     {},
+                                     std::vector<EdgeWeight>(NUMBER_OF_NODES, 1));
+    graph_contractor.Run();
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    graph_contractor.GetEdges(contracted_edges);
+
+    std::vector<QueryEdge> edges(contracted_edges.begin(), contracted_edges.end());
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+// Weights of the upward search from a node, along edges traversable in the given direction
+template <typename EdgeList>
+std::vector<EdgeWeight> searchUpwards(const EdgeList &edges, const NodeID start, const bool forward)
+{
+    std::vector<EdgeWeight> weights(NUMBER_OF_NODES, INVALID_EDGE_WEIGHT);
+    using HeapEntry = std::pair<EdgeWeight, NodeID>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    weights[start] = 0;
+    heap.push({0, start});
+    while (!heap.empty())
+    {
+        const auto entry = heap.top();
+        heap.pop();
+        if (entry.first > weights[entry.second])
+            continue;
+
+        for (const auto &edge : edges)
+        {
+            if (edge.source != entry.second || !(forward ? edge.data.forward : edge.data.backward))
+                continue;
+
+            const auto weight = entry.first + edge.data.weight;
+            if (weight < weights[edge.target])
+            {
+                weights[edge.target] = weight;
+                heap.push({weight, edge.target});
+            }
+        }
+    }
+    return weights;
+}
+
+template <typename EdgeList> std::vector<EdgeWeight> getAllPairsWeights(const EdgeList &edges)
+{
+    std::vector<EdgeWeight> table;
+    for (NodeID source = 0; source < NUMBER_OF_NODES; ++source)
+    {
+        const auto forward_weights = searchUpwards(edges, source, true);
+        for (NodeID target = 0; target < NUMBER_OF_NODES; ++target)
+        {
+            const auto backward_weights = searchUpwards(edges, target, false);
+            EdgeWeight weight = INVALID_EDGE_WEIGHT;
+            for (NodeID middle = 0; middle < NUMBER_OF_NODES; ++middle)
+            {
+                if (forward_weights[middle] != INVALID_EDGE_WEIGHT &&
+                    backward_weights[middle] != INVALID_EDGE_WEIGHT)
+                {
+                    weight = std::min(weight, forward_weights[middle] + backward_weights[middle]);
+                }
+            }
+            table.push_back(weight);
+        }
+    }
+    return table;
+}
+}
+
+BOOST_AUTO_TEST_CASE(same_weights_keep_graph)
+{
+    const auto edge_based_edges = makeEdges(1, 1);
+    const auto contracted_edges = contract(edge_based_edges);
+    const auto customized_edges = customizeContractedGraph(contracted_edges, edge_based_edges);
+
+    const std::vector<QueryEdge> customized(customized_edges.begin(), customized_edges.end());
+    BOOST_CHECK_EQUAL(customized.size(), contracted_edges.size());
+    BOOST_CHECK(std::equal(customized.begin(), customized.end(), contracted_edges.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(asymmetric_update_matches_contraction)
+{
+    const auto contracted_edges = contract(makeEdges(1, 1));
+
+    // the directions of every pair of nodes get different weights
+    const auto updated_edges = makeEdges(2, 5);
+    const auto customized_edges = customizeContractedGraph(contracted_edges, updated_edges);
+    const auto fresh_edges = contract(updated_edges);
+
+    const auto customized_weights = getAllPairsWeights(customized_edges);
+    const auto fresh_weights = getAllPairsWeights(fresh_edges);
+    BOOST_CHECK_EQUAL_COLLECTIONS(customized_weights.begin(),
+                                  customized_weights.end(),
+                                  fresh_weights.begin(),
+                                  fresh_weights.end());
+
+    // the weights of the old contraction are different, so the update is not a no-op
+    const auto old_weights = getAllPairsWeights(contracted_edges);
+    BOOST_CHECK(old_weights != fresh_weights);
+}
+
+BOOST_AUTO_TEST_CASE(shortcuts_take_shortest_lower_triangle)
+{
+    // Two paths between 2 and 3, over 0 and over 1. Both were contracted before 2 and 3, and the
+    // hierarchy only kept the shortcut over 0:
+    //
+    //      0
+    //     / \
+    //    2 = 3
+    //     \ /
+    //      1
+    const auto make_edge = [](const NodeID source,
+                              const NodeID target,
+                              const EdgeWeight weight,
+                              const NodeID id,
+                              const bool shortcut) {
+        QueryEdge::EdgeData data;
+        data.id = id;
+        data.shortcut = shortcut;
+        data.weight = weight;
+        data.duration = weight;
+        data.distance = weight;
+        data.forward = true;
+        data.backward = true;
+        return QueryEdge{source, target, data};
+    };
+    const std::vector<QueryEdge> contracted_edges = {make_edge(0, 2, 2, 0, false),
+                                                     make_edge(0, 3, 2, 1, false),
+                                                     make_edge(1, 2, 2, 2, false),
+                                                     make_edge(1, 3, 2, 3, false),
+                                                     make_edge(2, 3, 4, 0, true)};
+
+    // now 2 -> 3 is shorter over 1 and 3 -> 2 over 0
+    const std::vector<EdgeBasedEdge> updated_edges = {
+        EdgeBasedEdge(0, 2, 0, 1, 1, 1, true, true),
+        EdgeBasedEdge(0, 3, 1, 9, 9, 9, true, false),
+        EdgeBasedEdge(3, 0, 2, 1, 1, 1, true, false),
+        EdgeBasedEdge(1, 2, 3, 1, 1, 1, true, true),
+        EdgeBasedEdge(1, 3, 4, 1, 1, 1, true, false),
+        EdgeBasedEdge(3, 1, 5, 9, 9, 9, true, false)};
+    const auto customized_edges = customizeContractedGraph(contracted_edges, updated_edges);
+
+    // the shortcut is split into one direction per middle node
+    std::vector<QueryEdge> shortcuts;
+    std::copy_if(customized_edges.begin(),
+                 customized_edges.end(),
+                 std::back_inserter(shortcuts),
+                 [](const QueryEdge &edge) { return edge.data.shortcut; });
+    BOOST_REQUIRE_EQUAL(shortcuts.size(), 2);
+    const auto &forward = shortcuts[0].data.forward ? shortcuts[0] : shortcuts[1];
+    const auto &backward = shortcuts[0].data.forward ? shortcuts[1] : shortcuts[0];
+    BOOST_CHECK(forward.data.forward && !forward.data.backward);
+    BOOST_CHECK_EQUAL(forward.data.id, 1);
+    BOOST_CHECK_EQUAL(forward.data.weight, 2);
+    BOOST_CHECK(!backward.data.forward && backward.data.backward);
+    BOOST_CHECK_EQUAL(backward.data.id, 0);
+    BOOST_CHECK_EQUAL(backward.data.weight, 2);
+
+    const auto weights = getAllPairsWeights(customized_edges);
+    BOOST_CHECK_EQUAL(weights[2 * NUMBER_OF_NODES + 3], 2);
+    BOOST_CHECK_EQUAL(weights[3 * NUMBER_OF_NODES + 2], 2);
+    BOOST_CHECK_EQUAL(weights[0 * NUMBER_OF_NODES + 3], 3);
+    BOOST_CHECK_EQUAL(weights[3 * NUMBER_OF_NODES + 1], 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+#include "contractor/shortcut_children.hpp"
+#include "engine/edge_unpacker.hpp"
+
+#include "mocks/mock_graph_datafacade.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(edge_unpacker)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+// the nodes and the weight of the original edges
+using UnpackedEdges = std::vector<std::tuple<NodeID, NodeID, EdgeWeight>>;
+
+// Unpacks shortcuts using the children that osrm-contract would store for them
+class ShortcutChildrenDataFacade final : public MockGraphDataFacade
+{
+  public:
+    ShortcutChildrenDataFacade(const NodeID number_of_nodes, std::vector<InputEdge> edges_)
+        : MockGraphDataFacade(number_of_nodes, edges_), edges(std::move(edges_)),
+          first_edge(number_of_nodes + 1, 0)
+    {
+        // the same order as the edges of the query graph
+        std::stable_sort(edges.begin(), edges.end());
+        for (const auto &edge : edges)
+        {
+            ++first_edge[edge.source + 1];
+        }
+        std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+    }
+
+    bool HasShortcutChildren() const override { return true; }
+
+    contractor::ShortcutChildren GetShortcutChildren(const EdgeID shortcut,
+                                                     const bool reversed) const override
+    {
+        const auto &edge = edges[shortcut];
+        BOOST_ASSERT(edge.data.shortcut);
+        const auto from = reversed ? edge.target : edge.source;
+        const auto to = reversed ? edge.source : edge.target;
+        return {FindTraversedEdge(from, edge.data.id), FindTraversedEdge(edge.data.id, to)};
+    }
+
+  private:
+    contractor::CHEdgeReference FindTraversedEdge(const NodeID from, const NodeID to) const
+    {
+        return contractor::findTraversedEdge(
+            edges, first_edge, from, to, [this](const EdgeID edge, const bool) {
+                return edges[edge].data.weight;
+            });
+    }
+
+    std::vector<InputEdge> edges;
+    std::vector<EdgeID> first_edge;
+};
+
+MockGraphDataFacade::InputEdge makeShortcut(const NodeID source,
+                                            const NodeID target,
+                                            const EdgeWeight weight,
+                                            const NodeID middle,
+                                            const bool forward,
+                                            const bool backward)
+{
+    auto edge = makeQueryEdge(source, target, weight, 0, forward, backward);
+    edge.data.id = middle;
+    edge.data.shortcut = true;
+    return edge;
+}
+
+/*
+   The hierarchy of the path 0 - 1 - 2 - 3 - 4, in which 1 and 3 were contracted first, then 2
+   and then 0. Edges are stored at their lower node:
+
+         0 ======= 4         shortcut via 2
+          \\     //
+            \\ //
+              2              shortcuts via 1 and 3
+             / \
+            1   3
+
+   The road from 2 to 3 is a oneway, so the shortcuts over it are as well. A slower parallel
+   edge from 1 to 2 must not be unpacked.
+*/
+std::vector<MockGraphDataFacade::InputEdge> makeEdges()
+{
+    return {makeQueryEdge(1, 0, 1, 0, true, true),
+            makeQueryEdge(1, 2, 2, 0, true, true),
+            makeQueryEdge(1, 2, 5, 0, true, false),
+            makeQueryEdge(3, 2, 1, 0, false, true),
+            makeQueryEdge(3, 4, 3, 0, true, true),
+            makeShortcut(2, 0, 3, 1, true, true),
+            makeShortcut(2, 4, 4, 3, true, false),
+            makeShortcut(0, 4, 7, 2, true, false)};
+}
+
+template <typename DataFacadeT>
+UnpackedEdges unpackPath(const DataFacadeT &facade, const std::vector<NodeID> &packed_path)
+{
+    UnpackedEdges unpacked_edges;
+    UnpackCHPath(facade,
+                 packed_path.begin(),
+                 packed_path.end(),
+                 [&](const std::pair<NodeID, NodeID> &edge,
+                     const MockGraphDataFacade::EdgeData &data) {
+                     BOOST_CHECK(!data.shortcut);
+                     unpacked_edges.emplace_back(edge.first, edge.second, data.weight);
+                 });
+    return unpacked_edges;
+}
+
+std::vector<NodeID> getNodes(const UnpackedEdges &unpacked_edges)
+{
+    std::vector<NodeID> nodes = {std::get<0>(unpacked_edges.front())};
+    for (const auto &edge : unpacked_edges)
+    {
+        BOOST_CHECK_EQUAL(std::get<0>(edge), nodes.back());
+        nodes.push_back(std::get<1>(edge));
+    }
+    return nodes;
+}
+}
+
+BOOST_AUTO_TEST_CASE(shortcut_children_match_edge_search)
+{
+    const MockGraphDataFacade facade(5, makeEdges());
+    const ShortcutChildrenDataFacade children_facade(5, makeEdges());
+    BOOST_REQUIRE(!facade.HasShortcutChildren());
+
+    const std::vector<std::vector<NodeID>> packed_paths = {
+        {0, 4}, {0, 2, 4}, {2, 0}, {0, 2}, {2, 4}, {1, 2, 4}, {2, 1, 0}};
+    const std::vector<std::vector<NodeID>> expected_nodes = {{0, 1, 2, 3, 4},
+                                                             {0, 1, 2, 3, 4},
+                                                             {2, 1, 0},
+                                                             {0, 1, 2},
+                                                             {2, 3, 4},
+                                                             {1, 2, 3, 4},
+                                                             {2, 1, 0}};
+    for (std::size_t index = 0; index < packed_paths.size(); ++index)
+    {
+        const auto searched = unpackPath(facade, packed_paths[index]);
+        const auto stored = unpackPath(children_facade, packed_paths[index]);
+        BOOST_CHECK(searched == stored);
+        BOOST_CHECK(getNodes(stored) == expected_nodes[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shortcut_children_skip_slower_parallel_edge)
+{
+    const ShortcutChildrenDataFacade facade(5, makeEdges());
+
+    // the shortcut 0 -> 2 via 1 continues on the faster of both edges from 1 to 2
+    const auto children = facade.GetShortcutChildren(facade.FindEdge(2, 0), true);
+    BOOST_CHECK(children.first.reversed);
+    BOOST_CHECK_EQUAL(facade.GetTarget(children.first.edge), 0);
+    BOOST_CHECK(!children.second.reversed);
+    BOOST_CHECK_EQUAL(facade.GetEdgeData(children.second.edge).weight, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+#include "engine/isochrone_grid.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <osrm/coordinate.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(isochrone_grid)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+util::Coordinate makeCoordinate(const double lon, const double lat)
+{
+    return util::Coordinate{util::FloatLongitude{lon}, util::FloatLatitude{lat}};
+}
+
+double signedArea(const std::vector<util::Coordinate> &ring)
+{
+    double area = 0;
+    for (std::size_t index = 0; index + 1 < ring.size(); ++index)
+    {
+        const auto x1 = static_cast<double>(util::toFloating(ring[index].lon));
+        const auto y1 = static_cast<double>(util::toFloating(ring[index].lat));
+        const auto x2 = static_cast<double>(util::toFloating(ring[index + 1].lon));
+        const auto y2 = static_cast<double>(util::toFloating(ring[index + 1].lat));
+        area += x1 * y2 - x2 * y1;
+    }
+    return area / 2.;
+}
+
+bool contains(const std::vector<util::Coordinate> &ring, const util::Coordinate coordinate)
+{
+    const auto lon = static_cast<double>(util::toFloating(coordinate.lon));
+    const auto lat = static_cast<double>(util::toFloating(coordinate.lat));
+    const auto min_max_lon = std::minmax_element(
+        ring.begin(), ring.end(), [](const auto lhs, const auto rhs) { return lhs.lon < rhs.lon; });
+    const auto min_max_lat = std::minmax_element(
+        ring.begin(), ring.end(), [](const auto lhs, const auto rhs) { return lhs.lat < rhs.lat; });
+    return static_cast<double>(util::toFloating(min_max_lon.first->lon)) <= lon &&
+           lon <= static_cast<double>(util::toFloating(min_max_lon.second->lon)) &&
+           static_cast<double>(util::toFloating(min_max_lat.first->lat)) <= lat &&
+           lat <= static_cast<double>(util::toFloating(min_max_lat.second->lat));
+}
+}
+
+BOOST_AUTO_TEST_CASE(single_segment)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(0.1, 0.1), 100);
+    grid.AddSegment(makeCoordinate(0.01, 0.05), makeCoordinate(0.09, 0.05), 0, 100);
+
+    const auto polygons = grid.Contour(100);
+    BOOST_REQUIRE_EQUAL(polygons.size(), 1);
+    BOOST_CHECK(polygons.front().holes.empty());
+
+    const auto &outer = polygons.front().outer;
+    BOOST_REQUIRE_GE(outer.size(), 5);
+    BOOST_CHECK_EQUAL(outer.front(), outer.back());
+    // rectangle around the segment, counter-clockwise
+    BOOST_CHECK_EQUAL(outer.size(), 5);
+    BOOST_CHECK_GT(signedArea(outer), 0);
+    BOOST_CHECK(contains(outer, makeCoordinate(0.01, 0.05)));
+    BOOST_CHECK(contains(outer, makeCoordinate(0.09, 0.05)));
+}
+
+BOOST_AUTO_TEST_CASE(threshold_cuts_segment)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(0.1, 0.1), 100);
+    grid.AddSegment(makeCoordinate(0.01, 0.05), makeCoordinate(0.09, 0.05), 0, 100);
+
+    const auto polygons = grid.Contour(50);
+    BOOST_REQUIRE_EQUAL(polygons.size(), 1);
+    BOOST_CHECK(contains(polygons.front().outer, makeCoordinate(0.02, 0.05)));
+    BOOST_CHECK(!contains(polygons.front().outer, makeCoordinate(0.08, 0.05)));
+
+    BOOST_CHECK(grid.Contour(-1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(negative_times_are_unreachable)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(0.1, 0.1), 100);
+    grid.AddSegment(makeCoordinate(0.01, 0.05), makeCoordinate(0.09, 0.05), -100, 100);
+
+    const auto polygons = grid.Contour(100);
+    BOOST_REQUIRE_EQUAL(polygons.size(), 1);
+    BOOST_CHECK(!contains(polygons.front().outer, makeCoordinate(0.02, 0.05)));
+    BOOST_CHECK(contains(polygons.front().outer, makeCoordinate(0.08, 0.05)));
+}
+
+BOOST_AUTO_TEST_CASE(separate_components)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(0.1, 0.1), 100);
+    grid.AddSegment(makeCoordinate(0.01, 0.01), makeCoordinate(0.02, 0.02), 0, 10);
+    grid.AddSegment(makeCoordinate(0.08, 0.08), makeCoordinate(0.09, 0.09), 0, 10);
+    grid.AddSegment(makeCoordinate(0.01, 0.09), makeCoordinate(0.02, 0.09), 20, 30);
+
+    BOOST_CHECK_EQUAL(grid.Contour(10).size(), 2);
+    BOOST_CHECK_EQUAL(grid.Contour(30).size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(ring_road_has_hole)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(0.1, 0.1), 100);
+    grid.AddSegment(makeCoordinate(0.02, 0.02), makeCoordinate(0.08, 0.02), 0, 10);
+    grid.AddSegment(makeCoordinate(0.08, 0.02), makeCoordinate(0.08, 0.08), 10, 20);
+    grid.AddSegment(makeCoordinate(0.08, 0.08), makeCoordinate(0.02, 0.08), 20, 30);
+    grid.AddSegment(makeCoordinate(0.02, 0.08), makeCoordinate(0.02, 0.02), 30, 40);
+    // an island inside the ring
+    grid.AddSegment(makeCoordinate(0.045, 0.05), makeCoordinate(0.055, 0.05), 5, 5);
+
+    const auto polygons = grid.Contour(40);
+    BOOST_REQUIRE_EQUAL(polygons.size(), 2);
+
+    const auto &ring_polygon =
+        signedArea(polygons[0].outer) > signedArea(polygons[1].outer) ? polygons[0] : polygons[1];
+    const auto &island_polygon =
+        signedArea(polygons[0].outer) > signedArea(polygons[1].outer) ? polygons[1] : polygons[0];
+
+    BOOST_REQUIRE_EQUAL(ring_polygon.holes.size(), 1);
+    BOOST_CHECK(island_polygon.holes.empty());
+
+    const auto &hole = ring_polygon.holes.front();
+    BOOST_CHECK_EQUAL(hole.front(), hole.back());
+    BOOST_CHECK_LT(signedArea(hole), 0);
+    BOOST_CHECK(contains(hole, makeCoordinate(0.05, 0.05)));
+    BOOST_CHECK(contains(ring_polygon.outer, makeCoordinate(0.05, 0.05)));
+}
+
+BOOST_AUTO_TEST_CASE(large_area_is_coarsened)
+{
+    IsochroneGrid grid(makeCoordinate(0, 0), makeCoordinate(10, 10), 1);
+    BOOST_CHECK_LE(grid.GetWidth() * grid.GetHeight(), IsochroneGrid::MAX_CELLS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,157 @@
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include "mocks/mock_graph_datafacade.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(many_to_many)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+/*
+   The edge based nodes of a road that forks, all of them oneways:
+
+                   3
+                  /       node 0: 0 - 1   node 2: 2 - 3
+     0 --- 1 --- 2        node 1: 1 - 2   node 3: 2 - 4
+                  \
+                   4
+*/
+std::shared_ptr<const MockGraphDataFacade> makeFacade()
+{
+    const std::vector<util::Coordinate> coordinates = {
+        {util::FloatLongitude{0.}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.001}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.002}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.003}, util::FloatLatitude{0.001}},
+        {util::FloatLongitude{0.0035}, util::FloatLatitude{-0.001}}};
+    const std::vector<std::vector<NodeID>> geometries = {{0, 1}, {1, 2}, {2, 3}, {2, 4}};
+
+    // every edge carries the length of the edge based node it leaves
+    const auto length = [&](const NodeID node) {
+        return util::coordinate_calculation::haversineDistance(coordinates[geometries[node][0]],
+                                                               coordinates[geometries[node][1]]);
+    };
+    const auto edge = [&](const NodeID from, const NodeID to) {
+        return std::make_tuple(from,
+                               to,
+                               static_cast<EdgeWeight>(std::lround(length(from))),
+                               static_cast<EdgeDistance>(length(from)));
+    };
+    auto edges = makeUncontractedEdges({edge(0, 1), edge(1, 2), edge(1, 3)});
+    return std::make_shared<MockGraphDataFacade>(4, std::move(edges), coordinates, geometries);
+}
+
+double getLength(const MockGraphDataFacade &facade, const NodeID node)
+{
+    const auto geometry = facade.GetUncompressedForwardGeometry(node);
+    return util::coordinate_calculation::haversineDistance(
+        facade.GetCoordinateOfNode(geometry[0]), facade.GetCoordinateOfNode(geometry[1]));
+}
+}
+
+BOOST_AUTO_TEST_CASE(network_distances_match_pairwise_search)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::ManyToManyRouting many_to_many(heaps);
+
+    const std::vector<PhantomNode> sources = {
+        makePhantomNode(*facade, 0, SPECIAL_NODEID, 0, 0.5),
+        makePhantomNode(*facade, 1, SPECIAL_NODEID, 0, 0.5)};
+    const std::vector<PhantomNode> targets = {
+        makePhantomNode(*facade, 2, SPECIAL_NODEID, 0, 0.5),
+        makePhantomNode(*facade, 3, SPECIAL_NODEID, 0, 0.25),
+        makePhantomNode(*facade, 0, SPECIAL_NODEID, 0, 0.75)};
+
+    std::vector<std::tuple<std::size_t, std::size_t, double>> distances;
+    many_to_many.ForEachNetworkDistance(
+        facade,
+        sources,
+        targets,
+        [&](const std::size_t source, const std::size_t target, const auto &get_distance) {
+            distances.emplace_back(source, target, get_distance());
+        });
+
+    // one source after the other, each with all targets
+    BOOST_REQUIRE_EQUAL(distances.size(), sources.size() * targets.size());
+    const routing_algorithms::BasicRoutingInterface routing;
+    for (std::size_t index = 0; index < distances.size(); ++index)
+    {
+        const auto source = std::get<0>(distances[index]);
+        const auto target = std::get<1>(distances[index]);
+        BOOST_CHECK_EQUAL(source, index / targets.size());
+        BOOST_CHECK_EQUAL(target, index % targets.size());
+
+        heaps.InitializeOrClearFirstThreadLocalStorage(facade->GetNumberOfNodes());
+        const auto expected = routing.GetNetworkDistance(facade,
+                                                         *heaps.forward_heap_1,
+                                                         *heaps.reverse_heap_1,
+                                                         sources[source],
+                                                         targets[target]);
+        if (expected == std::numeric_limits<double>::max())
+        {
+            BOOST_CHECK_EQUAL(std::get<2>(distances[index]), expected);
+        }
+        else
+        {
+            BOOST_CHECK_CLOSE(std::get<2>(distances[index]), expected, 1e-6);
+        }
+    }
+
+    // from the middle of node 0 over node 1 to the middle of node 2
+    BOOST_CHECK_CLOSE(std::get<2>(distances[0]),
+                      getLength(*facade, 0) / 2 + getLength(*facade, 1) +
+                          getLength(*facade, 2) / 2,
+                      1e-3);
+    // further along the same node
+    BOOST_CHECK_CLOSE(std::get<2>(distances[2]), getLength(*facade, 0) / 4, 1e-3);
+    // nothing leads back to node 0
+    BOOST_CHECK_EQUAL(std::get<2>(distances[5]), std::numeric_limits<double>::max());
+}
+
+BOOST_AUTO_TEST_CASE(distances_are_computed_on_demand)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::ManyToManyRouting many_to_many(heaps);
+
+    const std::vector<PhantomNode> sources = {
+        makePhantomNode(*facade, 0, SPECIAL_NODEID, 0, 0.5)};
+    const std::vector<PhantomNode> targets = {
+        makePhantomNode(*facade, 2, SPECIAL_NODEID, 0, 0.5),
+        makePhantomNode(*facade, 3, SPECIAL_NODEID, 0, 0.5)};
+
+    // skipping the first target does not change the distance to the second one
+    double distance = 0;
+    many_to_many.ForEachNetworkDistance(
+        facade,
+        sources,
+        targets,
+        [&](const std::size_t, const std::size_t target, const auto &get_distance) {
+            if (target == 1)
+            {
+                distance = get_distance();
+            }
+        });
+    BOOST_CHECK_CLOSE(distance,
+                      getLength(*facade, 0) / 2 + getLength(*facade, 1) +
+                          getLength(*facade, 3) / 2,
+                      1e-3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
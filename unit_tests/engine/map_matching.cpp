@@ -0,0 +1,216 @@
+#include "engine/map_matching/matching_session.hpp"
+#include "engine/routing_algorithms/map_matching.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include "mocks/mock_graph_datafacade.hpp"
+
+#include <boost/optional.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(map_matching_sessions)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+const constexpr double GPS_PRECISION = 5;
+
+/*
+   The edge based nodes along the equator, with two parallel ones in the middle:
+
+                 2
+                / \
+     0 - 1 --- +   + --- 5 - 6
+                \ /
+                 4
+
+    node 0     node 1 via 2 or  node 2 via 4    node 3     node 4
+    0 - 1      1 - 2 - 3        1 - 4 - 3       3 - 5      5 - 6
+
+   The node via 4 is a bit longer.
+*/
+std::shared_ptr<const MockGraphDataFacade> makeFacade()
+{
+    const std::vector<util::Coordinate> coordinates = {
+        {util::FloatLongitude{0.}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.001}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.0015}, util::FloatLatitude{0.0001}},
+        {util::FloatLongitude{0.002}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.0015}, util::FloatLatitude{-0.00015}},
+        {util::FloatLongitude{0.003}, util::FloatLatitude{0.}},
+        {util::FloatLongitude{0.004}, util::FloatLatitude{0.}}};
+    const std::vector<std::vector<NodeID>> geometries = {
+        {0, 1}, {1, 2, 3}, {1, 4, 3}, {3, 5}, {5, 6}};
+
+    // every edge carries the length of the edge based node it leaves
+    const auto length = [&](const NodeID node) {
+        double length = 0;
+        for (std::size_t index = 0; index + 1 < geometries[node].size(); ++index)
+        {
+            length += util::coordinate_calculation::haversineDistance(
+                coordinates[geometries[node][index]], coordinates[geometries[node][index + 1]]);
+        }
+        return length;
+    };
+    const auto edge = [&](const NodeID from, const NodeID to) {
+        return std::make_tuple(from,
+                               to,
+                               static_cast<EdgeWeight>(std::lround(length(from))),
+                               static_cast<EdgeDistance>(length(from)));
+    };
+    auto edges =
+        makeUncontractedEdges({edge(0, 1), edge(0, 2), edge(1, 3), edge(2, 3), edge(3, 4)});
+    return std::make_shared<MockGraphDataFacade>(5, std::move(edges), coordinates, geometries);
+}
+
+struct Trace
+{
+    routing_algorithms::CandidateLists candidates;
+    std::vector<util::Coordinate> coordinates;
+
+    // A trace point with a candidate a fraction along each of the given segments
+    void Add(const MockGraphDataFacade &facade,
+             const util::Coordinate coordinate,
+             const std::vector<std::tuple<NodeID, std::size_t, double>> &segments)
+    {
+        coordinates.push_back(coordinate);
+        candidates.emplace_back();
+        for (const auto &segment : segments)
+        {
+            const auto phantom = makePhantomNode(facade,
+                                                 std::get<0>(segment),
+                                                 SPECIAL_NODEID,
+                                                 std::get<1>(segment),
+                                                 std::get<2>(segment));
+            candidates.back().push_back(
+                {phantom,
+                 util::coordinate_calculation::haversineDistance(coordinate, phantom.location)});
+        }
+    }
+};
+
+util::Coordinate makeCoordinate(const double lon, const double lat)
+{
+    return {util::FloatLongitude{lon}, util::FloatLatitude{lat}};
+}
+
+std::vector<unsigned> getNodes(const engine::map_matching::SubMatching &matching)
+{
+    std::vector<unsigned> nodes;
+    for (const auto &phantom : matching.nodes)
+    {
+        nodes.push_back(phantom.forward_segment_id.id);
+    }
+    return nodes;
+}
+}
+
+BOOST_AUTO_TEST_CASE(confirm_unambiguous_points)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::MapMatching matching(heaps, GPS_PRECISION);
+    engine::map_matching::MatchingSession session;
+
+    // a single candidate per trace point confirms them right away
+    Trace first;
+    first.Add(*facade, makeCoordinate(0.0005, 0.00001), {std::make_tuple(0, 0, 0.5)});
+    first.Add(*facade, makeCoordinate(0.0025, 0.00001), {std::make_tuple(3, 0, 0.5)});
+    auto sub_matchings =
+        matching.Extend(facade, session, first.candidates, first.coordinates, {}, {}, false);
+    BOOST_REQUIRE_EQUAL(sub_matchings.size(), 1);
+    BOOST_CHECK(sub_matchings[0].indices == std::vector<unsigned>({0, 1}));
+    BOOST_CHECK(session.anchored);
+    BOOST_CHECK_EQUAL(session.window.size(), 1);
+
+    // the next matching starts at the last confirmed trace point
+    Trace second;
+    second.Add(*facade, makeCoordinate(0.0035, 0.00001), {std::make_tuple(4, 0, 0.5)});
+    sub_matchings =
+        matching.Extend(facade, session, second.candidates, second.coordinates, {}, {}, false);
+    BOOST_REQUIRE_EQUAL(sub_matchings.size(), 1);
+    const auto nodes = getNodes(sub_matchings[0]);
+    BOOST_CHECK(nodes == std::vector<unsigned>({3, 4}));
+    BOOST_CHECK_EQUAL(sub_matchings[0].indices.front(), 1);
+    BOOST_CHECK_EQUAL(sub_matchings[0].indices.back(), 2);
+    BOOST_CHECK_EQUAL(session.number_of_points, 3);
+}
+
+BOOST_AUTO_TEST_CASE(confirm_once_paths_converge)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::MapMatching matching(heaps, GPS_PRECISION);
+    engine::map_matching::MatchingSession session;
+
+    // the second trace point lies between both parallel nodes, so its matching stays open
+    Trace first;
+    first.Add(*facade, makeCoordinate(0.0005, 0.00001), {std::make_tuple(0, 0, 0.5)});
+    first.Add(*facade,
+              makeCoordinate(0.0015, 0.),
+              {std::make_tuple(1, 0, 1.), std::make_tuple(2, 0, 1.)});
+    auto sub_matchings =
+        matching.Extend(facade, session, first.candidates, first.coordinates, {}, {}, false);
+    BOOST_CHECK(sub_matchings.empty());
+    BOOST_CHECK_EQUAL(session.window.size(), 2);
+
+    // both paths continue on the same node, which confirms the closer parallel node
+    Trace second;
+    second.Add(*facade, makeCoordinate(0.0025, 0.00001), {std::make_tuple(3, 0, 0.5)});
+    sub_matchings =
+        matching.Extend(facade, session, second.candidates, second.coordinates, {}, {}, false);
+    BOOST_REQUIRE_EQUAL(sub_matchings.size(), 1);
+    const auto nodes = getNodes(sub_matchings[0]);
+    BOOST_CHECK(nodes == std::vector<unsigned>({0, 1, 3}));
+    BOOST_CHECK_EQUAL(session.window.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(finish_confirms_best_path)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::MapMatching matching(heaps, GPS_PRECISION);
+    engine::map_matching::MatchingSession session;
+
+    Trace trace;
+    trace.Add(*facade, makeCoordinate(0.0005, 0.00001), {std::make_tuple(0, 0, 0.5)});
+    trace.Add(*facade,
+              makeCoordinate(0.0015, 0.),
+              {std::make_tuple(2, 0, 1.), std::make_tuple(1, 0, 1.)});
+    const auto sub_matchings =
+        matching.Extend(facade, session, trace.candidates, trace.coordinates, {}, {}, true);
+    BOOST_REQUIRE_EQUAL(sub_matchings.size(), 1);
+    const auto nodes = getNodes(sub_matchings[0]);
+    BOOST_CHECK(nodes == std::vector<unsigned>({0, 1}));
+    BOOST_CHECK(session.window.empty());
+    BOOST_CHECK(!session.anchored);
+}
+
+BOOST_AUTO_TEST_CASE(unreachable_point_is_skipped)
+{
+    const auto facade = makeFacade();
+    SearchEngineData heaps;
+    const routing_algorithms::MapMatching matching(heaps, GPS_PRECISION);
+    engine::map_matching::MatchingSession session;
+
+    // the edges only lead away from node 0, so the third trace point is an outlier
+    Trace trace;
+    trace.Add(*facade, makeCoordinate(0.0025, 0.00001), {std::make_tuple(3, 0, 0.5)});
+    trace.Add(*facade, makeCoordinate(0.0035, 0.00001), {std::make_tuple(4, 0, 0.5)});
+    trace.Add(*facade, makeCoordinate(0.0005, 0.00001), {std::make_tuple(0, 0, 0.5)});
+    const auto sub_matchings =
+        matching.Extend(facade, session, trace.candidates, trace.coordinates, {}, {}, true);
+    BOOST_REQUIRE_EQUAL(sub_matchings.size(), 1);
+    BOOST_CHECK(sub_matchings[0].indices == std::vector<unsigned>({0, 1}));
+    BOOST_CHECK_EQUAL(session.number_of_points, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+#include "engine/map_matching/matching_sessions.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(matching_sessions)
+
+using namespace osrm;
+using namespace osrm::engine::map_matching;
+
+BOOST_AUTO_TEST_CASE(reuse_session)
+{
+    MatchingSessions sessions(std::chrono::seconds(10), -1);
+    const auto start = MatchingSessions::Clock::now();
+
+    const auto session = sessions.Get("a", start);
+    BOOST_REQUIRE(session);
+    session->state.number_of_points = 3;
+
+    BOOST_CHECK_EQUAL(sessions.Get("a", start + std::chrono::seconds(5)), session);
+    BOOST_CHECK_NE(sessions.Get("b", start + std::chrono::seconds(5)), session);
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+
+    sessions.Remove("a");
+    const auto new_session = sessions.Get("a", start + std::chrono::seconds(5));
+    BOOST_REQUIRE(new_session);
+    BOOST_CHECK_EQUAL(new_session->state.number_of_points, 0);
+}
+
+BOOST_AUTO_TEST_CASE(expire_sessions)
+{
+    MatchingSessions sessions(std::chrono::seconds(10), -1);
+    const auto start = MatchingSessions::Clock::now();
+
+    const auto session = sessions.Get("a", start);
+    sessions.Get("b", start);
+
+    // accessing a session keeps it open
+    BOOST_CHECK_EQUAL(sessions.Get("a", start + std::chrono::seconds(8)), session);
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+
+    // only the session that was not accessed is dropped
+    BOOST_CHECK_EQUAL(sessions.Get("a", start + std::chrono::seconds(16)), session);
+    BOOST_CHECK_EQUAL(sessions.Size(), 1);
+
+    BOOST_CHECK_NE(sessions.Get("a", start + std::chrono::seconds(30)), session);
+    BOOST_CHECK_EQUAL(sessions.Size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(limit_sessions)
+{
+    MatchingSessions sessions(std::chrono::seconds(10), 2);
+    const auto start = MatchingSessions::Clock::now();
+
+    BOOST_CHECK(sessions.Get("a", start));
+    BOOST_CHECK(sessions.Get("b", start + std::chrono::seconds(5)));
+    BOOST_CHECK(!sessions.Get("c", start + std::chrono::seconds(5)));
+
+    // open sessions can still be extended at the limit
+    BOOST_CHECK(sessions.Get("a", start + std::chrono::seconds(6)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+
+    // closed and expired sessions make room for new ones
+    sessions.Remove("a");
+    BOOST_CHECK(sessions.Get("c", start + std::chrono::seconds(6)));
+    BOOST_CHECK(!sessions.Get("d", start + std::chrono::seconds(6)));
+    BOOST_CHECK(sessions.Get("d", start + std::chrono::seconds(16)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include "engine/api/nearest_parameters.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/plugins/nearest.hpp"
+#include "util/json_container.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(nearest)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+// Finds segments right at every coordinate east of the prime meridian and none west of it
+class NearestDataFacade final : public MockDataFacade
+{
+  public:
+    std::vector<PhantomNodeWithDistance>
+    NearestPhantomNodes(const util::Coordinate input_coordinate,
+                        const unsigned max_results) const override
+    {
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (input_coordinate.lon < util::FixedLongitude{0})
+        {
+            return phantom_nodes;
+        }
+        for (unsigned result = 0; result < max_results; ++result)
+        {
+            PhantomNode phantom_node;
+            phantom_node.location = input_coordinate;
+            phantom_nodes.push_back({phantom_node, static_cast<double>(result)});
+        }
+        return phantom_nodes;
+    }
+};
+
+util::Coordinate getLocation(const util::json::Value &waypoint)
+{
+    const auto &location =
+        waypoint.get<util::json::Object>().values.at("location").get<util::json::Array>().values;
+    return {util::FloatLongitude{location[0].get<util::json::Number>().value},
+            util::FloatLatitude{location[1].get<util::json::Number>().value}};
+}
+}
+
+BOOST_AUTO_TEST_CASE(single_coordinate_lists_waypoints)
+{
+    const auto facade = std::make_shared<const NearestDataFacade>();
+    const plugins::NearestPlugin plugin(-1, -1);
+
+    api::NearestParameters params;
+    params.coordinates.push_back({util::FloatLongitude{1.}, util::FloatLatitude{2.}});
+    params.number_of_results = 3;
+
+    util::json::Object result;
+    BOOST_CHECK(plugin.HandleRequest(facade, params, result) == Status::Ok);
+    BOOST_CHECK(result.values.count("snapped") == 0);
+    const auto &waypoints = result.values.at("waypoints").get<util::json::Array>().values;
+    BOOST_CHECK_EQUAL(waypoints.size(), 3);
+
+    params.coordinates.front() = {util::FloatLongitude{-1.}, util::FloatLatitude{2.}};
+    util::json::Object error;
+    BOOST_CHECK(plugin.HandleRequest(facade, params, error) == Status::Error);
+    BOOST_CHECK_EQUAL(error.values.at("code").get<util::json::String>().value, "NoSegment");
+}
+
+BOOST_AUTO_TEST_CASE(bulk_keeps_coordinate_order)
+{
+    const auto facade = std::make_shared<const NearestDataFacade>();
+    const plugins::NearestPlugin plugin(-1, -1);
+
+    // scattered coordinates, enough for several batches along the Hilbert curve
+    api::NearestParameters params;
+    for (int index = 0; index < 1000; ++index)
+    {
+        params.coordinates.push_back(
+            {util::FloatLongitude{(index * 7919 % 1000) * 0.01},
+             util::FloatLatitude{(index * 104729 % 997) * 0.01 - 5.}});
+    }
+    params.number_of_results = 2;
+
+    util::json::Object result;
+    BOOST_CHECK(plugin.HandleRequest(facade, params, result) == Status::Ok);
+    BOOST_CHECK(result.values.count("waypoints") == 0);
+    const auto &snapped = result.values.at("snapped").get<util::json::Array>().values;
+    BOOST_REQUIRE_EQUAL(snapped.size(), params.coordinates.size());
+    for (std::size_t index = 0; index < snapped.size(); ++index)
+    {
+        const auto &waypoints = snapped[index].get<util::json::Array>().values;
+        BOOST_REQUIRE_EQUAL(waypoints.size(), 2);
+        BOOST_CHECK_EQUAL(getLocation(waypoints.front()), params.coordinates[index]);
+        BOOST_CHECK_EQUAL(getLocation(waypoints.back()), params.coordinates[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bulk_coordinate_without_segment)
+{
+    const auto facade = std::make_shared<const NearestDataFacade>();
+    const plugins::NearestPlugin plugin(-1, -1);
+
+    api::NearestParameters params;
+    params.coordinates.push_back({util::FloatLongitude{1.}, util::FloatLatitude{2.}});
+    params.coordinates.push_back({util::FloatLongitude{-1.}, util::FloatLatitude{2.}});
+    params.coordinates.push_back({util::FloatLongitude{3.}, util::FloatLatitude{4.}});
+
+    util::json::Object result;
+    BOOST_CHECK(plugin.HandleRequest(facade, params, result) == Status::Ok);
+    const auto &snapped = result.values.at("snapped").get<util::json::Array>().values;
+    BOOST_REQUIRE_EQUAL(snapped.size(), 3);
+    BOOST_CHECK_EQUAL(snapped[0].get<util::json::Array>().values.size(), 1);
+    BOOST_CHECK(snapped[1].get<util::json::Array>().values.empty());
+    BOOST_CHECK_EQUAL(getLocation(snapped[2].get<util::json::Array>().values.front()),
+                      params.coordinates[2]);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_limits_locations)
+{
+    const auto facade = std::make_shared<const NearestDataFacade>();
+    const plugins::NearestPlugin plugin(-1, 2);
+
+    api::NearestParameters params;
+    params.coordinates.resize(3, {util::FloatLongitude{1.}, util::FloatLatitude{2.}});
+
+    util::json::Object result;
+    BOOST_CHECK(plugin.HandleRequest(facade, params, result) == Status::Error);
+    BOOST_CHECK_EQUAL(result.values.at("code").get<util::json::String>().value, "TooBig");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,222 @@
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/one_to_all.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
+
+#include "mocks/mock_graph_datafacade.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(one_to_all)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+const constexpr NodeID NUMBER_OF_NODES = 7;
+
+// A tree contracted from the leaves, so the hierarchy needs no shortcuts:
+//
+// 0 - 1 - 2 - 3 - 4
+//         |
+//         5 - 6
+//
+// Node 2 is the highest, 0, 4 and 6 the lowest. Every edge is stored at its lower node and
+// has different weights upwards and downwards.
+const std::vector<std::tuple<NodeID, NodeID, EdgeWeight, EdgeWeight>> TREE_EDGES = {
+    std::make_tuple(0, 1, 3, 4),
+    std::make_tuple(1, 2, 5, 2),
+    std::make_tuple(3, 2, 1, 6),
+    std::make_tuple(4, 3, 2, 2),
+    std::make_tuple(5, 2, 4, 3),
+    std::make_tuple(6, 5, 7, 1)};
+
+std::shared_ptr<MockGraphDataFacade> makeFacade()
+{
+    std::vector<MockGraphDataFacade::InputEdge> edges;
+    for (const auto &edge : TREE_EDGES)
+    {
+        const auto lower = std::get<0>(edge);
+        const auto higher = std::get<1>(edge);
+        edges.push_back(makeQueryEdge(lower, higher, std::get<2>(edge), 0, true, false));
+        edges.push_back(makeQueryEdge(lower, higher, std::get<3>(edge), 0, false, true));
+    }
+    return std::make_shared<MockGraphDataFacade>(NUMBER_OF_NODES, std::move(edges));
+}
+
+// A phantom node at the start of every node, so the table holds the weights between the nodes
+std::vector<PhantomNode> makePhantomNodes()
+{
+    std::vector<PhantomNode> phantom_nodes(NUMBER_OF_NODES);
+    for (const auto node : util::irange<NodeID>(0, NUMBER_OF_NODES))
+    {
+        phantom_nodes[node].forward_segment_id = {node, true};
+        phantom_nodes[node].forward_weight = 0;
+        phantom_nodes[node].forward_duration = 0;
+    }
+    return phantom_nodes;
+}
+
+// All pairs of shortest paths of the original graph
+std::vector<EdgeWeight> getAllPairsWeights()
+{
+    std::vector<EdgeWeight> weights(NUMBER_OF_NODES * NUMBER_OF_NODES, INVALID_EDGE_WEIGHT);
+    for (const auto node : util::irange<NodeID>(0, NUMBER_OF_NODES))
+    {
+        weights[node * NUMBER_OF_NODES + node] = 0;
+    }
+    for (const auto &edge : TREE_EDGES)
+    {
+        const auto lower = std::get<0>(edge);
+        const auto higher = std::get<1>(edge);
+        weights[lower * NUMBER_OF_NODES + higher] = std::get<2>(edge);
+        weights[higher * NUMBER_OF_NODES + lower] = std::get<3>(edge);
+    }
+    for (const auto middle : util::irange<NodeID>(0, NUMBER_OF_NODES))
+    {
+        for (const auto from : util::irange<NodeID>(0, NUMBER_OF_NODES))
+        {
+            for (const auto to : util::irange<NodeID>(0, NUMBER_OF_NODES))
+            {
+                const auto first = weights[from * NUMBER_OF_NODES + middle];
+                const auto second = weights[middle * NUMBER_OF_NODES + to];
+                if (first != INVALID_EDGE_WEIGHT && second != INVALID_EDGE_WEIGHT)
+                {
+                    auto &weight = weights[from * NUMBER_OF_NODES + to];
+                    weight = std::min(weight, first + second);
+                }
+            }
+        }
+    }
+    return weights;
+}
+}
+
+BOOST_AUTO_TEST_CASE(needs_level_order)
+{
+    const auto facade = makeFacade();
+    BOOST_CHECK(!routing_algorithms::OneToAllRouting::IsAvailable(*facade));
+
+    facade->SetLevelOrder({2, 1, 3, 5, 0, 4, 6});
+    BOOST_CHECK(routing_algorithms::OneToAllRouting::IsAvailable(*facade));
+}
+
+BOOST_AUTO_TEST_CASE(matches_many_to_many)
+{
+    const auto facade = makeFacade();
+    facade->SetLevelOrder({2, 1, 3, 5, 0, 4, 6});
+    const auto phantom_nodes = makePhantomNodes();
+
+    SearchEngineData heaps;
+    const routing_algorithms::OneToAllRouting one_to_all(heaps);
+    const routing_algorithms::ManyToManyRouting many_to_many(heaps);
+
+    const auto expected = getAllPairsWeights();
+    const auto one_to_all_table = one_to_all(facade, phantom_nodes, {}, {});
+    const auto many_to_many_table = many_to_many(facade, phantom_nodes, {}, {});
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        one_to_all_table.begin(), one_to_all_table.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(one_to_all_table.begin(),
+                                  one_to_all_table.end(),
+                                  many_to_many_table.begin(),
+                                  many_to_many_table.end());
+
+    // a subset of sources and targets
+    const std::vector<std::size_t> sources = {6, 0};
+    const std::vector<std::size_t> targets = {4, 5, 6};
+    const auto one_to_all_subset = one_to_all(facade, phantom_nodes, sources, targets);
+    const auto many_to_many_subset = many_to_many(facade, phantom_nodes, sources, targets);
+    BOOST_CHECK_EQUAL_COLLECTIONS(one_to_all_subset.begin(),
+                                  one_to_all_subset.end(),
+                                  many_to_many_subset.begin(),
+                                  many_to_many_subset.end());
+    // the source 0 to the target 5
+    BOOST_CHECK_EQUAL(one_to_all_subset[1 * targets.size() + 1], expected[0 * NUMBER_OF_NODES + 5]);
+}
+
+BOOST_AUTO_TEST_CASE(falls_back_without_level_order)
+{
+    const auto facade = makeFacade();
+    facade->SetLevelOrder({2, 1, 3, 5, 0, 4, 6});
+    const auto phantom_nodes = makePhantomNodes();
+
+    SearchEngineData heaps;
+    const routing_algorithms::OneToAllRouting one_to_all(heaps);
+    const routing_algorithms::ManyToManyRouting many_to_many(heaps);
+    const auto sweep_table = one_to_all(facade, phantom_nodes, {}, {});
+
+    // data without a level order, the table plugin then uses the many-to-many search
+    facade->SetLevelOrder({});
+    BOOST_REQUIRE(!routing_algorithms::OneToAllRouting::IsAvailable(*facade));
+    const auto fallback_table = many_to_many(facade, phantom_nodes, {}, {});
+    BOOST_CHECK_EQUAL_COLLECTIONS(fallback_table.begin(),
+                                  fallback_table.end(),
+                                  sweep_table.begin(),
+                                  sweep_table.end());
+    const auto expected = getAllPairsWeights();
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        fallback_table.begin(), fallback_table.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(labels_all_nodes)
+{
+    const auto facade = makeFacade();
+    facade->SetLevelOrder({2, 1, 3, 5, 0, 4, 6});
+    const auto phantom_nodes = makePhantomNodes();
+
+    SearchEngineData heaps;
+    const routing_algorithms::OneToAllRouting one_to_all(heaps);
+    const auto expected = getAllPairsWeights();
+
+    const auto &labels = one_to_all.Search(facade, phantom_nodes[4]);
+    for (const auto node : util::irange<NodeID>(0, NUMBER_OF_NODES))
+    {
+        BOOST_CHECK_EQUAL(labels.weights[node], expected[4 * NUMBER_OF_NODES + node]);
+        BOOST_CHECK_EQUAL(labels.durations[node], expected[4 * NUMBER_OF_NODES + node]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(collects_reached_nodes)
+{
+    const auto facade = makeFacade();
+    facade->SetLevelOrder({2, 1, 3, 5, 0, 4, 6});
+    const auto phantom_nodes = makePhantomNodes();
+
+    SearchEngineData heaps;
+    const routing_algorithms::OneToAllRouting one_to_all(heaps);
+    const auto expected = getAllPairsWeights();
+
+    // without a bound nothing is collected
+    BOOST_CHECK(one_to_all.Search(facade, phantom_nodes[4]).reached.empty());
+
+    const EdgeWeight max_duration = 5;
+    const auto &labels = one_to_all.Search(facade, phantom_nodes[4], max_duration);
+    std::vector<NodeID> reached_nodes;
+    for (const auto &reached : labels.reached)
+    {
+        reached_nodes.push_back(reached.first);
+    }
+    std::sort(reached_nodes.begin(), reached_nodes.end());
+    reached_nodes.erase(std::unique(reached_nodes.begin(), reached_nodes.end()),
+                        reached_nodes.end());
+
+    std::vector<NodeID> expected_nodes;
+    for (const auto node : util::irange<NodeID>(0, NUMBER_OF_NODES))
+    {
+        if (expected[4 * NUMBER_OF_NODES + node] <= max_duration)
+            expected_nodes.push_back(node);
+    }
+    // up to 1 on one branch, but not 5 on the other
+    BOOST_CHECK(expected_nodes == std::vector<NodeID>({1, 2, 3, 4}));
+    BOOST_CHECK(reached_nodes == expected_nodes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
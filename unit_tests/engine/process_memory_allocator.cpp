@@ -0,0 +1,37 @@
+#include "engine/datafacade/process_memory_allocator.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+BOOST_AUTO_TEST_SUITE(process_memory_allocator)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(memory_is_usable_with_and_without_huge_pages)
+{
+    // more than a huge page, but not a multiple of the page size
+    const std::size_t size = (3 << 20) + 123;
+
+    // without huge pages reserved or transparent huge pages enabled this uses normal pages
+    for (const bool use_huge_pages : {false, true})
+    {
+        auto memory = datafacade::ProcessMemoryAllocator::AllocateMemory(size, use_huge_pages);
+        BOOST_REQUIRE(memory);
+        BOOST_CHECK(std::all_of(memory.get(), memory.get() + size, [](const char value) {
+            return value == 0;
+        }));
+
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            memory.get()[index] = static_cast<char>(index % 127);
+        }
+        BOOST_CHECK_EQUAL(memory.get()[0], 0);
+        BOOST_CHECK_EQUAL(memory.get()[size - 1], static_cast<char>((size - 1) % 127));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+#include "engine/routing_algorithms/routing_base.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include "mocks/mock_graph_datafacade.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(routing_base)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::test;
+
+namespace
+{
+// The edge based nodes 0 -> 1 -> 2 follow the equator, each with a geometry of two segments:
+//
+//  node 0     node 1     node 2
+// 0 - 1 - 2 - 3 - 4 - 5 - 6
+//
+// The edge based node 3 is the reverse of node 1.
+std::shared_ptr<const MockGraphDataFacade> makeFacade()
+{
+    std::vector<util::Coordinate> coordinates;
+    for (int index = 0; index < 7; ++index)
+    {
+        coordinates.push_back({util::FloatLongitude{0.001 * index * (index + 1)},
+                               util::FloatLatitude{0.}});
+    }
+    const auto length = [&](const NodeID from, const NodeID to) {
+        return util::coordinate_calculation::haversineDistance(coordinates[from], coordinates[to]);
+    };
+
+    // every edge carries the length of the edge based node it leaves
+    auto edges = makeUncontractedEdges({std::make_tuple(0, 1, 10, length(0, 2)),
+                                        std::make_tuple(1, 2, 10, length(2, 4))});
+    return std::make_shared<MockGraphDataFacade>(
+        4, std::move(edges), coordinates, std::vector<std::vector<NodeID>>{{0, 1, 2},
+                                                                          {2, 3, 4},
+                                                                          {4, 5, 6},
+                                                                          {2, 3, 4}});
+}
+
+double getLength(const MockGraphDataFacade &facade, const std::vector<NodeID> &geometry)
+{
+    double length = 0;
+    for (std::size_t index = 0; index + 1 < geometry.size(); ++index)
+    {
+        length += util::coordinate_calculation::haversineDistance(
+            facade.GetCoordinateOfNode(geometry[index]),
+            facade.GetCoordinateOfNode(geometry[index + 1]));
+    }
+    return length;
+}
+}
+
+BOOST_AUTO_TEST_CASE(phantom_node_offset)
+{
+    const auto facade = makeFacade();
+    const routing_algorithms::BasicRoutingInterface routing;
+
+    const auto phantom = makePhantomNode(*facade, 1, 3, 1, 0.25);
+    const auto geometry = facade->GetUncompressedForwardGeometry(1);
+    const auto first_segment = util::coordinate_calculation::haversineDistance(
+        facade->GetCoordinateOfNode(geometry[0]), facade->GetCoordinateOfNode(geometry[1]));
+    const auto to_location = util::coordinate_calculation::haversineDistance(
+        facade->GetCoordinateOfNode(geometry[1]), phantom.location);
+    const auto from_location = util::coordinate_calculation::haversineDistance(
+        phantom.location, facade->GetCoordinateOfNode(geometry[2]));
+
+    // the forward offset covers the first segment and the part of the second one up to the
+    // location, the reverse offset the rest of the second segment
+    const auto forward_offset = routing.GetPhantomNodeOffset(facade, phantom, 1);
+    const auto reverse_offset = routing.GetPhantomNodeOffset(facade, phantom, 3);
+    BOOST_CHECK_CLOSE(forward_offset, first_segment + to_location, 1e-6);
+    BOOST_CHECK_CLOSE(reverse_offset, from_location, 1e-6);
+    BOOST_CHECK_CLOSE(forward_offset + reverse_offset, getLength(*facade, geometry), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(path_distance)
+{
+    const auto facade = makeFacade();
+    const routing_algorithms::BasicRoutingInterface routing;
+    const auto location = [](const double longitude) {
+        return util::Coordinate{util::FloatLongitude{longitude}, util::FloatLatitude{0.}};
+    };
+
+    // halfway between the coordinates 1 and 2 at 0.002 and 0.006, and three quarters of the way
+    // between the coordinates 5 and 6 at 0.03 and 0.042. The path follows the equator between them.
+    const auto source = makePhantomNode(*facade, 0, SPECIAL_NODEID, 1, 0.5);
+    const auto target = makePhantomNode(*facade, 2, SPECIAL_NODEID, 1, 0.75);
+    BOOST_CHECK_CLOSE(routing.GetPathDistance(facade, {0, 1, 2}, source, target),
+                      util::coordinate_calculation::haversineDistance(location(0.004),
+                                                                      location(0.039)),
+                      1e-3);
+
+    // both phantom nodes on the same node, the target at 0.005
+    const auto same_node_target = makePhantomNode(*facade, 0, SPECIAL_NODEID, 1, 0.75);
+    BOOST_CHECK_CLOSE(routing.GetPathDistance(facade, {0}, source, same_node_target),
+                      util::coordinate_calculation::haversineDistance(location(0.004),
+                                                                      location(0.005)),
+                      1e-3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
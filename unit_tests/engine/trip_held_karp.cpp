@@ -0,0 +1,115 @@
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_held_karp)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// lexicographically smallest of all optimal roundtrips
+std::vector<NodeID> getOptimalTrip(const util::DistTableWrapper<EdgeWeight> &table)
+{
+    std::vector<NodeID> route(table.GetNumberOfNodes());
+    std::iota(route.begin(), route.end(), 0);
+    auto best_route = route;
+    auto best_weight = trip::GetTripWeight(table, route);
+    while (std::next_permutation(route.begin(), route.end()))
+    {
+        const auto weight = trip::GetTripWeight(table, route);
+        if (weight < best_weight)
+        {
+            best_route = route;
+            best_weight = weight;
+        }
+    }
+    return best_route;
+}
+
+util::DistTableWrapper<EdgeWeight> makeRandomTable(const std::size_t number_of_locations,
+                                                   std::mt19937 &generator)
+{
+    // few distinct weights, so there are many optimal roundtrips
+    std::uniform_int_distribution<EdgeWeight> distribution(1, 5);
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            table[from * number_of_locations + to] = from == to ? 0 : distribution(generator);
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+}
+
+BOOST_AUTO_TEST_CASE(matches_permutations)
+{
+    std::mt19937 generator(42);
+    for (std::size_t number_of_locations = 1; number_of_locations < 9; ++number_of_locations)
+    {
+        for (int iteration = 0; iteration < 10; ++iteration)
+        {
+            const auto table = makeRandomTable(number_of_locations, generator);
+            const auto route = trip::HeldKarpTrip(number_of_locations, table);
+            const auto expected = getOptimalTrip(table);
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                route.begin(), route.end(), expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(avoids_invalid_weights)
+{
+    // table of a trip that has to start at 0 and end at 3, as set up by the trip plugin
+    const std::size_t number_of_locations = 4;
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations, 1);
+    for (std::size_t location = 0; location < number_of_locations; ++location)
+    {
+        table[location * number_of_locations + location] = 0;
+        table[location * number_of_locations + 0] = INVALID_EDGE_WEIGHT;
+        table[3 * number_of_locations + location] = INVALID_EDGE_WEIGHT;
+    }
+    table[3 * number_of_locations + 0] = 0;
+    table[0 * number_of_locations + 3] = INVALID_EDGE_WEIGHT;
+    const util::DistTableWrapper<EdgeWeight> dist_table(std::move(table), number_of_locations);
+
+    const auto route = trip::HeldKarpTrip(number_of_locations, dist_table);
+    const std::vector<NodeID> expected = {0, 1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(solves_sixteen_locations)
+{
+    // only the roundtrip 0, 2, 4, ..., 14, 1, 3, ..., 15 uses cheap edges
+    const std::size_t number_of_locations = 16;
+    std::vector<NodeID> expected;
+    for (NodeID location = 0; location < number_of_locations; location += 2)
+        expected.push_back(location);
+    for (NodeID location = 1; location < number_of_locations; location += 2)
+        expected.push_back(location);
+
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations, 10);
+    for (std::size_t index = 0; index < number_of_locations; ++index)
+    {
+        const auto from = expected[index];
+        const auto to = expected[(index + 1) % number_of_locations];
+        table[from * number_of_locations + from] = 0;
+        table[from * number_of_locations + to] = 1;
+    }
+    const util::DistTableWrapper<EdgeWeight> dist_table(std::move(table), number_of_locations);
+
+    const auto route = trip::HeldKarpTrip(number_of_locations, dist_table);
+    BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
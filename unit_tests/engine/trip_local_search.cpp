@@ -0,0 +1,103 @@
+#include "engine/trip/trip_local_search.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_local_search)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// locations on a circle, the shortest roundtrip visits them in order
+util::DistTableWrapper<EdgeWeight> makeCircleTable(const std::size_t number_of_locations)
+{
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            const auto from_angle = 2 * M_PI * from / number_of_locations;
+            const auto to_angle = 2 * M_PI * to / number_of_locations;
+            table[from * number_of_locations + to] = static_cast<EdgeWeight>(
+                1000 * std::hypot(std::cos(from_angle) - std::cos(to_angle),
+                                  std::sin(from_angle) - std::sin(to_angle)));
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+bool isPermutation(const std::vector<NodeID> &route, const std::size_t number_of_locations)
+{
+    std::vector<NodeID> expected(number_of_locations);
+    std::iota(expected.begin(), expected.end(), 0);
+    return std::is_permutation(route.begin(), route.end(), expected.begin(), expected.end());
+}
+}
+
+BOOST_AUTO_TEST_CASE(two_opt_removes_crossing)
+{
+    const auto table = makeCircleTable(6);
+    std::vector<NodeID> route = {0, 1, 4, 3, 2, 5};
+    const auto weight = trip::GetTripWeight(table, route);
+
+    BOOST_CHECK(trip::TwoOpt(table, route));
+    BOOST_CHECK(isPermutation(route, 6));
+    BOOST_CHECK_LT(trip::GetTripWeight(table, route), weight);
+    BOOST_CHECK(!trip::TwoOpt(table, route));
+}
+
+BOOST_AUTO_TEST_CASE(or_opt_moves_chain)
+{
+    const auto table = makeCircleTable(8);
+    std::vector<NodeID> route = {0, 5, 1, 2, 3, 4, 6, 7};
+    const auto weight = trip::GetTripWeight(table, route);
+
+    BOOST_CHECK(trip::OrOpt(table, route));
+    BOOST_CHECK(isPermutation(route, 8));
+    BOOST_CHECK_LT(trip::GetTripWeight(table, route), weight);
+}
+
+BOOST_AUTO_TEST_CASE(two_opt_respects_direction)
+{
+    // going around the circle in one direction is cheap, reversing the route is not
+    const std::size_t number_of_locations = 6;
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations, 100);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        table[from * number_of_locations + from] = 0;
+        table[from * number_of_locations + (from + 1) % number_of_locations] = 1;
+    }
+    const util::DistTableWrapper<EdgeWeight> dist_table(std::move(table), number_of_locations);
+
+    std::vector<NodeID> route = {0, 1, 2, 3, 4, 5};
+    BOOST_CHECK(!trip::TwoOpt(dist_table, route));
+    BOOST_CHECK_EQUAL(trip::GetTripWeight(dist_table, route), 6);
+}
+
+BOOST_AUTO_TEST_CASE(finds_circle)
+{
+    const std::size_t number_of_locations = 50;
+    const auto table = makeCircleTable(number_of_locations);
+
+    std::vector<NodeID> circle(number_of_locations);
+    std::iota(circle.begin(), circle.end(), 0);
+    const auto optimal_weight = trip::GetTripWeight(table, circle);
+
+    for (const auto search_time : {0, 50})
+    {
+        const auto route = trip::LocalSearchTrip(
+            number_of_locations, table, std::chrono::milliseconds(search_time));
+        BOOST_CHECK(isPermutation(route, number_of_locations));
+        BOOST_CHECK_EQUAL(trip::GetTripWeight(table, route), optimal_weight);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,64 @@
+#include "engine/unpacking_cache.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+BOOST_AUTO_TEST_SUITE(unpacking_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+UnpackingCache::UnpackedEdgesPtr makeUnpackedEdges(const std::size_t size, const NodeID first)
+{
+    auto edges = std::make_shared<UnpackingCache::UnpackedEdges>();
+    for (NodeID node = first; node < first + size; ++node)
+    {
+        edges->push_back({node, node + 1, node});
+    }
+    return edges;
+}
+}
+
+BOOST_AUTO_TEST_CASE(find_inserted)
+{
+    UnpackingCache cache(1024);
+    BOOST_CHECK(!cache.Find(1, false));
+
+    cache.Insert(1, false, makeUnpackedEdges(3, 10));
+    const auto edges = cache.Find(1, false);
+    BOOST_REQUIRE(edges);
+    BOOST_REQUIRE_EQUAL(edges->size(), 3);
+    BOOST_CHECK_EQUAL(edges->front().from, 10);
+    BOOST_CHECK_EQUAL(edges->back().to, 13);
+
+    // both directions of a shortcut unpack differently
+    BOOST_CHECK(!cache.Find(1, true));
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+    // all keys below map to the same shard, which holds capacity / 16 edges
+    UnpackingCache cache(16 * 4);
+    cache.Insert(0, false, makeUnpackedEdges(2, 0));
+    cache.Insert(8, false, makeUnpackedEdges(2, 0));
+    // touch the first entry, so the second one is the least recently used
+    BOOST_CHECK(cache.Find(0, false));
+
+    cache.Insert(16, false, makeUnpackedEdges(2, 0));
+    BOOST_CHECK(cache.Find(0, false));
+    BOOST_CHECK(!cache.Find(8, false));
+    BOOST_CHECK(cache.Find(16, false));
+}
+
+BOOST_AUTO_TEST_CASE(skips_oversized_entries)
+{
+    UnpackingCache cache(16 * 4);
+    cache.Insert(0, false, makeUnpackedEdges(5, 0));
+    BOOST_CHECK(!cache.Find(0, false));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
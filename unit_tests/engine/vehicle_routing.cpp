@@ -0,0 +1,158 @@
+#include "engine/vehicle_routing.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(vehicle_routing)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// locations on a line, the duration is the distance between their positions
+util::DistTableWrapper<EdgeWeight> makeLineTable(const std::vector<EdgeWeight> &positions)
+{
+    const auto number_of_locations = positions.size();
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            table[from * number_of_locations + to] = std::abs(positions[from] - positions[to]);
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+void checkServedOnce(const VehicleRoutingProblem &problem, const VehicleRoutingSolution &solution)
+{
+    std::vector<NodeID> served = solution.unassigned;
+    for (const auto &route : solution.routes)
+    {
+        served.insert(served.end(), route.begin(), route.end());
+    }
+    served.push_back(problem.depot);
+    std::sort(served.begin(), served.end());
+    for (NodeID location = 0; location < problem.GetNumberOfLocations(); ++location)
+    {
+        BOOST_CHECK_EQUAL(served[location], location);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(respects_capacities)
+{
+    VehicleRoutingProblem problem(makeLineTable({0, 10, 20, -10, -20}), 0, {2, 2});
+    std::fill(problem.demands.begin() + 1, problem.demands.end(), 1);
+
+    for (const auto search_time : {0, 20})
+    {
+        const auto solution = solveVehicleRouting(problem, std::chrono::milliseconds(search_time));
+        checkServedOnce(problem, solution);
+        BOOST_CHECK(solution.unassigned.empty());
+        BOOST_REQUIRE_EQUAL(solution.routes.size(), 2);
+        BOOST_CHECK_EQUAL(solution.routes[0].size(), 2);
+        BOOST_CHECK_EQUAL(solution.routes[1].size(), 2);
+        // one vehicle per side of the depot
+        BOOST_CHECK_EQUAL(solution.duration, 80);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(respects_time_windows)
+{
+    VehicleRoutingProblem problem(
+        makeLineTable({0, 10, 20}), 0, {std::numeric_limits<unsigned>::max()});
+    // the farther location has to be visited first
+    problem.time_windows[2] = {0, 25};
+    problem.time_windows[1] = {50, 100};
+    problem.service_times[2] = 5;
+
+    const auto solution = solveVehicleRouting(problem, std::chrono::milliseconds(0));
+    BOOST_CHECK(solution.unassigned.empty());
+    BOOST_REQUIRE_EQUAL(solution.routes.size(), 1);
+    const std::vector<NodeID> expected = {2, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        solution.routes[0].begin(), solution.routes[0].end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(solution.arrivals[2], 20);
+    BOOST_CHECK_EQUAL(solution.arrivals[1], 50);
+    BOOST_CHECK_EQUAL(solution.duration, 60);
+}
+
+BOOST_AUTO_TEST_CASE(unassigns_unreachable_locations)
+{
+    VehicleRoutingProblem problem(makeLineTable({0, 10, 20}), 0, {10});
+    problem.durations.SetValue(0, 2, INVALID_EDGE_WEIGHT);
+    problem.durations.SetValue(1, 2, INVALID_EDGE_WEIGHT);
+
+    const auto solution = solveVehicleRouting(problem, std::chrono::milliseconds(20));
+    checkServedOnce(problem, solution);
+    const std::vector<NodeID> expected = {2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        solution.unassigned.begin(), solution.unassigned.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(solution.arrivals[2], INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_CASE(improves_initial_solution)
+{
+    // inserting in this order puts both far locations in the first vehicle
+    VehicleRoutingProblem problem(makeLineTable({0, -100, 100, -101, 101}), 0, {2, 2});
+    std::fill(problem.demands.begin() + 1, problem.demands.end(), 1);
+
+    const auto initial = solveVehicleRouting(problem, std::chrono::milliseconds(0));
+    const auto improved = solveVehicleRouting(problem, std::chrono::milliseconds(50));
+    checkServedOnce(problem, improved);
+    BOOST_CHECK_LE(improved.duration, initial.duration);
+    BOOST_CHECK_EQUAL(improved.duration, 404);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_durations_with_waiting)
+{
+    // many locations whose time windows make the vehicles wait
+    std::vector<EdgeWeight> positions = {0};
+    for (EdgeWeight index = 1; index < 60; ++index)
+    {
+        positions.push_back((index * 37) % 101 - 50);
+    }
+    VehicleRoutingProblem problem(makeLineTable(positions), 0, {20, 20, 20});
+    std::fill(problem.demands.begin() + 1, problem.demands.end(), 1);
+    for (std::size_t location = 1; location < positions.size(); ++location)
+    {
+        const EdgeWeight begin = (location * 53) % 400;
+        problem.time_windows[location] = {begin, begin + 1000};
+        problem.service_times[location] = location % 5;
+    }
+
+    for (const auto search_time : {0, 20})
+    {
+        const auto solution = solveVehicleRouting(problem, std::chrono::milliseconds(search_time));
+        checkServedOnce(problem, solution);
+        BOOST_CHECK(solution.unassigned.empty());
+
+        std::int64_t duration = 0;
+        for (const auto &route : solution.routes)
+        {
+            NodeID current = problem.depot;
+            std::int64_t time = 0;
+            for (const auto stop : route)
+            {
+                BOOST_CHECK_GE(solution.arrivals[stop], problem.time_windows[stop].begin);
+                BOOST_CHECK_LE(solution.arrivals[stop], problem.time_windows[stop].end);
+                BOOST_CHECK_GE(solution.arrivals[stop], time + problem.durations(current, stop));
+                time = solution.arrivals[stop] + problem.service_times[stop];
+                current = stop;
+            }
+            duration += time + problem.durations(current, problem.depot);
+        }
+        BOOST_CHECK_EQUAL(solution.duration, duration);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -73,10 +73,19 @@ BOOST_AUTO_TEST_CASE(test_nearest_response_multiple_coordinates)
 
     json::Object result;
     const auto rc = osrm.Nearest(params, result);
-    BOOST_REQUIRE(rc == Status::Error);
+    BOOST_REQUIRE(rc == Status::Ok);
 
     const auto code = result.values.at("code").get<json::String>().value;
-    BOOST_CHECK_EQUAL(code, "InvalidOptions");
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // the waypoints of each coordinate are listed separately
+    BOOST_CHECK(result.values.count("waypoints") == 0);
+    const auto &snapped = result.values.at("snapped").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(snapped.size(), 2);
+    for (const auto &waypoints : snapped)
+    {
+        BOOST_CHECK(!waypoints.get<json::Array>().values.empty());
+    }
 }
 
 BOOST_AUTO_TEST_CASE(test_nearest_response_for_location_in_small_component)
@@ -17,7 +17,7 @@ namespace osrm
 namespace test
 {
 
-class MockDataFacade final : public engine::datafacade::BaseDataFacade
+class MockDataFacade : public engine::datafacade::BaseDataFacade
 {
     using StringView = util::StringView;
 
@@ -221,6 +221,13 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
     StringView GetDestinationsForID(const NameID) const override final { return {}; }
 
     std::size_t GetCoreSize() const override { return 0; }
+    util::ShM<NodeID, true>::vector GetLevelOrder() const override { return {}; }
+    engine::UnpackingCache *GetUnpackingCache() const override { return nullptr; }
+    bool HasShortcutChildren() const override { return false; }
+    contractor::ShortcutChildren GetShortcutChildren(const EdgeID, const bool) const override
+    {
+        return {};
+    }
     std::string GetTimestamp() const override { return ""; }
     bool GetContinueStraightDefault() const override { return true; }
     double GetMapMatchingMaxSpeed() const override { return 180 / 3.6; }
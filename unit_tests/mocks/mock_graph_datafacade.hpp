@@ -0,0 +1,187 @@
+#ifndef MOCK_GRAPH_DATAFACADE_HPP
+#define MOCK_GRAPH_DATAFACADE_HPP
+
+// a data facade with a query graph and geometries, for testing the routing algorithms
+
+#include "mocks/mock_datafacade.hpp"
+
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/shared_memory_vector_wrapper.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace test
+{
+
+class MockGraphDataFacade : public MockDataFacade
+{
+  public:
+    using QueryGraph = util::StaticGraph<EdgeData>;
+    using InputEdge = QueryGraph::InputEdge;
+
+    // The geometry of the edge based node n is geometries[n], the nodes of the geometries index
+    // the coordinates.
+    MockGraphDataFacade(const NodeID number_of_nodes,
+                        std::vector<InputEdge> edges,
+                        std::vector<util::Coordinate> coordinates_ = {},
+                        std::vector<std::vector<NodeID>> geometries_ = {})
+        : coordinates(std::move(coordinates_)), geometries(std::move(geometries_))
+    {
+        std::stable_sort(edges.begin(), edges.end());
+        graph = std::make_unique<QueryGraph>(number_of_nodes, edges);
+    }
+
+    unsigned GetNumberOfNodes() const override { return graph->GetNumberOfNodes(); }
+    unsigned GetNumberOfEdges() const override { return graph->GetNumberOfEdges(); }
+    unsigned GetOutDegree(const NodeID n) const override { return graph->GetOutDegree(n); }
+    NodeID GetTarget(const EdgeID e) const override { return graph->GetTarget(e); }
+    const EdgeData &GetEdgeData(const EdgeID e) const override { return graph->GetEdgeData(e); }
+    EdgeID BeginEdges(const NodeID n) const override { return graph->BeginEdges(n); }
+    EdgeID EndEdges(const NodeID n) const override { return graph->EndEdges(n); }
+    engine::datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
+    {
+        return graph->GetAdjacentEdgeRange(node);
+    }
+    EdgeID FindEdge(const NodeID from, const NodeID to) const override
+    {
+        return graph->FindEdge(from, to);
+    }
+    EdgeID FindEdgeInEitherDirection(const NodeID from, const NodeID to) const override
+    {
+        return graph->FindEdgeInEitherDirection(from, to);
+    }
+    EdgeID FindSmallestEdge(const NodeID from,
+                            const NodeID to,
+                            std::function<bool(EdgeData)> filter) const override
+    {
+        return graph->FindSmallestEdge(from, to, filter);
+    }
+    EdgeID
+    FindEdgeIndicateIfReverse(const NodeID from, const NodeID to, bool &result) const override
+    {
+        return graph->FindEdgeIndicateIfReverse(from, to, result);
+    }
+
+    util::Coordinate GetCoordinateOfNode(const NodeID id) const override
+    {
+        return coordinates.at(id);
+    }
+    std::vector<NodeID> GetUncompressedForwardGeometry(const EdgeID id) const override
+    {
+        return geometries.at(id);
+    }
+    std::vector<NodeID> GetUncompressedReverseGeometry(const EdgeID id) const override
+    {
+        return {geometries.at(id).rbegin(), geometries.at(id).rend()};
+    }
+
+    // The nodes in descending level of the hierarchy, empty if unknown
+    void SetLevelOrder(std::vector<NodeID> level_order_) { level_order = std::move(level_order_); }
+    util::ShM<NodeID, true>::vector GetLevelOrder() const override
+    {
+        return {const_cast<NodeID *>(level_order.data()), level_order.size()};
+    }
+
+  private:
+    std::unique_ptr<QueryGraph> graph;
+    std::vector<util::Coordinate> coordinates;
+    std::vector<std::vector<NodeID>> geometries;
+    std::vector<NodeID> level_order;
+};
+
+// An edge of the query graph, the id is the edge based node of the source
+inline MockGraphDataFacade::InputEdge makeQueryEdge(const NodeID source,
+                                                    const NodeID target,
+                                                    const EdgeWeight weight,
+                                                    const EdgeDistance distance,
+                                                    const bool forward,
+                                                    const bool backward)
+{
+    engine::datafacade::BaseDataFacade::EdgeData data;
+    data.id = forward ? source : target;
+    data.shortcut = false;
+    data.weight = weight;
+    data.duration = weight;
+    data.distance = distance;
+    data.forward = forward;
+    data.backward = backward;
+    return {source, target, data};
+}
+
+// Stores every directed edge in both of its nodes, like a hierarchy in which no node was
+// contracted. The forward and the backward search of a query both explore the whole graph.
+inline std::vector<MockGraphDataFacade::InputEdge> makeUncontractedEdges(
+    const std::vector<std::tuple<NodeID, NodeID, EdgeWeight, EdgeDistance>> &directed_edges)
+{
+    std::vector<MockGraphDataFacade::InputEdge> edges;
+    for (const auto &directed_edge : directed_edges)
+    {
+        const auto source = std::get<0>(directed_edge);
+        const auto target = std::get<1>(directed_edge);
+        const auto weight = std::get<2>(directed_edge);
+        const auto distance = std::get<3>(directed_edge);
+        edges.push_back(makeQueryEdge(source, target, weight, distance, true, false));
+        edges.push_back(makeQueryEdge(target, source, weight, distance, false, true));
+    }
+    return edges;
+}
+
+// A phantom node a fraction along the segment at the given position of the geometry of the node.
+// Its weights and durations are the lengths in meters from the start of the node to the location
+// and from the location to its end.
+inline engine::PhantomNode makePhantomNode(const MockGraphDataFacade &facade,
+                                           const NodeID node,
+                                           const NodeID reverse_node,
+                                           const std::size_t position,
+                                           const double fraction)
+{
+    const auto geometry = facade.GetUncompressedForwardGeometry(node);
+    const auto from = facade.GetCoordinateOfNode(geometry[position]);
+    const auto to = facade.GetCoordinateOfNode(geometry[position + 1]);
+    const auto interpolate = [fraction](const double from_value, const double to_value) {
+        return from_value + fraction * (to_value - from_value);
+    };
+    const util::Coordinate location{
+        util::FloatLongitude{interpolate(static_cast<double>(util::toFloating(from.lon)),
+                                         static_cast<double>(util::toFloating(to.lon)))},
+        util::FloatLatitude{interpolate(static_cast<double>(util::toFloating(from.lat)),
+                                        static_cast<double>(util::toFloating(to.lat)))}};
+
+    double before = util::coordinate_calculation::haversineDistance(from, location);
+    double after = util::coordinate_calculation::haversineDistance(location, to);
+    for (std::size_t index = 0; index + 1 < geometry.size(); ++index)
+    {
+        if (index == position)
+            continue;
+        (index < position ? before : after) += util::coordinate_calculation::haversineDistance(
+            facade.GetCoordinateOfNode(geometry[index]),
+            facade.GetCoordinateOfNode(geometry[index + 1]));
+    }
+
+    engine::PhantomNode phantom;
+    phantom.forward_segment_id = {node, true};
+    phantom.reverse_segment_id = {reverse_node, reverse_node != SPECIAL_NODEID};
+    phantom.forward_weight = phantom.forward_duration = std::lround(before);
+    phantom.reverse_weight = phantom.reverse_duration = std::lround(after);
+    phantom.packed_geometry_id = node;
+    phantom.fwd_segment_position = position;
+    phantom.location = location;
+    phantom.input_location = location;
+    return phantom;
+}
+} // ns test
+} // ns osrm
+
+#endif // MOCK_GRAPH_DATAFACADE_HPP
@@ -3,8 +3,10 @@
 #include "parameters_io.hpp"
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/optimize_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
@@ -394,6 +396,21 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     BOOST_CHECK_EQUAL(reference_17.geometries, result_17->geometries);
     BOOST_CHECK_EQUAL(result_2->annotations_type == RouteParameters::AnnotationsType::All, true);
     BOOST_CHECK_EQUAL(result_17->annotations, true);
+
+    // alternatives=true is a single alternative
+    BOOST_CHECK_EQUAL(result_2->number_of_alternatives, 1);
+    BOOST_CHECK_EQUAL(result_1->number_of_alternatives, 0);
+
+    // parse the number of alternatives
+    auto result_18 = parseParameters<RouteParameters>("1,2;3,4?alternatives=3");
+    BOOST_CHECK(result_18);
+    BOOST_CHECK_EQUAL(result_18->alternatives, true);
+    BOOST_CHECK_EQUAL(result_18->number_of_alternatives, 3);
+
+    auto result_19 = parseParameters<RouteParameters>("1,2;3,4?alternatives=0");
+    BOOST_CHECK(result_19);
+    BOOST_CHECK_EQUAL(result_19->alternatives, false);
+    BOOST_CHECK_EQUAL(result_19->number_of_alternatives, 0);
 }
 
 BOOST_AUTO_TEST_CASE(valid_table_urls)
@@ -455,6 +472,25 @@ BOOST_AUTO_TEST_CASE(valid_match_urls)
     CHECK_EQUAL_RANGE(reference_2.bearings, result_2->bearings);
     CHECK_EQUAL_RANGE(reference_2.radiuses, result_2->radiuses);
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
+
+    std::vector<util::Coordinate> coords_3 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+    auto result_3 = parseParameters<MatchParameters>("1,2?session=vehicle_42&timestamps=5");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK_EQUAL(result_3->session, "vehicle_42");
+    BOOST_CHECK_EQUAL(result_3->finish, false);
+    BOOST_CHECK(result_3->IsValid());
+    CHECK_EQUAL_RANGE(coords_3, result_3->coordinates);
+
+    auto result_4 = parseParameters<MatchParameters>("1,2?session=vehicle_42&finish=true");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK_EQUAL(result_4->session, "vehicle_42");
+    BOOST_CHECK_EQUAL(result_4->finish, true);
+    BOOST_CHECK(result_4->IsValid());
+
+    // a single trace point can only be matched in a session
+    auto result_5 = parseParameters<MatchParameters>("1,2?finish=true");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(!result_5->IsValid());
 }
 
 BOOST_AUTO_TEST_CASE(valid_nearest_urls)
@@ -481,6 +517,38 @@ BOOST_AUTO_TEST_CASE(valid_nearest_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(valid_isochrone_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    IsochroneParameters reference_1{};
+    reference_1.coordinates = coords_1;
+    reference_1.contours = {300, 600};
+    auto result_1 = parseParameters<IsochroneParameters>("1,2?contours=300;600");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    CHECK_EQUAL_RANGE(reference_1.contours, result_1->contours);
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_1->coordinates);
+
+    auto result_2 = parseParameters<IsochroneParameters>("1,2");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(!result_2->IsValid());
+
+    auto result_3 = parseParameters<IsochroneParameters>("1,2;3,4?contours=300");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+
+    auto result_4 = parseParameters<IsochroneParameters>("1,2?contours=0");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(!result_4->IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_isochrone_urls)
+{
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?contours=foo"), 13UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?contours=300&bla=foo"), 16UL);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_tile_urls)
 {
     TileParameters reference_1{1, 2, 3};
@@ -551,4 +619,56 @@ BOOST_AUTO_TEST_CASE(valid_trip_urls)
     BOOST_CHECK_EQUAL(param_fail_2, 33UL);
 }
 
+BOOST_AUTO_TEST_CASE(valid_optimize_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{3}, util::FloatLatitude{4}},
+                                              {util::FloatLongitude{5}, util::FloatLatitude{6}}};
+
+    auto result_1 = parseParameters<OptimizeParameters>("1,2;3,4;5,6");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+    BOOST_CHECK_EQUAL(result_1->depot, 0);
+    BOOST_CHECK_EQUAL(result_1->vehicles, 1);
+
+    auto result_2 = parseParameters<OptimizeParameters>(
+        "1,2;3,4;5,6?depot=1&vehicles=2&capacities=5;10&demands=0;2;3&time_windows=;0,600;300,"
+        "900&service_times=0;60;60&steps=true");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK_EQUAL(result_2->depot, 1);
+    BOOST_CHECK_EQUAL(result_2->vehicles, 2);
+    std::vector<unsigned> capacities = {5, 10};
+    CHECK_EQUAL_RANGE(capacities, result_2->capacities);
+    std::vector<unsigned> demands = {0, 2, 3};
+    CHECK_EQUAL_RANGE(demands, result_2->demands);
+    std::vector<unsigned> service_times = {0, 60, 60};
+    CHECK_EQUAL_RANGE(service_times, result_2->service_times);
+    BOOST_REQUIRE_EQUAL(result_2->time_windows.size(), 3);
+    BOOST_CHECK(!result_2->time_windows[0]);
+    BOOST_CHECK_EQUAL(result_2->time_windows[2]->begin, 300);
+    BOOST_CHECK_EQUAL(result_2->time_windows[2]->end, 900);
+    BOOST_CHECK(result_2->steps);
+
+    auto result_3 = parseParameters<OptimizeParameters>("1,2;3,4;5,6?vehicles=2&capacities=5");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+
+    auto result_4 = parseParameters<OptimizeParameters>("1,2;3,4;5,6?time_windows=;600,0;");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(!result_4->IsValid());
+
+    auto result_5 = parseParameters<OptimizeParameters>("1,2;3,4;5,6?depot=3");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(!result_5->IsValid());
+
+    // at most one vehicle per stop
+    auto result_6 = parseParameters<OptimizeParameters>("1,2;3,4;5,6?vehicles=3");
+    BOOST_CHECK(result_6);
+    BOOST_CHECK(!result_6->IsValid());
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<OptimizeParameters>("1,2;3,4?time_windows=1;2"), 22UL);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
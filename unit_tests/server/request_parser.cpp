@@ -0,0 +1,86 @@
+#include "server/request_parser.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+RequestParser::RequestStatus parseRequest(std::string input, http::request &request)
+{
+    RequestParser parser;
+    RequestParser::RequestStatus status;
+    std::tie(status, std::ignore) = parser.parse(request, &input[0], &input[0] + input.size());
+    return status;
+}
+
+BOOST_AUTO_TEST_CASE(valid_get_request)
+{
+    http::request request;
+    BOOST_CHECK(parseRequest("GET /nearest/v1/car/1,2 HTTP/1.1\r\n"
+                             "User-Agent: test\r\n\r\n",
+                             request) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/nearest/v1/car/1,2");
+    BOOST_CHECK_EQUAL(request.agent, "test");
+    BOOST_CHECK(request.body.empty());
+}
+
+BOOST_AUTO_TEST_CASE(valid_post_request)
+{
+    http::request request;
+    BOOST_CHECK(parseRequest("POST /nearest/v1/car HTTP/1.1\r\n"
+                             "Content-Length: 16\r\n\r\n"
+                             "1,2;3,4?number=2",
+                             request) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/nearest/v1/car");
+    BOOST_CHECK_EQUAL(request.body, "1,2;3,4?number=2");
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_post_request)
+{
+    RequestParser parser;
+    http::request request;
+    std::string head = "POST /nearest/v1/car HTTP/1.1\r\nContent-Length: 7\r\n\r\n1,2";
+    std::string tail = ";3,4";
+
+    RequestParser::RequestStatus status;
+    std::tie(status, std::ignore) = parser.parse(request, &head[0], &head[0] + head.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    std::tie(status, std::ignore) = parser.parse(request, &tail[0], &tail[0] + tail.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.body, "1,2;3,4");
+}
+
+BOOST_AUTO_TEST_CASE(body_only_for_post_requests)
+{
+    http::request request;
+    BOOST_CHECK(parseRequest("GET /nearest/v1/car/1,2 HTTP/1.1\r\n"
+                             "Content-Length: 4\r\n\r\n"
+                             ";3,4",
+                             request) == RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(request.body.empty());
+
+    http::request empty_request;
+    BOOST_CHECK(parseRequest("GET /nearest/v1/car/1,2 HTTP/1.1\r\n"
+                             "Content-Length: 0\r\n\r\n",
+                             empty_request) == RequestParser::RequestStatus::valid);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_content_length)
+{
+    http::request request;
+    BOOST_CHECK(parseRequest("POST /nearest/v1/car HTTP/1.1\r\n"
+                             "Content-Length: 1a\r\n\r\n",
+                             request) == RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(parseRequest("POST /nearest/v1/car HTTP/1.1\r\n"
+                             "Content-Length: 9999999999\r\n\r\n",
+                             request) == RequestParser::RequestStatus::invalid);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
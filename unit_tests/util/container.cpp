@@ -0,0 +1,113 @@
+#include "storage/container.hpp"
+#include "storage/io.hpp"
+#include "storage/shared_datatype.hpp"
+#include "util/exception.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(container)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+const std::string CONTAINER_TMP_FILE = "test_container.tmp";
+
+DataLayout makeLayout()
+{
+    DataLayout layout;
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(block);
+        layout.SetBlockSize<std::uint32_t>(bid, block * 100);
+        layout.entry_align[bid] = CONTAINER_ALIGNMENT;
+    }
+    return layout;
+}
+
+ContainerTOC makeTOC(const DataLayout &layout)
+{
+    ContainerTOC toc;
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(block);
+        toc[block] = {getContainerBlockOffset(layout, bid), layout.GetBlockSize(bid), 0, 0};
+    }
+    return toc;
+}
+
+void writeContainer(const DataLayout &layout, const ContainerTOC &toc)
+{
+    io::FileWriter container_file(CONTAINER_TMP_FILE, io::FileWriter::GenerateFingerprint);
+    writeContainerHeader(container_file, layout, toc);
+}
+
+void readContainer(DataLayout &layout, ContainerTOC &toc)
+{
+    io::FileReader container_file(CONTAINER_TMP_FILE, io::FileReader::VerifyFingerprint);
+    readContainerHeader(container_file, layout, toc);
+}
+}
+
+BOOST_AUTO_TEST_CASE(header_round_trip)
+{
+    const auto layout = makeLayout();
+    const auto toc = makeTOC(layout);
+    writeContainer(layout, toc);
+
+    DataLayout read_layout;
+    ContainerTOC read_toc;
+    readContainer(read_layout, read_toc);
+    BOOST_CHECK_EQUAL(read_layout.GetSizeOfLayout(), layout.GetSizeOfLayout());
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        BOOST_CHECK_EQUAL(read_toc[block].offset, toc[block].offset);
+        BOOST_CHECK_EQUAL(read_toc[block].size, toc[block].size);
+    }
+
+    // the blocks are page aligned and start after the header
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        BOOST_CHECK_EQUAL(toc[block].offset % CONTAINER_ALIGNMENT, 0);
+        BOOST_CHECK_GE(toc[block].offset, CONTAINER_DATA_OFFSET);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reject_toc_not_matching_layout)
+{
+    const auto layout = makeLayout();
+    auto toc = makeTOC(layout);
+    toc[DataLayout::GRAPH_NODE_LIST].offset += CONTAINER_ALIGNMENT;
+    writeContainer(layout, toc);
+
+    DataLayout read_layout;
+    ContainerTOC read_toc;
+    BOOST_CHECK_THROW(readContainer(read_layout, read_toc), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(reject_corrupted_header)
+{
+    const auto layout = makeLayout();
+    const auto toc = makeTOC(layout);
+    writeContainer(layout, toc);
+
+    // flip a byte of the layout
+    {
+        std::fstream container_file(CONTAINER_TMP_FILE,
+                                    std::ios::binary | std::ios::in | std::ios::out);
+        container_file.seekp(sizeof(util::FingerPrint) + sizeof(ContainerHeader) + 1);
+        container_file.put(0x7f);
+    }
+
+    DataLayout read_layout;
+    ContainerTOC read_toc;
+    BOOST_CHECK_THROW(readContainer(read_layout, read_toc), util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
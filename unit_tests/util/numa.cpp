@@ -0,0 +1,60 @@
+#include "util/numa.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(numa)
+
+using namespace osrm;
+using namespace osrm::util::numa;
+
+namespace
+{
+const std::string NUMA_TMP_DIR = "test_numa_nodes.tmp";
+
+void writeList(const boost::filesystem::path &path, const std::string &list)
+{
+    boost::filesystem::create_directories(path.parent_path());
+    boost::filesystem::ofstream file(path);
+    file << list << "\n";
+}
+}
+
+BOOST_AUTO_TEST_CASE(parse_list)
+{
+    BOOST_CHECK(ParseList("0") == std::vector<unsigned>({0}));
+    BOOST_CHECK(ParseList("0-3") == std::vector<unsigned>({0, 1, 2, 3}));
+    BOOST_CHECK(ParseList("0-1,4,6-7") == std::vector<unsigned>({0, 1, 4, 6, 7}));
+    BOOST_CHECK(ParseList("").empty());
+    // stops at anything that is not a separator
+    BOOST_CHECK(ParseList("2,5 8") == std::vector<unsigned>({2, 5}));
+    BOOST_CHECK_THROW(ParseList("node0"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(read_topology)
+{
+    const boost::filesystem::path nodes_path(NUMA_TMP_DIR);
+    boost::filesystem::remove_all(nodes_path);
+
+    // node 1 is offline, so the ids have a gap
+    writeList(nodes_path / "online", "0,2");
+    writeList(nodes_path / "node0" / "cpulist", "0-1,4");
+    writeList(nodes_path / "node2" / "cpulist", "2-3");
+    const auto topology = ReadTopology(NUMA_TMP_DIR);
+    BOOST_CHECK(topology.nodes == std::vector<unsigned>({0, 2}));
+    BOOST_CHECK(topology.node_of_cpu == std::vector<unsigned>({0, 0, 2, 2, 0}));
+
+    // without sysfs there is no topology
+    boost::filesystem::remove_all(nodes_path);
+    const auto missing_topology = ReadTopology(NUMA_TMP_DIR);
+    BOOST_CHECK(missing_topology.nodes.empty());
+    BOOST_CHECK(missing_topology.node_of_cpu.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
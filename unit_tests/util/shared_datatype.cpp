@@ -0,0 +1,134 @@
+#include "storage/shared_datatype.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shared_datatype)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+DataLayout makeLayout()
+{
+    DataLayout layout;
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(block);
+        layout.SetBlockSize<std::uint64_t>(bid, block + 1);
+    }
+    return layout;
+}
+
+// Writes the canaries of all blocks of a group and checks that they are within its memory
+void checkGroupBlocks(const DataLayout &layout,
+                      const DataLayout::GroupMemory &memory,
+                      const DataLayout::BlockGroup group)
+{
+    const auto begin = memory[group];
+    const auto end = begin + layout.GetSizeOfLayout(group);
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(block);
+        if (DataLayout::GetBlockGroup(bid) != group)
+            continue;
+
+        const auto ptr = layout.GetBlockPtr<std::uint64_t, true>(memory, bid);
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::uint64_t), 0);
+        BOOST_CHECK(reinterpret_cast<char *>(ptr) - sizeof(CANARY) >= begin);
+        BOOST_CHECK(reinterpret_cast<char *>(ptr) + layout.GetBlockSize(bid) + sizeof(CANARY) <=
+                    end);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(block_groups)
+{
+    BOOST_CHECK_EQUAL(DataLayout::GetBlockGroup(DataLayout::NAME_CHAR_DATA),
+                      DataLayout::STATIC_GROUP);
+    BOOST_CHECK_EQUAL(DataLayout::GetBlockGroup(DataLayout::R_SEARCH_TREE),
+                      DataLayout::STATIC_GROUP);
+    BOOST_CHECK_EQUAL(DataLayout::GetBlockGroup(DataLayout::GRAPH_EDGE_LIST),
+                      DataLayout::METRIC_GROUP);
+    BOOST_CHECK_EQUAL(DataLayout::GetBlockGroup(DataLayout::SHORTCUT_CHILDREN),
+                      DataLayout::METRIC_GROUP);
+
+    const auto layout = makeLayout();
+    BOOST_CHECK_EQUAL(layout.GetSizeOfLayout(),
+                      layout.GetSizeOfLayout(DataLayout::STATIC_GROUP) +
+                          layout.GetSizeOfLayout(DataLayout::METRIC_GROUP));
+}
+
+BOOST_AUTO_TEST_CASE(group_memory_is_contiguous)
+{
+    const auto layout = makeLayout();
+    std::vector<char> memory(layout.GetSizeOfLayout());
+
+    const auto group_memory = layout.GetGroupMemory(memory.data());
+    BOOST_CHECK(group_memory[DataLayout::STATIC_GROUP] == memory.data());
+    BOOST_CHECK(group_memory[DataLayout::METRIC_GROUP] ==
+                memory.data() + layout.GetSizeOfLayout(DataLayout::STATIC_GROUP));
+
+    checkGroupBlocks(layout, group_memory, DataLayout::STATIC_GROUP);
+    checkGroupBlocks(layout, group_memory, DataLayout::METRIC_GROUP);
+    // the canaries of one group do not overwrite those of the other
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        BOOST_CHECK_NO_THROW(layout.GetBlockPtr<std::uint64_t>(
+            memory.data(), static_cast<DataLayout::BlockID>(block)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(block_pointers_are_relative_to_their_group)
+{
+    const auto layout = makeLayout();
+    std::vector<char> static_memory(layout.GetSizeOfLayout(DataLayout::STATIC_GROUP));
+    std::vector<char> metric_memory(layout.GetSizeOfLayout(DataLayout::METRIC_GROUP));
+    DataLayout::GroupMemory group_memory;
+    group_memory[DataLayout::STATIC_GROUP] = static_memory.data();
+    group_memory[DataLayout::METRIC_GROUP] = metric_memory.data();
+
+    checkGroupBlocks(layout, group_memory, DataLayout::STATIC_GROUP);
+    checkGroupBlocks(layout, group_memory, DataLayout::METRIC_GROUP);
+
+    // a second metric memory shares the static blocks of the first one
+    std::vector<char> other_metric_memory(metric_memory.size());
+    auto other_group_memory = group_memory;
+    other_group_memory[DataLayout::METRIC_GROUP] = other_metric_memory.data();
+    checkGroupBlocks(layout, other_group_memory, DataLayout::METRIC_GROUP);
+    BOOST_CHECK_EQUAL(layout.GetAlignedBlockPtr(group_memory, DataLayout::NAME_CHAR_DATA),
+                      layout.GetAlignedBlockPtr(other_group_memory, DataLayout::NAME_CHAR_DATA));
+    BOOST_CHECK_NE(layout.GetAlignedBlockPtr(group_memory, DataLayout::GRAPH_EDGE_LIST),
+                   layout.GetAlignedBlockPtr(other_group_memory, DataLayout::GRAPH_EDGE_LIST));
+    for (const auto block : util::irange<std::size_t>(0, DataLayout::NUM_BLOCKS))
+    {
+        BOOST_CHECK_NO_THROW(layout.GetBlockPtr<std::uint64_t>(
+            other_group_memory, static_cast<DataLayout::BlockID>(block)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(same_blocks_per_group)
+{
+    const auto layout = makeLayout();
+    auto other_layout = makeLayout();
+    BOOST_CHECK(layout.HasSameBlocks(other_layout, DataLayout::STATIC_GROUP));
+    BOOST_CHECK(layout.HasSameBlocks(other_layout, DataLayout::METRIC_GROUP));
+
+    // new weights of the same extract
+    other_layout.SetBlockSize<std::uint64_t>(DataLayout::GRAPH_EDGE_LIST, 1000);
+    BOOST_CHECK(layout.HasSameBlocks(other_layout, DataLayout::STATIC_GROUP));
+    BOOST_CHECK(!layout.HasSameBlocks(other_layout, DataLayout::METRIC_GROUP));
+
+    // so does the size and alignment of the entries
+    other_layout = makeLayout();
+    other_layout.SetBlockSize<std::uint32_t>(DataLayout::NAME_CHAR_DATA, 2);
+    BOOST_CHECK(!layout.HasSameBlocks(other_layout, DataLayout::STATIC_GROUP));
+    BOOST_CHECK(layout.HasSameBlocks(other_layout, DataLayout::METRIC_GROUP));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,56 @@
+#include "storage/storage.hpp"
+#include "storage/storage_config.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(static_checksum)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+const std::string CHECKSUM_TMP_BASE = "test_static_checksum.tmp.osrm";
+
+void writeFile(const boost::filesystem::path &path, const std::string &data)
+{
+    std::ofstream file(path.string(), std::ios::binary | std::ios::trunc);
+    file << data;
+}
+}
+
+BOOST_AUTO_TEST_CASE(changes_with_static_files)
+{
+    const StorageConfig config(CHECKSUM_TMP_BASE);
+    writeFile(config.names_data_path, "names");
+    writeFile(config.hsgr_data_path, "graph");
+
+    const Storage storage(config);
+    const auto checksum = storage.GetStaticChecksum();
+    BOOST_CHECK_EQUAL(storage.GetStaticChecksum(), checksum);
+
+    // the metric files are not part of it
+    writeFile(config.hsgr_data_path, "another graph");
+    BOOST_CHECK_EQUAL(storage.GetStaticChecksum(), checksum);
+
+    // a new extract rewrites the static files
+    writeFile(config.names_data_path, "other names");
+    const auto new_checksum = storage.GetStaticChecksum();
+    BOOST_CHECK_NE(new_checksum, checksum);
+
+    // with the same size, but later
+    writeFile(config.names_data_path, "more names!");
+    boost::filesystem::last_write_time(
+        config.names_data_path, boost::filesystem::last_write_time(config.names_data_path) + 10);
+    BOOST_CHECK_NE(storage.GetStaticChecksum(), new_checksum);
+
+    boost::filesystem::remove(config.names_data_path);
+    boost::filesystem::remove(config.hsgr_data_path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,9 +1,11 @@
 #include "util/static_rtree.hpp"
 #include "extractor/edge_based_node.hpp"
 #include "engine/geospatial_query.hpp"
+#include "storage/io.hpp"
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/exception.hpp"
+#include "util/fingerprint.hpp"
 #include "util/rectangle.hpp"
 #include "util/typedefs.hpp"
 
@@ -18,6 +20,7 @@
 #include <cstdint>
 
 #include <algorithm>
+#include <fstream>
 #include <memory>
 #include <random>
 #include <string>
@@ -37,7 +40,7 @@ using namespace osrm::util;
 using namespace osrm::test;
 
 constexpr uint32_t TEST_BRANCHING_FACTOR = 8;
-constexpr uint32_t TEST_LEAF_NODE_SIZE = 64;
+constexpr uint32_t TEST_LEAF_NODE_SIZE = 128;
 
 using TestData = extractor::EdgeBasedNode;
 using TestStaticRTree = StaticRTree<TestData,
@@ -271,9 +274,49 @@ void construction_test(const std::string &prefix, FixtureT *fixture)
     sampling_verify_rtree(rtree, lsnn, fixture->coords, 100);
 }
 
+BOOST_FIXTURE_TEST_CASE(reject_other_format, TestRandomGraphFixture_10_30)
+{
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_10_30, TestStaticRTree>(
+        "test_format", this, leaves_path, nodes_path);
+    const std::string old_nodes_path = "test_format_old.ramIndex";
+    const std::string old_leaves_path = "test_format_old.fileIndex";
+
+    // trees written without a fingerprint are rejected
+    {
+        storage::io::FileReader nodes_file(nodes_path, storage::io::FileReader::VerifyFingerprint);
+        std::vector<TestStaticRTree::TreeNode> nodes(nodes_file.ReadElementCount64());
+        nodes_file.ReadInto(nodes);
+
+        storage::io::FileWriter old_nodes_file(old_nodes_path,
+                                               storage::io::FileWriter::HasNoFingerprint);
+        old_nodes_file.SerializeVector(nodes);
+    }
+    BOOST_CHECK_THROW(TestStaticRTree(old_nodes_path, leaves_path, coords), util::exception);
+
+    // leaves written without a fingerprint are rejected
+    {
+        std::ifstream leaves_file(leaves_path, std::ios::binary);
+        leaves_file.seekg(TestStaticRTree::LEAF_FILE_HEADER_SIZE);
+        std::ofstream old_leaves_file(old_leaves_path, std::ios::binary);
+        old_leaves_file << leaves_file.rdbuf();
+    }
+    BOOST_CHECK_THROW(TestStaticRTree(nodes_path, old_leaves_path, coords), util::exception);
+
+    // as are truncated ones
+    {
+        std::ofstream truncated_leaves_file(old_leaves_path, std::ios::binary);
+        const auto fingerprint = util::FingerPrint::GetValid();
+        truncated_leaves_file.write(reinterpret_cast<const char *>(&fingerprint),
+                                    sizeof(fingerprint));
+    }
+    BOOST_CHECK_THROW(TestStaticRTree(nodes_path, old_leaves_path, coords), util::exception);
+}
+
 BOOST_FIXTURE_TEST_CASE(construct_tiny, TestRandomGraphFixture_10_30)
 {
-    using TinyTestTree = StaticRTree<TestData, std::vector<Coordinate>, false, 2, 64>;
+    using TinyTestTree = StaticRTree<TestData, std::vector<Coordinate>, false, 2, 128>;
     construction_test<TinyTestTree>("test_tiny", this);
 }
 
@@ -302,6 +345,89 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", this);
 }
 
+BOOST_FIXTURE_TEST_CASE(loaded_leaves_test, TestRandomGraphFixture_MultipleLevels)
+{
+    using LoadedTestStaticRTree = StaticRTree<TestData,
+                                              std::vector<Coordinate>,
+                                              true,
+                                              TEST_BRANCHING_FACTOR,
+                                              TEST_LEAF_NODE_SIZE>;
+    using LeafNode = LoadedTestStaticRTree::LeafNode;
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree("test_loaded", this, leaves_path, nodes_path);
+
+    storage::io::FileReader nodes_file(nodes_path, storage::io::FileReader::VerifyFingerprint);
+    std::vector<LoadedTestStaticRTree::TreeNode> nodes(nodes_file.ReadElementCount64());
+    nodes_file.ReadInto(nodes);
+
+    // copy the leaves to aligned memory like osrm-datastore does
+    std::ifstream leaves_file(leaves_path, std::ios::binary | std::ios::ate);
+    const std::size_t file_size = leaves_file.tellg();
+    const std::size_t leaves_size = file_size - LoadedTestStaticRTree::LEAF_FILE_HEADER_SIZE;
+    std::vector<char> leaves_buffer(leaves_size + alignof(LeafNode));
+    void *leaves_ptr = leaves_buffer.data();
+    std::size_t buffer_size = leaves_buffer.size();
+    BOOST_REQUIRE(std::align(alignof(LeafNode), leaves_size, leaves_ptr, buffer_size));
+    leaves_file.seekg(LoadedTestStaticRTree::LEAF_FILE_HEADER_SIZE);
+    leaves_file.read(static_cast<char *>(leaves_ptr), leaves_size);
+
+    LoadedTestStaticRTree rtree(nodes.data(),
+                                nodes.size(),
+                                static_cast<const LeafNode *>(leaves_ptr),
+                                leaves_size / sizeof(LeafNode),
+                                coords);
+    LinearSearchNN<TestData> lsnn(coords, edges);
+
+    simple_verify_rtree(rtree, coords, edges);
+    sampling_verify_rtree(rtree, lsnn, coords, 100);
+}
+
+BOOST_FIXTURE_TEST_CASE(bounded_nearest_test, TestRandomGraphFixture_MultipleLevels)
+{
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree("test_bounded", this, leaves_path, nodes_path);
+    TestStaticRTree rtree(nodes_path, leaves_path, coords);
+
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+    for (const std::uint64_t max_squared_distance : {0ull, 100000000ull, 10000000000ull})
+    {
+        for (unsigned i = 0; i < 100; i++)
+        {
+            const Coordinate q{FixedLongitude{lon_udist(g)}, FixedLatitude{lat_udist(g)}};
+            const Coordinate fixed_projected_q{web_mercator::fromWGS84(q)};
+            const auto filter = [](const TestStaticRTree::CandidateSegment &) {
+                return std::make_pair(true, true);
+            };
+            const auto terminate = [&](const std::size_t,
+                                       const TestStaticRTree::CandidateSegment &segment) {
+                return coordinate_calculation::squaredEuclideanDistance(
+                           fixed_projected_q, segment.fixed_projected_coordinate) >
+                       max_squared_distance;
+            };
+
+            // segments with the same distance can be returned in a different order
+            const auto get_segments = [](const std::vector<TestData> &results) {
+                std::vector<std::pair<NodeID, NodeID>> segments;
+                for (const auto &result : results)
+                {
+                    segments.emplace_back(result.u, result.v);
+                }
+                std::sort(segments.begin(), segments.end());
+                return segments;
+            };
+            const auto unbounded_segments = get_segments(rtree.Nearest(q, filter, terminate));
+            const auto bounded_segments =
+                get_segments(rtree.Nearest(q, filter, terminate, max_squared_distance));
+            BOOST_CHECK(unbounded_segments == bounded_segments);
+        }
+    }
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)
@@ -370,6 +496,40 @@ BOOST_AUTO_TEST_CASE(radius_regression_test)
     }
 }
 
+// Web mercator stretches distances away from the equator, the radius must still be reached
+BOOST_AUTO_TEST_CASE(radius_latitude_test)
+{
+    using Coord = std::pair<FloatLongitude, FloatLatitude>;
+    using Edge = std::pair<unsigned, unsigned>;
+    GraphFixture fixture(
+        {
+            Coord(FloatLongitude{10.0}, FloatLatitude{60.0}),
+            Coord(FloatLongitude{10.1}, FloatLatitude{60.0}),
+        },
+        {Edge(0, 1), Edge(1, 0)});
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<GraphFixture, MiniStaticRTree>("test_latitude", &fixture, leaves_path, nodes_path);
+    MiniStaticRTree rtree(nodes_path, leaves_path, fixture.coords);
+    MockDataFacade mockfacade;
+    engine::GeospatialQuery<MiniStaticRTree, MockDataFacade> query(
+        rtree, fixture.coords, mockfacade);
+
+    // about 111 meters north of the segment
+    Coordinate input(FloatLongitude{10.05}, FloatLatitude{60.001});
+
+    {
+        auto results = query.NearestPhantomNodesInRange(input, 100);
+        BOOST_CHECK_EQUAL(results.size(), 0);
+    }
+
+    {
+        auto results = query.NearestPhantomNodesInRange(input, 120);
+        BOOST_CHECK_EQUAL(results.size(), 2);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(bearing_tests)
 {
     using Coord = std::pair<FloatLongitude, FloatLatitude>;